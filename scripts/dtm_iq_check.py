@@ -0,0 +1,560 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Check the fixed-point IQ kernels of src/dtm_iq_dsp.c on the host.
+
+The kernels are built with the host C compiler into a shared library and
+fed with synthetic CTE IQ samples of known parameters:
+
+    dtm_iq_check.py cfo
+    dtm_iq_check.py aoa
+    dtm_iq_check.py codec
+
+The angle of arrival estimates are compared with a floating-point reference
+of the same estimator, built into the library, which also times both.
+The packed IQ samples are unpacked and compared with the original ones, the
+packed size is compared with the 8-bit samples of the HCI IQ reports.
+The script exits with an error if an estimate is outside its tolerance or
+a packed sample is not restored.
+"""
+
+import argparse
+import cmath
+import ctypes
+import math
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+SRC_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'src')
+
+TURN = 65536
+IQ_INVALID = -32768
+
+# Reference period samples, 1 us apart.
+REF_COUNT = 8
+# Amplitude of the synthetic samples, the radio delivers 12-bit samples.
+AMPLITUDE = 1500
+# Error of the fixed-point phases and divisions, in Hz.
+QUANT_HZ = 200
+
+
+# Floating-point reference of dtm_iq_aoa_estimate() and the benchmark loops.
+HOST_SRC = r'''
+#include <complex.h>
+#include <math.h>
+#include <time.h>
+
+#include "dtm_iq_dsp.h"
+
+int aoa_float(const int16_t *iq, size_t count, const struct dtm_iq_aoa_params *params,
+	      struct dtm_iq_aoa *aoa)
+{
+	double complex z[128];
+	double complex rot;
+	double complex acc = 0;
+	size_t n = params->cfo.ref_count;
+	size_t lag = params->cfo.period;
+	double dt = (double)lag * params->cfo.spacing_us;
+	double nominal = 2 * M_PI * params->cfo.nominal / DTM_IQ_TURN;
+	double phase = 0;
+	double num = 0;
+	double offset;
+	double pred;
+	double sum = 0;
+	unsigned int cnt = 0;
+	double adv;
+	double s;
+	unsigned int pairs = 0;
+
+	if ((count > 128) || (count < n) || (n < 2)) {
+		return -1;
+	}
+
+	for (size_t k = 0; k < count; k++) {
+		z[k] = ((iq[2 * k] == DTM_IQ_INVALID) || (iq[2 * k + 1] == DTM_IQ_INVALID)) ?
+		       0 : (iq[2 * k] + I * iq[2 * k + 1]);
+		if (z[k] != 0) {
+			z[k] /= cabs(z[k]);
+		}
+	}
+
+	/* Offset in radians per microsecond from the reference period, refined
+	 * with the sample pairs of the same antenna unwrapped one by one and
+	 * weighted as in the kernel.
+	 */
+	for (size_t k = 1; k < n; k++) {
+		phase += carg(z[k] * conj(z[k - 1]) * cexp(-I * nominal));
+		num += (k - (n - 1) / 2.0) * phase;
+	}
+	offset = num * 12 / (n * (n * n - 1.0));
+	pred = offset * dt;
+	rot = cexp(-I * nominal * dt);
+
+	for (size_t m = n; m + lag < count; m++) {
+		double a;
+
+		if ((z[m] == 0) || (z[m + lag] == 0)) {
+			continue;
+		}
+
+		a = carg(z[m + lag] * conj(z[m]) * rot);
+		sum += pred + remainder(a - pred, 2 * M_PI);
+		cnt++;
+		pred = sum / cnt;
+	}
+
+	if (cnt) {
+		double w_ref = n * (n * n - 1.0);
+		double w_pairs = 6.0 * cnt * dt * dt;
+
+		offset = (w_ref * offset + w_pairs * pred / dt) / (w_ref + w_pairs);
+	}
+
+	adv = (nominal + offset) * params->cfo.spacing_us;
+	rot = cexp(-I * adv);
+
+	for (size_t m = n; m + 1 < count; m++) {
+		int step = params->element[(m + 1 - n) % lag] - params->element[(m - n) % lag];
+		double complex d;
+
+		if (((step != 1) && (step != -1)) || (z[m] == 0) || (z[m + 1] == 0)) {
+			continue;
+		}
+
+		d = z[m + 1] * conj(z[m]) * rot;
+		acc += (step > 0) ? d : conj(d);
+		pairs++;
+	}
+
+	if (pairs == 0) {
+		return -1;
+	}
+
+	s = carg(acc) / (2 * M_PI * params->spacing / 32768.0);
+	s = fmax(-1.0, fmin(1.0, s));
+
+	aoa->angle = (int16_t)lround(asin(s) * 1800 / M_PI);
+	aoa->quality = (uint16_t)lround(cabs(acc) / pairs * 32767);
+	aoa->pairs = pairs;
+
+	return 0;
+}
+
+/* Keeps the estimates of the benchmark loop. */
+volatile int16_t aoa_sink;
+
+double aoa_bench(int fixed, const int16_t *iq, size_t count,
+		 const struct dtm_iq_aoa_params *params, unsigned int runs)
+{
+	struct dtm_iq_aoa aoa = {0};
+	struct timespec start;
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (unsigned int i = 0; i < runs; i++) {
+		if (fixed) {
+			dtm_iq_aoa_estimate(iq, count, params, &aoa);
+		} else {
+			aoa_float(iq, count, params, &aoa);
+		}
+		aoa_sink = aoa.angle;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / runs;
+}
+
+double pack_bench(const int16_t *iq, size_t count, const struct dtm_iq_cfo_params *params,
+		  unsigned int runs)
+{
+	static uint8_t out[4 * 128 + 32];
+	struct dtm_iq_codec codec;
+	struct timespec start;
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (unsigned int i = 0; i < runs; i++) {
+		dtm_iq_codec_init(&codec, params);
+		dtm_iq_pack(&codec, iq, count, out, sizeof(out));
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / runs;
+}
+'''
+
+
+class CfoParams(ctypes.Structure):
+    _fields_ = [('ref_count', ctypes.c_uint8), ('spacing_us', ctypes.c_uint8),
+                ('period', ctypes.c_uint8), ('nominal', ctypes.c_uint16)]
+
+
+class Cfo(ctypes.Structure):
+    _fields_ = [('offset_hz', ctypes.c_int32), ('ref_hz', ctypes.c_int32),
+                ('drift_hz', ctypes.c_int32), ('pairs', ctypes.c_uint16)]
+
+
+class Codec(ctypes.Structure):
+    _fields_ = [('params', CfoParams), ('next', ctypes.c_size_t),
+                ('ref_sum', ctypes.c_int64 * 2), ('lag_sum', ctypes.c_int64 * 2)]
+
+
+class AoaParams(ctypes.Structure):
+    _fields_ = [('cfo', CfoParams), ('element', ctypes.POINTER(ctypes.c_uint8)),
+                ('spacing', ctypes.c_uint16)]
+
+
+class Aoa(ctypes.Structure):
+    _fields_ = [('angle', ctypes.c_int16), ('quality', ctypes.c_uint16),
+                ('pairs', ctypes.c_uint16)]
+
+
+def library_build(cc, workdir):
+    lib = os.path.join(workdir, 'dtm_iq_dsp.so')
+    ref = os.path.join(workdir, 'reference.c')
+    with open(ref, 'w') as f:
+        f.write(HOST_SRC)
+    cmd = [cc, '-O2', '-shared', '-fPIC', '-Wall', '-Wextra', '-Werror',
+           '-I', SRC_DIR, os.path.join(SRC_DIR, 'dtm_iq_dsp.c'), ref, '-o', lib, '-lm']
+    subprocess.run(cmd, check=True)
+
+    dsp = ctypes.CDLL(lib)
+    dsp.dtm_iq_cfo_estimate.argtypes = [ctypes.POINTER(ctypes.c_int16), ctypes.c_size_t,
+                                        ctypes.POINTER(CfoParams), ctypes.POINTER(Cfo)]
+    dsp.dtm_iq_cfo_estimate.restype = ctypes.c_int
+    for estimate in (dsp.dtm_iq_aoa_estimate, dsp.aoa_float):
+        estimate.argtypes = [ctypes.POINTER(ctypes.c_int16), ctypes.c_size_t,
+                             ctypes.POINTER(AoaParams), ctypes.POINTER(Aoa)]
+        estimate.restype = ctypes.c_int
+    dsp.aoa_bench.argtypes = [ctypes.c_int, ctypes.POINTER(ctypes.c_int16), ctypes.c_size_t,
+                              ctypes.POINTER(AoaParams), ctypes.c_uint]
+    dsp.aoa_bench.restype = ctypes.c_double
+    dsp.dtm_iq_codec_init.argtypes = [ctypes.POINTER(Codec), ctypes.POINTER(CfoParams)]
+    dsp.dtm_iq_codec_init.restype = None
+    dsp.dtm_iq_pack.argtypes = [ctypes.POINTER(Codec), ctypes.POINTER(ctypes.c_int16),
+                                ctypes.c_size_t, ctypes.POINTER(ctypes.c_uint8), ctypes.c_size_t]
+    dsp.dtm_iq_pack.restype = ctypes.c_size_t
+    dsp.dtm_iq_unpack.argtypes = [ctypes.POINTER(Codec), ctypes.POINTER(ctypes.c_uint8),
+                                  ctypes.c_size_t, ctypes.POINTER(ctypes.c_int16), ctypes.c_size_t]
+    dsp.dtm_iq_unpack.restype = ctypes.c_int
+    dsp.pack_bench.argtypes = [ctypes.POINTER(ctypes.c_int16), ctypes.c_size_t,
+                               ctypes.POINTER(CfoParams), ctypes.c_uint]
+    dsp.pack_bench.restype = ctypes.c_double
+    return dsp
+
+
+def iq_array(samples, limit=32767):
+    flat = []
+    for s in samples:
+        if s is None:
+            flat += [IQ_INVALID, IQ_INVALID]
+        else:
+            flat += [max(-limit, min(limit, round(s.real))),
+                     max(-limit, min(limit, round(s.imag)))]
+    return (ctypes.c_int16 * len(flat))(*flat)
+
+
+def cte_times(slot_us, cte_us):
+    """Sampling times in microseconds from the start of the reference period."""
+    spacing = 2 * slot_us
+    times = [float(k) for k in range(REF_COUNT)]
+    t = REF_COUNT + slot_us
+    while t + slot_us <= cte_us - 4:
+        times.append(t)
+        t += spacing
+    return times
+
+
+def cte_synth(rng, times, nominal_hz, offset_hz, drift_hz, pattern, snr_db, invalid,
+              ant_phase=None, amplitude=AMPLITUDE):
+    """CTE with a linear frequency drift of drift_hz over the samples and the
+    given or a random phase per antenna. The reference period uses the first
+    antenna.
+    """
+    span = times[-1]
+    if ant_phase is None:
+        ant_phase = [rng.uniform(0, 2 * math.pi) for _ in range(max(pattern) + 1)]
+    noise = amplitude * 10 ** (-snr_db / 20) / math.sqrt(2)
+    samples = []
+
+    for idx, t in enumerate(times):
+        # Phase of a tone whose frequency changes linearly with the time.
+        phase = 2 * math.pi * ((nominal_hz + offset_hz) * t + drift_hz * t * t / (2 * span)) / 1e6
+        ant = pattern[0] if idx < REF_COUNT else pattern[(idx - REF_COUNT) % len(pattern)]
+        s = amplitude * cmath.exp(1j * (phase + ant_phase[ant]))
+        s += complex(rng.gauss(0, noise), rng.gauss(0, noise))
+        samples.append(None if idx >= REF_COUNT and rng.random() < invalid else s)
+
+    return samples
+
+
+def cfo_check(dsp, args):
+    rng = random.Random(args.seed)
+    failures = 0
+
+    print(f'{"phy":>3} {"slot":>4} {"period":>6} {"offset":>8} {"drift":>6} '
+          f'{"est_offset":>10} {"est_ref":>8} {"est_drift":>9} {"pairs":>5}')
+
+    for phy, nominal_hz in (('1m', 250000), ('2m', 500000)):
+        for slot_us in (1, 2):
+            for pattern in ([0], [0, 1, 2, 3], [0, 1, 2, 3, 2, 1]):
+                for offset_hz in (-150000, -20000, 0, 5000, 100000):
+                    for drift_hz in (0, 2000):
+                        times = cte_times(slot_us, args.cte_us)
+                        samples = cte_synth(rng, times, nominal_hz, offset_hz, drift_hz,
+                                            pattern, args.snr, args.invalid)
+                        params = CfoParams(REF_COUNT, 2 * slot_us, len(pattern),
+                                           (nominal_hz * TURN // 1000000) % TURN)
+                        cfo = Cfo()
+                        err = dsp.dtm_iq_cfo_estimate(iq_array(samples), len(samples),
+                                                      ctypes.byref(params), ctypes.byref(cfo))
+
+                        # The estimate combines the frequency at the middle of
+                        # the reference period and the average frequency of the
+                        # later sample pairs as the kernel, the drift is the
+                        # change between the halves of the pairs.
+                        span = times[-1]
+                        dt = 2 * slot_us * len(pattern)
+                        w_ref = REF_COUNT * (REF_COUNT ** 2 - 1)
+                        w_pairs = 6 * cfo.pairs * dt ** 2
+                        f_ref = offset_hz + drift_hz * (REF_COUNT - 1) / (2 * span)
+                        expect_drift = 0
+                        expect = f_ref
+                        if cfo.pairs:
+                            start = times[REF_COUNT]
+                            f_pairs = offset_hz + drift_hz * (start + span) / (2 * span)
+                            expect = (w_ref * f_ref + w_pairs * f_pairs) / (w_ref + w_pairs)
+                            if cfo.pairs > 1:
+                                expect_drift = drift_hz * (span - start) / (2 * span)
+
+                        # Tolerance from the phase noise of a sample, in turns,
+                        # propagated through the weighted estimates.
+                        noise = 10 ** (-args.snr / 20) / (math.sqrt(2) * 2 * math.pi) * 1e6
+                        tolerance = args.sigma * noise * math.sqrt(12 / (w_ref + w_pairs))
+                        drift_tolerance = (args.sigma * noise * math.sqrt(48 / w_pairs)
+                                           if cfo.pairs > 1 else 0)
+
+                        ok = (err == 0 and
+                              abs(cfo.offset_hz - expect) <= tolerance + QUANT_HZ and
+                              abs(cfo.drift_hz - expect_drift) <= drift_tolerance + QUANT_HZ)
+                        failures += not ok
+
+                        print(f'{phy:>3} {slot_us:>4} {len(pattern):>6} {offset_hz:>8} '
+                              f'{drift_hz:>6} {cfo.offset_hz:>10} {cfo.ref_hz:>8} '
+                              f'{cfo.drift_hz:>9} {cfo.pairs:>5}{"" if ok else "  FAIL"}')
+
+    return failures
+
+
+def aoa_check(dsp, args):
+    rng = random.Random(args.seed)
+    failures = 0
+    errors = {'fixed': [], 'float': []}
+    bench = {'fixed': [], 'float': []}
+
+    print(f'{"phy":>3} {"slot":>4} {"pattern":>7} {"spacing":>7} {"angle":>6} '
+          f'{"fixed":>6} {"float":>6} {"quality":>7} {"pairs":>5}')
+
+    for phy, nominal_hz in (('1m', 250000), ('2m', 500000)):
+        for slot_us in (1, 2):
+            for pattern in ([0, 1, 2, 3], [0, 1, 2, 3, 2, 1], [0, 1, 2, 3, 4, 5, 6, 7]):
+                for spacing in (0.35, 0.5):
+                    for angle in (-70, -40, -10, 0, 25, 55, 80):
+                        times = cte_times(slot_us, args.cte_us)
+                        # Phase of the wave on each element of the linear array.
+                        ant_phase = [2 * math.pi * spacing * pos * math.sin(math.radians(angle))
+                                     for pos in range(max(pattern) + 1)]
+                        offset_hz = rng.uniform(-50000, 50000)
+                        samples = cte_synth(rng, times, nominal_hz, offset_hz, 0, pattern,
+                                            args.snr, args.invalid, ant_phase)
+                        iq = iq_array(samples)
+                        element = (ctypes.c_uint8 * len(pattern))(*pattern)
+                        params = AoaParams(CfoParams(REF_COUNT, 2 * slot_us, len(pattern),
+                                                     (nominal_hz * TURN // 1000000) % TURN),
+                                           element, round(spacing * 32768))
+                        fixed = Aoa()
+                        ref = Aoa()
+                        err = dsp.dtm_iq_aoa_estimate(iq, len(samples), ctypes.byref(params),
+                                                      ctypes.byref(fixed))
+                        err |= dsp.aoa_float(iq, len(samples), ctypes.byref(params),
+                                             ctypes.byref(ref))
+
+                        for kind in bench:
+                            bench[kind].append(dsp.aoa_bench(kind == 'fixed', iq, len(samples),
+                                                             ctypes.byref(params), args.runs))
+
+                        errors['fixed'].append(fixed.angle / 10 - angle)
+                        errors['float'].append(ref.angle / 10 - angle)
+                        ok = (err == 0 and fixed.pairs == ref.pairs and
+                              abs(fixed.angle - ref.angle) / 10 <= args.tolerance)
+                        failures += not ok
+
+                        print(f'{phy:>3} {slot_us:>4} {len(pattern):>7} {spacing:>7} '
+                              f'{angle:>6} {fixed.angle / 10:>6} {ref.angle / 10:>6} '
+                              f'{fixed.quality / 32768:>7.3f} {fixed.pairs:>5}'
+                              f'{"" if ok else "  FAIL"}')
+
+    print()
+    for kind in errors:
+        rms = math.sqrt(sum(e * e for e in errors[kind]) / len(errors[kind]))
+        avg = sum(bench[kind]) / len(bench[kind])
+        print(f'{kind:>5}: rms angle error {rms:.2f} deg, {avg:.0f} ns per estimate')
+
+    return failures
+
+
+def codec_pack(dsp, iq, count, params, chunk):
+    """Pack the samples in pieces of at most chunk octets, as the device."""
+    codec = Codec()
+    dsp.dtm_iq_codec_init(ctypes.byref(codec), ctypes.byref(params))
+    pieces = []
+    while codec.next < count:
+        first = codec.next
+        out = (ctypes.c_uint8 * chunk)()
+        length = dsp.dtm_iq_pack(ctypes.byref(codec), iq, count, out, chunk)
+        pieces.append((bytes(out[:length]), codec.next))
+        if codec.next == first:
+            raise RuntimeError('no block fits the chunk')
+    return pieces
+
+
+def codec_unpack(dsp, pieces, count, params):
+    codec = Codec()
+    dsp.dtm_iq_codec_init(ctypes.byref(codec), ctypes.byref(params))
+    iq = (ctypes.c_int16 * (2 * count))()
+    for data, end in pieces:
+        buf = (ctypes.c_uint8 * max(1, len(data))).from_buffer_copy(data.ljust(1, b'\0'))
+        if dsp.dtm_iq_unpack(ctypes.byref(codec), buf, len(data), iq, end):
+            return None
+    return iq
+
+
+def codec_check(dsp, args):
+    rng = random.Random(args.seed)
+    failures = 0
+    packed_total = 0
+    hci_total = 0
+    samples_total = 0
+    bench = []
+
+    print(f'{"phy":>3} {"slot":>4} {"period":>6} {"amplitude":>9} {"snr":>4} '
+          f'{"samples":>7} {"packed":>6} {"hci":>4} {"bits":>5} {"events":>6}')
+
+    for phy, nominal_hz in (('1m', 250000), ('2m', 500000)):
+        for slot_us in (1, 2):
+            for pattern in ([0], [0, 1, 2, 3], [0, 1, 2, 3, 2, 1]):
+                for amplitude in args.amplitude:
+                    for snr in args.snr:
+                        times = cte_times(slot_us, args.cte_us)
+                        samples = cte_synth(rng, times, nominal_hz,
+                                            rng.uniform(-args.offset, args.offset), 0,
+                                            pattern, snr, args.invalid,
+                                            amplitude=amplitude)
+                        # The radio delivers 12-bit samples.
+                        iq = iq_array(samples, 2047)
+                        count = len(samples)
+                        params = CfoParams(REF_COUNT, 2 * slot_us, len(pattern),
+                                           (nominal_hz * TURN // 1000000) % TURN)
+
+                        pieces = codec_pack(dsp, iq, count, params, args.chunk)
+                        restored = codec_unpack(dsp, pieces, count, params)
+                        ok = restored is not None and list(restored) == list(iq)
+                        failures += not ok
+
+                        packed = sum(len(data) for data, _ in pieces)
+                        packed_total += packed
+                        hci_total += 2 * count
+                        samples_total += count
+                        bench.append(dsp.pack_bench(iq, count, ctypes.byref(params),
+                                                    args.runs) / count)
+
+                        print(f'{phy:>3} {slot_us:>4} {len(pattern):>6} {amplitude:>9} '
+                              f'{snr:>4} {count:>7} {packed:>6} {2 * count:>4} '
+                              f'{8 * packed / count:>5.1f} {len(pieces):>6}'
+                              f'{"" if ok else "  FAIL"}')
+
+    print()
+    print(f'packed {8 * packed_total / samples_total:.2f} bits per IQ sample, '
+          f'{packed_total / hci_total:.2f} of the HCI reports, '
+          f'{packed_total / (4 * samples_total):.2f} of the 16-bit samples')
+    print(f'encoding {sum(bench) / len(bench):.1f} ns per IQ sample')
+
+    # Random full-range samples must be restored too, at the largest width.
+    for _ in range(20):
+        count = rng.randint(1, 128)
+        iq = (ctypes.c_int16 * (2 * count))(*[rng.randint(-32768, 32767)
+                                               for _ in range(2 * count)])
+        params = CfoParams(rng.randint(0, 8), rng.randint(1, 4), rng.randint(1, 8),
+                           rng.randrange(TURN))
+        restored = codec_unpack(dsp, codec_pack(dsp, iq, count, params, args.chunk),
+                                count, params)
+        if restored is None or list(restored) != list(iq):
+            print(f'random samples of count {count} not restored  FAIL')
+            failures += 1
+
+    return failures
+
+
+def main():
+    argp = argparse.ArgumentParser(description=__doc__,
+                                   formatter_class=argparse.RawDescriptionHelpFormatter)
+    argp.add_argument('--cc', default=os.environ.get('CC', 'cc'), help='host C compiler')
+    argp.add_argument('--seed', type=int, default=1, help='seed of the synthetic noise')
+    sub = argp.add_subparsers(dest='kernel', required=True)
+
+    cfo = sub.add_parser('cfo', help='carrier frequency offset and drift estimation')
+    cfo.add_argument('--snr', type=float, default=30, help='SNR of the samples in dB')
+    cfo.add_argument('--cte-us', type=int, default=160, help='CTE length in microseconds')
+    cfo.add_argument('--invalid', type=float, default=0.02,
+                     help='share of the invalid samples after the reference period')
+    cfo.add_argument('--sigma', type=float, default=4,
+                     help='tolerance in standard deviations of the estimates')
+
+    aoa = sub.add_parser('aoa', help='angle of arrival estimation and its float reference')
+    aoa.add_argument('--snr', type=float, default=20, help='SNR of the samples in dB')
+    aoa.add_argument('--cte-us', type=int, default=160, help='CTE length in microseconds')
+    aoa.add_argument('--invalid', type=float, default=0.02,
+                     help='share of the invalid samples after the reference period')
+    aoa.add_argument('--tolerance', type=float, default=0.5,
+                     help='largest difference from the float reference in degrees')
+    aoa.add_argument('--runs', type=int, default=1000,
+                     help='estimates of each CTE timed in the benchmark')
+
+    codec = sub.add_parser('codec', help='lossless packing of the IQ samples')
+    codec.add_argument('--snr', type=float, nargs='+', default=[20, 30, 40],
+                       help='SNR of the samples in dB')
+    codec.add_argument('--amplitude', type=int, nargs='+', default=[400, 1500],
+                       help='amplitude of the samples')
+    codec.add_argument('--offset', type=float, default=50000,
+                       help='largest frequency offset in Hz')
+    codec.add_argument('--cte-us', type=int, default=160, help='CTE length in microseconds')
+    codec.add_argument('--invalid', type=float, default=0,
+                       help='share of the invalid samples after the reference period')
+    codec.add_argument('--chunk', type=int, default=226,
+                       help='largest packed data of a vendor event in octets')
+    codec.add_argument('--runs', type=int, default=1000,
+                       help='packings of each CTE timed in the benchmark')
+
+    args = argp.parse_args()
+
+    with tempfile.TemporaryDirectory() as workdir:
+        dsp = library_build(args.cc, workdir)
+        failures = {'cfo': cfo_check, 'aoa': aoa_check, 'codec': codec_check}[args.kernel](dsp, args)
+
+    if failures:
+        sys.exit(f'{failures} estimates outside the tolerance')
+
+
+if __name__ == '__main__':
+    main()
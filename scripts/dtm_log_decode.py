@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Decode the dictionary log output of the DTM sample.
+
+Build the sample with overlay-log-dictionary.conf, capture the RTT log
+channel to a file, for example with:
+
+    JLinkRTTLogger -Device NRF52840_XXAA -If SWD -Speed 4000 -RTTChannel 1 dtm.log
+
+and format it with the dictionary of the same build:
+
+    dtm_log_decode.py build/zephyr/log_dictionary.json dtm.log
+
+The parser of the Zephyr tree in ZEPHYR_BASE is used.
+"""
+
+import argparse
+import binascii
+import os
+import sys
+
+
+def parser_import(zephyr_base):
+    path = os.path.join(zephyr_base, 'scripts', 'logging', 'dictionary')
+    if not os.path.isdir(path):
+        sys.exit(f'No dictionary log parser in {path}, set ZEPHYR_BASE')
+
+    sys.path.insert(0, path)
+
+    # pylint: disable=import-outside-toplevel
+    import dictionary_parser
+    from dictionary_parser.log_database import LogDatabase
+
+    return dictionary_parser, LogDatabase
+
+
+def log_read(path, is_hex):
+    if path == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(path, 'rb') as f:
+            data = f.read()
+
+    if is_hex:
+        data = binascii.unhexlify(b''.join(data.split()))
+
+    return data
+
+
+def main():
+    argp = argparse.ArgumentParser(description=__doc__,
+                                   formatter_class=argparse.RawDescriptionHelpFormatter)
+    argp.add_argument('dictionary', help='log_dictionary.json of the build')
+    argp.add_argument('logfile', help='captured log channel, - for the standard input')
+    argp.add_argument('--hex', action='store_true', help='the capture is in hexadecimal text')
+    argp.add_argument('--zephyr-base', default=os.environ.get('ZEPHYR_BASE'),
+                      help='Zephyr tree, ZEPHYR_BASE by default')
+    argp.add_argument('--debug', action='store_true', help='print the parser diagnostics')
+    args = argp.parse_args()
+
+    if not args.zephyr_base:
+        sys.exit('ZEPHYR_BASE is not set')
+
+    dictionary_parser, LogDatabase = parser_import(args.zephyr_base)
+
+    database = LogDatabase.read_json_database(args.dictionary)
+    if database is None:
+        sys.exit(f'Cannot read the dictionary {args.dictionary}')
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        sys.exit('Unsupported dictionary version')
+
+    if not log_parser.parse_log_data(log_read(args.logfile, args.hex), debug=args.debug):
+        sys.exit('The log data is incomplete or does not match the dictionary')
+
+
+if __name__ == '__main__':
+    main()
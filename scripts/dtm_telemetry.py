@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Read the DTM telemetry block over SWD while a test runs.
+
+The sample must be built with CONFIG_DTM_TELEMETRY. The address of the
+block is taken from the dtm_telemetry symbol of the ELF file, or given
+with --address. The device sends nothing, the J-Link reads the RAM in the
+background of the running test:
+
+    dtm_telemetry.py --device NRF52840_XXAA --elf build/zephyr/zephyr.elf --period 1
+
+Requires the pylink-square package, and pyelftools with --elf.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+MAGIC = 0x544D5444
+VERSION = 1
+ISR_MAX = 8
+
+# Layout of struct dtm_telemetry, see src/dtm_telemetry.h.
+HEADER = struct.Struct('<IHHI')
+BODY = struct.Struct('<BBBbIIII')
+ISR = struct.Struct('<II')
+SIZE = HEADER.size + BODY.size + ISR_MAX * ISR.size
+
+STATES = ['uninitialized', 'idle', 'tx', 'carrier', 'rx', 'rssi_sweep']
+PHYS = ['1m', '2m', 's8', 's2']
+ISR_NAMES = ['radio_handler', 'on_radio_end_event', 'check_pdu', 'report_iq',
+             'anomaly_172_rssi_handle', 'radio_deferred_handler']
+
+FIELDS = ['seq', 'state', 'channel', 'phy', 'rssi_last', 'tests', 'rx_packets',
+          'rx_crc_errors', 'tx_packets']
+
+# Reads retried while the device updates the block.
+READ_RETRIES = 100
+
+
+def symbol_address(elf, name):
+    # pylint: disable=import-outside-toplevel
+    from elftools.elf.elffile import ELFFile
+    from elftools.elf.sections import SymbolTableSection
+
+    with open(elf, 'rb') as f:
+        for section in ELFFile(f).iter_sections():
+            if isinstance(section, SymbolTableSection):
+                symbols = section.get_symbol_by_name(name)
+                if symbols:
+                    return symbols[0]['st_value']
+
+    sys.exit(f'No {name} symbol in {elf}, is CONFIG_DTM_TELEMETRY enabled?')
+
+
+def block_read(jlink, address):
+    """Read a consistent snapshot, seq is even and unchanged across the read."""
+    for _ in range(READ_RETRIES):
+        seq = jlink.memory_read32(address + 8, 1)[0]
+        if seq & 1:
+            continue
+
+        data = bytes(jlink.memory_read8(address, SIZE))
+        if HEADER.unpack_from(data)[3] == seq:
+            return data
+
+    return None
+
+
+def block_parse(data):
+    magic, version, size, seq = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        sys.exit(f'Invalid telemetry block magic 0x{magic:08x}, is DTM initialized?')
+    if version != VERSION or size < SIZE:
+        sys.exit(f'Unsupported telemetry block version {version}, size {size}')
+
+    state, channel, phy, rssi, tests, rx, crc, tx = BODY.unpack_from(data, HEADER.size)
+    isr = [ISR.unpack_from(data, HEADER.size + BODY.size + i * ISR.size)
+           for i in range(ISR_MAX)]
+
+    return {
+        'seq': seq,
+        'state': STATES[state] if state < len(STATES) else state,
+        'channel': channel,
+        'phy': PHYS[phy] if phy < len(PHYS) else phy,
+        'rssi_last': rssi,
+        'tests': tests,
+        'rx_packets': rx,
+        'rx_crc_errors': crc,
+        'tx_packets': tx,
+        'isr': isr,
+    }
+
+
+def block_print(block, csv, show_isr):
+    if csv:
+        print(','.join(str(block[f]) for f in FIELDS))
+        return
+
+    print(' '.join(f'{f}={block[f]}' for f in FIELDS))
+
+    if show_isr:
+        for name, (count, cycles) in zip(ISR_NAMES, block['isr']):
+            if count:
+                print(f'  {name:24} count={count} max_cycles={cycles}')
+
+
+def main():
+    argp = argparse.ArgumentParser(description=__doc__,
+                                   formatter_class=argparse.RawDescriptionHelpFormatter)
+    argp.add_argument('--device', required=True, help='J-Link device name')
+    argp.add_argument('--serial', type=int, help='J-Link serial number')
+    argp.add_argument('--speed', type=int, default=4000, help='SWD speed in kHz')
+    addr = argp.add_mutually_exclusive_group(required=True)
+    addr.add_argument('--elf', help='zephyr.elf of the build')
+    addr.add_argument('--address', type=lambda x: int(x, 0), help='address of the block')
+    argp.add_argument('--period', type=float, help='read periodically, in seconds')
+    argp.add_argument('--csv', action='store_true', help='one CSV line per read')
+    argp.add_argument('--isr', action='store_true', help='print the interrupt handler entries')
+    args = argp.parse_args()
+
+    address = args.address if args.elf is None else symbol_address(args.elf, 'dtm_telemetry')
+
+    # pylint: disable=import-outside-toplevel
+    import pylink
+
+    jlink = pylink.JLink()
+    jlink.open(serial_no=args.serial)
+    jlink.set_tif(pylink.enums.JLinkInterfaces.SWD)
+    jlink.connect(args.device, speed=args.speed)
+
+    if args.csv:
+        print(','.join(FIELDS))
+
+    try:
+        while True:
+            data = block_read(jlink, address)
+            if data is None:
+                print('No consistent snapshot, the block is updated too often',
+                      file=sys.stderr)
+            else:
+                block_print(block_parse(data), args.csv, args.isr)
+
+            if args.period is None:
+                break
+
+            time.sleep(args.period)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        jlink.close()
+
+
+if __name__ == '__main__':
+    main()
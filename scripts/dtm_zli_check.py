@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Check that the zero-latency radio interrupt does not call the kernel.
+
+With CONFIG_DTM_RADIO_ZLI the radio interrupt is not masked by the kernel,
+so the handler and every function it calls must stay off the kernel API and
+the console. The check disassembles the built objects or the linked image,
+follows the calls from the handler and fails if a reachable function
+references a k_*, printk or logging symbol:
+
+    dtm_zli_check.py build/zephyr/zephyr.elf
+    dtm_zli_check.py --objdump arm-zephyr-eabi-objdump build/app/libapp.a
+
+The dtm_zli_check build target checks the objects of the application.
+The linked image also covers the calls into the Zephyr and nrfx libraries.
+Calls through function pointers are not followed.
+
+    dtm_zli_check.py --self-test
+
+builds a handler with a kernel call and a clean one with the host C
+compiler and checks that only the first one is reported.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+ENTRIES = ['radio_zli_handler', 'radio_handler']
+FORBIDDEN = r'^(z_impl_)?k_\w+$|^v?printk$|^z_log_msg'
+
+FUNC_RE = re.compile(r'^[0-9a-fA-F]+ <([^>]+)>:$')
+# Call or branch target resolved by the disassembler.
+TARGET_RE = re.compile(r'<([^>+]+)(\+0x[0-9a-fA-F]+)?>')
+# Relocation of an unlinked object.
+RELOC_RE = re.compile(r'^\s*[0-9a-fA-F]+: R_\S+\s+([^\s+-]+)')
+
+
+def symbol_name(name):
+    """Function name of a section or PLT symbol."""
+    for prefix in ('.text.', '.literal.'):
+        if name.startswith(prefix):
+            name = name[len(prefix):]
+    return name.split('@')[0]
+
+
+def call_graph(objdump, files):
+    """Symbols referenced by each function of the files."""
+    out = subprocess.run([objdump, '-dr', '--no-show-raw-insn', *files],
+                         check=True, capture_output=True, text=True).stdout
+    graph = {}
+    func = None
+
+    for line in out.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            func = symbol_name(m.group(1))
+            graph.setdefault(func, set())
+            continue
+        if func is None:
+            continue
+
+        m = RELOC_RE.match(line)
+        refs = [m.group(1)] if m else [t[0] for t in TARGET_RE.findall(line)]
+        for ref in refs:
+            ref = symbol_name(ref)
+            if ref != func:
+                graph[func].add(ref)
+
+    return graph
+
+
+def check(graph, entries, forbidden):
+    """Forbidden references reachable from the entries, as (path, symbol)."""
+    found = [e for e in entries if e in graph]
+    bad = []
+    seen = set()
+    stack = [(e, [e]) for e in found]
+
+    if not found:
+        sys.exit(f'none of {", ".join(entries)} found, is CONFIG_DTM_RADIO_ZLI enabled?')
+
+    while stack:
+        func, path = stack.pop()
+        if func in seen:
+            continue
+        seen.add(func)
+
+        for ref in sorted(graph.get(func, ())):
+            if forbidden.match(ref):
+                bad.append((path, ref))
+            elif ref in graph:
+                stack.append((ref, path + [ref]))
+
+    return found, seen, bad
+
+
+def report(graph, entries, forbidden):
+    found, seen, bad = check(graph, entries, forbidden)
+
+    print(f'{len(seen)} functions reachable from {", ".join(found)}')
+    for path, ref in bad:
+        print(f'{" -> ".join(path)} references {ref}  FAIL')
+
+    return len(bad)
+
+
+SELF_TEST_SRC = r'''
+void k_sem_give(void *sem);
+int printk(const char *fmt, ...);
+
+volatile int sink;
+
+__attribute__((noinline)) static void leaf_clean(void)
+{
+	sink++;
+}
+
+__attribute__((noinline)) static void leaf_kernel(void)
+{
+	k_sem_give((void *)&sink);
+}
+
+__attribute__((noinline)) static void leaf_console(void)
+{
+	printk("%d\n", sink);
+}
+
+void radio_zli_handler(void)
+{
+	leaf_clean();
+}
+
+void radio_handler(void)
+{
+	leaf_clean();
+	if (sink) {
+		leaf_kernel();
+	} else {
+		leaf_console();
+	}
+}
+'''
+
+
+def self_test(args, forbidden):
+    with tempfile.TemporaryDirectory() as workdir:
+        src = os.path.join(workdir, 'zli.c')
+        obj = os.path.join(workdir, 'zli.o')
+        with open(src, 'w') as f:
+            f.write(SELF_TEST_SRC)
+        subprocess.run([args.cc, '-O2', '-ffunction-sections', '-c', src, '-o', obj],
+                       check=True)
+        graph = call_graph(args.objdump, [obj])
+
+    failures = 0
+    for entry, expected in (('radio_zli_handler', set()),
+                            ('radio_handler', {'k_sem_give', 'printk'})):
+        found = {ref for _, ref in check(graph, [entry], forbidden)[2]}
+        ok = found == expected
+        print(f'{entry}: {", ".join(sorted(found)) or "clean"}{"" if ok else "  FAIL"}')
+        failures += not ok
+
+    return failures
+
+
+def main():
+    argp = argparse.ArgumentParser(description=__doc__,
+                                   formatter_class=argparse.RawDescriptionHelpFormatter)
+    argp.add_argument('--objdump', default=os.environ.get('OBJDUMP', 'objdump'),
+                      help='objdump of the toolchain that built the files')
+    argp.add_argument('--cc', default=os.environ.get('CC', 'cc'),
+                      help='host C compiler of the self-test')
+    argp.add_argument('--entry', action='append',
+                      help=f'handler to check, default {" and ".join(ENTRIES)}')
+    argp.add_argument('--forbidden', default=FORBIDDEN,
+                      help='regular expression of the forbidden symbols')
+    argp.add_argument('--self-test', action='store_true',
+                      help='check the check on a host-built handler')
+    argp.add_argument('files', nargs='*', help='objects, archives or image of the build')
+
+    args = argp.parse_args()
+    forbidden = re.compile(args.forbidden)
+
+    if args.self_test:
+        failures = self_test(args, forbidden)
+    elif args.files:
+        failures = report(call_graph(args.objdump, args.files), args.entry or ENTRIES,
+                          forbidden)
+    else:
+        argp.error('no file to check')
+
+    if failures:
+        sys.exit(f'{failures} forbidden references from the zero-latency interrupt')
+
+
+if __name__ == '__main__':
+    main()
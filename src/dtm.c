@@ -23,7 +23,14 @@
 
 LOG_MODULE_DECLARE(dtm, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
 
-#include "emc_config.h"
+#include "dtm_config.h"
+#include "dtm_cte_cfo.h"
+#include "dtm_exec.h"
+#include "dtm_aoa.h"
+#include "dtm_iq_stream.h"
+#include "dtm_isr_stats.h"
+#include "dtm_rssi_stats.h"
+#include "dtm_telemetry.h"
 
 #include <hal/nrf_egu.h>
 #include <hal/nrf_nvmc.h>
@@ -50,31 +57,130 @@ LOG_MODULE_DECLARE(dtm, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
 
 /* Note that the timer instance 2 is used in the FEM driver. */
 
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 /* Timer used for the workaround for errata 172 on affected nRF5 devices. */
 #define ANOMALY_172_TIMER_INSTANCE     3
-#define ANOMALY_172_TIMER_IRQ          NRFX_CONCAT_3(TIMER,		    \
-						ANOMALY_172_TIMER_INSTANCE, \
-						_IRQn)
-#define ANOMALY_172_TIMER_IRQ_HANDLER  NRFX_CONCAT_3(nrfx_timer_,	    \
-						ANOMALY_172_TIMER_INSTANCE, \
-						_irq_handler)
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
+
+#if CONFIG_DTM_MEAS_TIMER
+/* Free-running timer capturing the packet timestamps. */
+#define MEAS_TIMER_INSTANCE        CONFIG_DTM_MEAS_TIMER_INSTANCE
+/* Measurement timer resolution. */
+#define MEAS_TIMER_TICKS_PER_US    16
+/* Capture channels of the radio ADDRESS and END events. */
+#define MEAS_TIMER_CC_ADDRESS      NRF_TIMER_CC_CHANNEL0
+#define MEAS_TIMER_CC_END          NRF_TIMER_CC_CHANNEL1
+/* Capture channel of the END event of the first transmitted packet. */
+#define MEAS_TIMER_CC_FIRST_END    NRF_TIMER_CC_CHANNEL2
+#endif /* CONFIG_DTM_MEAS_TIMER */
+
+#if CONFIG_DTM_RX_TIMING
+/* Jitter histogram bin width in timer ticks. */
+#define RX_TIMING_HIST_BIN_TICKS \
+	MAX(1, (CONFIG_DTM_RX_TIMING_HIST_BIN_NS * MEAS_TIMER_TICKS_PER_US) / 1000)
+#endif /* CONFIG_DTM_RX_TIMING */
+
+#if CONFIG_DTM_TX_STATS
+/* Timer counting the transmitted packets. */
+#define COUNTER_TIMER_INSTANCE     CONFIG_DTM_COUNTER_TIMER_INSTANCE
+/* Compare channel marking the first transmitted packet. */
+#define COUNTER_CC_FIRST           NRF_TIMER_CC_CHANNEL0
+/* Capture channel of the packet count. */
+#define COUNTER_CC_READ            NRF_TIMER_CC_CHANNEL3
+#endif /* CONFIG_DTM_TX_STATS */
+
+#if CONFIG_DTM_TX_BURST
+/* Compare channel of the last packet of a burst. */
+#define COUNTER_CC_BURST           NRF_TIMER_CC_CHANNEL1
+#define COUNTER_TIMER_IRQ          NRFX_CONCAT_3(TIMER,			 \
+						 COUNTER_TIMER_INSTANCE, \
+						 _IRQn)
+#define COUNTER_TIMER_IRQ_HANDLER  NRFX_CONCAT_3(nrfx_timer_,		 \
+						 COUNTER_TIMER_INSTANCE, \
+						 _irq_handler)
+#endif /* CONFIG_DTM_TX_BURST */
 
 /* Helper macro for labeling timer instances. */
 #define NRFX_TIMER_CONFIG_LABEL(_num) NRFX_CONCAT_3(CONFIG_, NRFX_TIMER, _num)
 
 BUILD_ASSERT(NRFX_TIMER_CONFIG_LABEL(DEFAULT_TIMER_INSTANCE) == 1,
 	     "Core DTM timer needs additional KConfig configuration");
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 BUILD_ASSERT(NRFX_TIMER_CONFIG_LABEL(ANOMALY_172_TIMER_INSTANCE) == 1,
 	     "Anomaly DTM timer needs additional KConfig configuration");
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
+#if CONFIG_DTM_MEAS_TIMER
+BUILD_ASSERT(NRFX_TIMER_CONFIG_LABEL(MEAS_TIMER_INSTANCE) == 1,
+	     "Measurement DTM timer needs additional KConfig configuration");
+BUILD_ASSERT(MEAS_TIMER_INSTANCE != DEFAULT_TIMER_INSTANCE,
+	     "Measurement DTM timer conflicts with the core DTM timer");
+#if CONFIG_DTM_TRANSPORT_TWOWIRE
+BUILD_ASSERT(MEAS_TIMER_INSTANCE != 1,
+	     "Measurement DTM timer conflicts with the Two Wire transport timer");
+#endif /* CONFIG_DTM_TRANSPORT_TWOWIRE */
+#if CONFIG_FEM
+BUILD_ASSERT(MEAS_TIMER_INSTANCE != 2,
+	     "Measurement DTM timer conflicts with the front-end module timer");
+#endif /* CONFIG_FEM */
+#if DTM_ANOMALY_172_ENABLED
+BUILD_ASSERT(MEAS_TIMER_INSTANCE != ANOMALY_172_TIMER_INSTANCE,
+	     "Measurement DTM timer conflicts with the anomaly DTM timer");
+#endif /* DTM_ANOMALY_172_ENABLED */
+#endif /* CONFIG_DTM_MEAS_TIMER */
+#if CONFIG_DTM_TX_STATS
+BUILD_ASSERT(NRFX_TIMER_CONFIG_LABEL(COUNTER_TIMER_INSTANCE) == 1,
+	     "Counter DTM timer needs additional KConfig configuration");
+BUILD_ASSERT((COUNTER_TIMER_INSTANCE != DEFAULT_TIMER_INSTANCE) &&
+	     (COUNTER_TIMER_INSTANCE != MEAS_TIMER_INSTANCE),
+	     "Counter DTM timer conflicts with another DTM timer");
+#if CONFIG_DTM_TRANSPORT_TWOWIRE
+BUILD_ASSERT(COUNTER_TIMER_INSTANCE != 1,
+	     "Counter DTM timer conflicts with the Two Wire transport timer");
+#endif /* CONFIG_DTM_TRANSPORT_TWOWIRE */
+#if CONFIG_FEM
+BUILD_ASSERT(COUNTER_TIMER_INSTANCE != 2,
+	     "Counter DTM timer conflicts with the front-end module timer");
+#endif /* CONFIG_FEM */
+#if DTM_ANOMALY_172_ENABLED
+BUILD_ASSERT(COUNTER_TIMER_INSTANCE != ANOMALY_172_TIMER_INSTANCE,
+	     "Counter DTM timer conflicts with the anomaly DTM timer");
+#endif /* DTM_ANOMALY_172_ENABLED */
+#endif /* CONFIG_DTM_TX_STATS */
 
 #define DTM_EGU       NRF_EGU0
 #define DTM_EGU_EVENT NRF_EGU_EVENT_TRIGGERED0
 #define DTM_EGU_TASK  NRF_EGU_TASK_TRIGGER0
 
+#if CONFIG_DTM_RADIO_ZLI
+/* EGU channel deferring the packet processing from the radio interrupt. */
+#define DTM_EGU_DEFER_EVENT NRF_EGU_EVENT_TRIGGERED1
+#define DTM_EGU_DEFER_TASK  NRF_EGU_TASK_TRIGGER1
+#define DTM_EGU_DEFER_INT   NRF_EGU_INT_TRIGGERED1
+
+#define DTM_EGU_IRQ_PRIORITY CONFIG_DTM_RADIO_DEFERRED_IRQ_PRIORITY
+#else
+#define DTM_EGU_IRQ_PRIORITY CONFIG_DTM_RADIO_IRQ_PRIORITY
+#endif /* CONFIG_DTM_RADIO_ZLI */
+
+#if DTM_ANOMALY_172_ENABLED
+/* EGU channels triggered with the anomaly 172 RSSI samples, one for the
+ * periodic check and one for the first check since the receiver was ready.
+ */
+#define DTM_EGU_ANOMALY_DEFAULT_EVENT NRF_EGU_EVENT_TRIGGERED2
+#define DTM_EGU_ANOMALY_DEFAULT_TASK  NRF_EGU_TASK_TRIGGER2
+#define DTM_EGU_ANOMALY_END_EVENT     NRF_EGU_EVENT_TRIGGERED3
+#define DTM_EGU_ANOMALY_END_TASK      NRF_EGU_TASK_TRIGGER3
+#define DTM_EGU_ANOMALY_INT           (NRF_EGU_INT_TRIGGERED2 | NRF_EGU_INT_TRIGGERED3)
+#endif /* DTM_ANOMALY_172_ENABLED */
+
+#if CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED
+#if defined(NRF52_SERIES)
+#define DTM_EGU_IRQn        SWI0_EGU0_IRQn
+#else
+#define DTM_EGU_IRQn        EGU0_IRQn
+#endif /* defined(NRF52_SERIES) */
+#endif /* CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED */
+
 /* Values that for now are "constants" - they could be configured by a function
  * setting them, but most of these are set by the BLE DTM standard, so changing
  * them is not relevant.
@@ -95,6 +201,10 @@ BUILD_ASSERT(NRFX_TIMER_CONFIG_LABEL(ANOMALY_172_TIMER_INSTANCE) == 1,
 #define BLOCKER_FIX_WAIT_DEFAULT 10
 /* Timeout of Anomaly timer (in us) */
 #define BLOCKER_FIX_WAIT_END 500
+/* Anomaly timer channel of the periodic RSSI check. */
+#define BLOCKER_FIX_CC_DEFAULT NRF_TIMER_CC_CHANNEL0
+/* Anomaly timer channel of the RSSI check after the receiver is ready. */
+#define BLOCKER_FIX_CC_END NRF_TIMER_CC_CHANNEL1
 /* Threshold used to determine necessary strict mode status changes. */
 #define BLOCKER_FIX_CNTDETECTTHR 15
 /* Threshold used to determine necessary strict mode status changes. */
@@ -124,6 +234,12 @@ BUILD_ASSERT(NRFX_TIMER_CONFIG_LABEL(ANOMALY_172_TIMER_INSTANCE) == 1,
 /* Maximum PDU size allowed during DTM execution. */
 #define DTM_PDU_MAX_MEMORY_SIZE \
 	(DTM_HEADER_WITH_CTE_SIZE + DTM_PAYLOAD_MAX_SIZE)
+/* Number of PDU buffers the receiver cycles through. */
+#if CONFIG_DTM_RX_HW_REARM || CONFIG_DTM_RADIO_ZLI
+#define DTM_PDU_COUNT            CONFIG_DTM_RX_PDU_COUNT
+#else
+#define DTM_PDU_COUNT            2
+#endif /* CONFIG_DTM_RX_HW_REARM || CONFIG_DTM_RADIO_ZLI */
 /* Size of the packet on air without the payload
  * (preamble + sync word + type + RFU + length + CRC).
  */
@@ -171,6 +287,11 @@ BUILD_ASSERT(NRFX_TIMER_CONFIG_LABEL(ANOMALY_172_TIMER_INSTANCE) == 1,
 
 #define FEM_USE_DEFAULT_GAIN 0xFF
 
+/* Range of the requested output power resolved through the power lookup table, in dBm. */
+#define POWER_LUT_MIN_DBM (-40)
+#define POWER_LUT_MAX_DBM 20
+#define POWER_LUT_SIZE (POWER_LUT_MAX_DBM - POWER_LUT_MIN_DBM + 1)
+
 /* Minimum supported CTE length in 8 us units. */
 #define CTE_LENGTH_MIN 0x02
 
@@ -205,6 +326,9 @@ enum dtm_state {
 
 	/* DTM Receive test is running */
 	STATE_RECEIVER_TEST,
+
+	/* RSSI sweep is running (Vendor specific test) */
+	STATE_RSSI_SWEEP,
 };
 
 /* Constant Tone Extension mode. */
@@ -337,6 +461,146 @@ struct fem_parameters {
 	uint32_t gain;
 };
 
+#if CONFIG_DTM_RX_TIMING
+/* Receiver packet timing state, times in measurement timer ticks. */
+struct rx_timing {
+	/* ADDRESS timestamp of the last packet with a valid CRC. */
+	uint32_t last_ts;
+
+	/* Payload length of the last packet with a valid CRC. */
+	uint8_t last_len;
+
+	/* Nominal packet interval, 0 until the first packet is received. */
+	uint32_t nominal;
+
+	/* Number of measured intervals. */
+	uint32_t intervals;
+
+	/* Number of missed packets. */
+	uint32_t missed;
+
+	/* Jitter extremes, sum and sum of squares. */
+	int32_t jitter_min;
+	int32_t jitter_max;
+	int64_t jitter_sum;
+	uint64_t jitter_sq_sum;
+
+	/* Longest ADDRESS to END time. */
+	uint32_t airtime_max;
+
+	/* Jitter histogram. */
+	uint32_t hist[DTM_RX_TIMING_HIST_BINS];
+};
+#endif /* CONFIG_DTM_RX_TIMING */
+
+/* Received packet captured in the radio interrupt, checked later. */
+struct rx_capture {
+	/* Buffer of the packet. */
+	struct dtm_pdu *pdu;
+
+#if CONFIG_DTM_RX_TIMING
+	/* ADDRESS and END event timestamps. */
+	uint32_t address_ts;
+	uint32_t end_ts;
+#endif /* CONFIG_DTM_RX_TIMING */
+
+	/* Channel the packet was received on. */
+	uint8_t channel;
+
+	/* RSSI sampled on the ADDRESS event. */
+	int8_t rssi;
+
+	/* CRC status of the packet. */
+	bool crc_ok;
+
+	/* The receiver scan moved to the next channel. */
+	bool hopped;
+
+	/* Restart the receiver once the packet is checked. */
+	bool restart;
+};
+
+/* Ring of the captured packets, written only by the radio interrupt and read
+ * only by the deferred processing. A capture owns its PDU buffer until it is
+ * read, so one entry stays free for the buffer the radio receives into.
+ */
+struct rx_ring {
+	struct rx_capture buf[DTM_PDU_COUNT];
+
+	/* Free-running write and read indexes. */
+	volatile uint32_t head;
+	volatile uint32_t tail;
+
+	/* Packets dropped because the ring was full or the receiver restarted
+	 * in hardware before the buffer was swapped.
+	 */
+	uint32_t overruns;
+};
+
+BUILD_ASSERT(IS_POWER_OF_TWO(DTM_PDU_COUNT),
+	     "The free-running ring indexes need a power of two buffers");
+
+#if CONFIG_DTM_RX_SCAN
+/* Receiver scan state. */
+struct rx_scan {
+	/* Scan in progress. */
+	bool active;
+
+	/* Hop after each received packet. */
+	bool hop_per_packet;
+
+	/* Dwell time elapsed, hop at the next END or DISABLED event. */
+	bool hop_pending;
+
+	/* Reception aborted by the radio interrupt for a pending hop. */
+	bool hop_disabling;
+
+	/* Time spent on a channel. */
+	k_timeout_t dwell;
+
+	/* Channels to scan and the index of the current channel. */
+	uint8_t channels[DTM_CHANNEL_COUNT];
+	uint8_t count;
+	uint8_t idx;
+
+	/* Statistics per channel. */
+	struct dtm_rx_scan_stat stats[DTM_CHANNEL_COUNT];
+
+	/* RSSI sums and sample counts per channel. */
+	int32_t rssi_sum[DTM_CHANNEL_COUNT];
+	uint32_t rssi_cnt[DTM_CHANNEL_COUNT];
+};
+#endif /* CONFIG_DTM_RX_SCAN */
+
+#if CONFIG_DTM_RSSI_SWEEP
+/* RSSI sweep state. */
+struct rssi_sweep {
+	/* Result of the sweep in progress or of the last sweep. */
+	struct dtm_rssi_sweep result;
+
+	/* Sweep end callback. */
+	dtm_rssi_sweep_callback_t cb;
+
+	/* Restart the sweep when it ends. */
+	bool repeat;
+
+	/* Current frequency step and sample. */
+	uint8_t step;
+	uint8_t sample;
+
+	/* RSSI sum and extremes of the current step. */
+	int32_t sum;
+	int8_t min;
+	int8_t max;
+
+	/* Cycle count at the start of the sweep. */
+	uint32_t start_cycles;
+
+	/* The sweep ended, to be reported in the deferred processing. */
+	volatile bool done;
+};
+#endif /* CONFIG_DTM_RSSI_SWEEP */
+
 /* DTM instance definition */
 static struct dtm_instance {
 	/* Current machine state. */
@@ -352,12 +616,15 @@ static struct dtm_instance {
 	uint32_t last_report_time;
 	uint32_t last_report_count;
 
-	/* RX/TX PDU. */
-	struct dtm_pdu pdu[2];
+	/* RX/TX PDU ring. */
+	struct dtm_pdu pdu[DTM_PDU_COUNT];
 
 	/* Current RX/TX PDU buffer. */
 	struct dtm_pdu *current_pdu;
 
+	/* Received packets waiting to be checked. */
+	struct rx_ring rx_ring;
+
 	/* Payload length of TX PDU, bits 2:7 of 16-bit dtm command. */
 	uint32_t packet_len;
 
@@ -376,13 +643,27 @@ static struct dtm_instance {
 	/* Timer to be used for scheduling TX packets. */
 	const nrfx_timer_t timer;
 
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 	/* Timer to be used to handle Anomaly 172. */
 	const nrfx_timer_t anomaly_timer;
 
 	/* Enable or disable the workaround for Errata 172. */
 	bool anomaly_172_wa_enabled;
-#endif /* NRF52_ERRATA_172_PRESENT */
+
+	/* Radio READY and ADDRESS to anomaly timer PPI channels. */
+	uint8_t ppi_anomaly_ready;
+	uint8_t ppi_anomaly_address;
+
+	/* Anomaly timer compare to radio RSSISTART and EGU PPI channels. */
+	uint8_t ppi_anomaly_rssi_default;
+	uint8_t ppi_anomaly_rssi_end;
+	uint8_t ppi_anomaly_egu_end;
+
+	/* Group of the BLOCKER_FIX_CC_END channels. The first compare since the
+	 * receiver was ready disables it, the ADDRESS event enables it again.
+	 */
+	nrfx_gppi_channel_group_t ppi_anomaly_end_group;
+#endif /* DTM_ANOMALY_172_ENABLED */
 
 	/* Enable or disable strict mode to workaround Errata 172. */
 	bool strict_mode;
@@ -393,6 +674,14 @@ static struct dtm_instance {
 	/* Radio output power. */
 	nrf_radio_txpower_t txpower;
 
+#if !CONFIG_DTM_POWER_CONTROL_AUTOMATIC
+	/* Calibration offsets of the radio output power levels, in 0.25 dB. */
+	int8_t power_cal[DTM_TX_POWER_CAL_MAX];
+#endif /* !CONFIG_DTM_POWER_CONTROL_AUTOMATIC */
+
+	/* Output power flatness compensation of each channel, in 0.25 dB. */
+	int8_t power_comp[DTM_CHANNEL_COUNT];
+
 	/* Constant Tone Extension configuration. */
 	struct dtm_cte_info cte_info;
 
@@ -401,19 +690,137 @@ static struct dtm_instance {
 
 	/* Radio Enable PPI channel. */
 	uint8_t ppi_radio_start;
+
+#if CONFIG_DTM_RX_HW_REARM
+	/* The receiver is restarted in hardware after each packet. */
+	bool rx_hw_rearm;
+
+#if CONFIG_FEM
+	/* Radio DISABLED to EGU PPI channel restarting the receiver. */
+	uint8_t ppi_rx_rearm;
+#endif /* CONFIG_FEM */
+#endif /* CONFIG_DTM_RX_HW_REARM */
+
+#if CONFIG_DTM_MEAS_TIMER
+	/* Timer capturing the packet timestamps. */
+	const nrfx_timer_t meas_timer;
+
+	/* Radio ADDRESS and END event capture PPI channels. */
+	uint8_t ppi_meas_address;
+	uint8_t ppi_meas_end;
+#endif /* CONFIG_DTM_MEAS_TIMER */
+
+#if CONFIG_DTM_RX_TIMING
+	/* Receiver packet timing state. */
+	struct rx_timing rx_timing;
+#endif /* CONFIG_DTM_RX_TIMING */
+
+#if CONFIG_DTM_RX_SCAN
+	/* Receiver scan state. */
+	struct rx_scan rx_scan;
+#endif /* CONFIG_DTM_RX_SCAN */
+
+#if CONFIG_DTM_RSSI_SWEEP
+	/* RSSI sweep state. */
+	struct rssi_sweep rssi_sweep;
+#endif /* CONFIG_DTM_RSSI_SWEEP */
+
+#if CONFIG_DTM_TX_STATS
+	/* Timer counting the transmitted packets. */
+	const nrfx_timer_t counter_timer;
+
+	/* First packet timestamp PPI channel. */
+	uint8_t ppi_tx_first;
+
+	/* Uptime at the start of the transmitter test, in milliseconds. */
+	int64_t tx_start_time;
+
+	/* Statistics of the last transmitter test. */
+	struct dtm_tx_stats tx_stats;
+#endif /* CONFIG_DTM_TX_STATS */
+
+#if CONFIG_DTM_TX_BURST
+	/* Burst stop PPI channel. */
+	uint8_t ppi_tx_burst;
+
+	/* Number of packets of the transmitter burst, 0 if not a burst. */
+	uint32_t burst_count;
+
+	/* Transmitter burst end callback. */
+	dtm_burst_done_callback_t burst_cb;
+#endif /* CONFIG_DTM_TX_BURST */
+
+	/* High frequency clock manager. */
+	struct onoff_manager *clk_mgr;
+
+	/* High frequency clock request. */
+	struct onoff_client clk_cli;
+
+	/* High frequency clock requested by DTM. */
+	bool clk_requested;
 } dtm_inst = {
 	.state = STATE_UNINITIALIZED,
 	.packet_hdr_plen = NRF_RADIO_PREAMBLE_LENGTH_8BIT,
 	.address = DTM_RADIO_ADDRESS,
 	.timer = NRFX_TIMER_INSTANCE(DEFAULT_TIMER_INSTANCE),
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 	.anomaly_timer = NRFX_TIMER_INSTANCE(ANOMALY_172_TIMER_INSTANCE),
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
+#if CONFIG_DTM_MEAS_TIMER
+	.meas_timer = NRFX_TIMER_INSTANCE(MEAS_TIMER_INSTANCE),
+#endif /* CONFIG_DTM_MEAS_TIMER */
+#if CONFIG_DTM_TX_STATS
+	.counter_timer = NRFX_TIMER_INSTANCE(COUNTER_TIMER_INSTANCE),
+#endif /* CONFIG_DTM_TX_STATS */
 	.radio_mode = NRF_RADIO_MODE_BLE_1MBIT,
 	.txpower = NRF_RADIO_TXPOWER_0DBM,
 	.fem.gain = FEM_USE_DEFAULT_GAIN,
 };
 
+/* Telemetry state of each DTM state. */
+static const uint8_t telemetry_states[] = {
+	[STATE_UNINITIALIZED] = DTM_TELEMETRY_STATE_UNINITIALIZED,
+	[STATE_IDLE] = DTM_TELEMETRY_STATE_IDLE,
+	[STATE_TRANSMITTER_TEST] = DTM_TELEMETRY_STATE_TX,
+	[STATE_CARRIER_TEST] = DTM_TELEMETRY_STATE_CARRIER,
+	[STATE_RECEIVER_TEST] = DTM_TELEMETRY_STATE_RX,
+	[STATE_RSSI_SWEEP] = DTM_TELEMETRY_STATE_RSSI_SWEEP,
+};
+
+/* Change the machine state, reported in the telemetry block. */
+static void state_set(enum dtm_state state)
+{
+	dtm_inst.state = state;
+	dtm_telemetry_state_set(telemetry_states[state], dtm_inst.phys_ch);
+}
+
+/* Check if the Constant Tone Extension is used in the current test.
+ * Evaluates to a constant false when the DTM profile excludes CTE support.
+ */
+static inline bool cte_active(void)
+{
+#if DTM_CTE_ENABLED
+	return dtm_inst.cte_info.mode != DTM_CTE_MODE_OFF;
+#else
+	return false;
+#endif /* DTM_CTE_ENABLED */
+}
+
+/* Check if the radio mode is one of the LE Coded PHY modes.
+ * Evaluates to a constant false when the DTM profile excludes LE Coded PHY support.
+ */
+static inline bool radio_mode_coded(nrf_radio_mode_t mode)
+{
+#if DTM_CODED_PHY_ENABLED
+	return (mode == NRF_RADIO_MODE_BLE_LR125KBIT) ||
+	       (mode == NRF_RADIO_MODE_BLE_LR500KBIT);
+#else
+	ARG_UNUSED(mode);
+
+	return false;
+#endif /* DTM_CODED_PHY_ENABLED */
+}
+
 /* The PRBS9 sequence used as packet payload.
  * The bytes in the sequence is in the right order, but the bits of each byte
  * in the array is reverse of that found by running the PRBS9 algorithm.
@@ -493,8 +900,8 @@ static const struct dtm_supp_features supported_features = {
 	.data_len_ext = true,
 	.phy_2m = true,
 	.stable_mod = false,
-	.coded_phy = IS_ENABLED(CONFIG_HAS_HW_NRF_RADIO_BLE_CODED),
-#if DIRECTION_FINDING_SUPPORTED
+	.coded_phy = DTM_CODED_PHY_ENABLED,
+#if DTM_CTE_ENABLED
 	.cte = true,
 	.ant_switching = true,
 	.aod_1us_tx = true,
@@ -506,10 +913,10 @@ static const struct dtm_supp_features supported_features = {
 	.aod_1us_tx = false,
 	.aod_1us_rx = false,
 	.aoa_1us_rx = false,
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED */
 };
 
-#if DIRECTION_FINDING_SUPPORTED
+#if DTM_CTE_ENABLED
 
 static void radio_gpio_pattern_clear(void)
 {
@@ -601,45 +1008,124 @@ static void radio_cte_prepare(bool rx)
 		NRF_RADIO->DFECTRL1 |= dtm_inst.cte_info.time;
 	}
 }
-#endif /* DIRECTION_FINDING_SUPPORTED */
-
-#if NRF52_ERRATA_172_PRESENT
-static void anomaly_timer_handler(nrf_timer_event_t event_type, void *context);
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_CTE_ENABLED */
 
 static void dtm_timer_handler(nrf_timer_event_t event_type, void *context);
+#if CONFIG_DTM_TX_BURST
+static void counter_timer_handler(nrf_timer_event_t event_type, void *context);
+#endif /* CONFIG_DTM_TX_BURST */
 static void radio_handler(const void *context);
-
-static int clock_init(void)
+static void radio_deferred_handler(const void *context);
+#if CONFIG_DTM_RADIO_ZLI
+void radio_zli_handler(void);
+#endif /* CONFIG_DTM_RADIO_ZLI */
+#if CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED
+static void egu_handler(const void *context);
+#endif /* CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED */
+static void radio_start(bool rx, bool force_egu);
+static void radio_defer(void);
+
+/* Request the high frequency clock. The request completes in the background
+ * unless wait is set, so the crystal start-up can overlap the test setup.
+ */
+static int hfclk_request(bool wait)
 {
 	int err;
 	int res;
-	struct onoff_manager *clk_mgr;
-	struct onoff_client clk_cli;
 
-	clk_mgr = z_nrf_clock_control_get_onoff(CLOCK_CONTROL_NRF_SUBSYS_HF);
-	if (!clk_mgr) {
-		printk("Unable to get the Clock manager\n");
-		return -ENXIO;
-	}
+	if (!dtm_inst.clk_requested) {
+		sys_notify_init_spinwait(&dtm_inst.clk_cli.notify);
+
+		err = onoff_request(dtm_inst.clk_mgr, &dtm_inst.clk_cli);
+		if (err < 0) {
+			LOG_ERR("Clock request failed: %d", err);
+			return err;
+		}
 
-	sys_notify_init_spinwait(&clk_cli.notify);
+		dtm_inst.clk_requested = true;
+	}
 
-	err = onoff_request(clk_mgr, &clk_cli);
-	if (err < 0) {
-		printk("Clock request failed: %d\n", err);
-		return err;
+	if (!wait) {
+		return 0;
 	}
 
 	do {
-		err = sys_notify_fetch_result(&clk_cli.notify, &res);
+		err = sys_notify_fetch_result(&dtm_inst.clk_cli.notify, &res);
 		if (!err && res) {
-			printk("Clock could not be started: %d\n", res);
+			LOG_ERR("Clock could not be started: %d", res);
+			dtm_inst.clk_requested = false;
 			return res;
 		}
 	} while (err);
 
-	return err;
+	return 0;
+}
+
+#if CONFIG_DTM_HFCLK_IDLE_RELEASE
+static int hfclk_release(void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if ((dtm_inst.state == STATE_IDLE) && dtm_inst.clk_requested) {
+		(void)onoff_cancel_or_release(dtm_inst.clk_mgr, &dtm_inst.clk_cli);
+		dtm_inst.clk_requested = false;
+	}
+
+	return 0;
+}
+
+static void hfclk_release_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	/* The DTM state only changes in the executor, check it there. */
+	(void)dtm_exec_call(DTM_EXEC_CLIENT_MAIN, hfclk_release, NULL);
+}
+
+static K_WORK_DELAYABLE_DEFINE(hfclk_release_work, hfclk_release_work_handler);
+#endif /* CONFIG_DTM_HFCLK_IDLE_RELEASE */
+
+/* Release the high frequency clock once DTM stays idle. The release is
+ * delayed, so back-to-back tests do not restart the crystal.
+ */
+static void hfclk_idle(void)
+{
+#if CONFIG_DTM_HFCLK_IDLE_RELEASE
+	k_work_reschedule(&hfclk_release_work, K_MSEC(CONFIG_DTM_HFCLK_RELEASE_DELAY_MS));
+#endif /* CONFIG_DTM_HFCLK_IDLE_RELEASE */
+}
+
+/* Make sure the high frequency clock is running before a test starts. */
+static int hfclk_test_start(void)
+{
+#if CONFIG_DTM_HFCLK_IDLE_RELEASE && CONFIG_DTM_EXEC
+	/* A release already submitted to the executor runs after this command
+	 * and finds the test running. Waiting for it would block the executor.
+	 */
+	(void)k_work_cancel_delayable(&hfclk_release_work);
+#elif CONFIG_DTM_HFCLK_IDLE_RELEASE
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_delayable_sync(&hfclk_release_work, &sync);
+#endif /* CONFIG_DTM_HFCLK_IDLE_RELEASE && CONFIG_DTM_EXEC */
+
+	return hfclk_request(true);
+}
+
+static int clock_init(void)
+{
+	dtm_inst.clk_mgr = z_nrf_clock_control_get_onoff(CLOCK_CONTROL_NRF_SUBSYS_HF);
+	if (!dtm_inst.clk_mgr) {
+		printk("Unable to get the Clock manager\n");
+		return -ENXIO;
+	}
+
+	/* Without the idle release, the clock runs from the start. */
+	if (!IS_ENABLED(CONFIG_DTM_HFCLK_IDLE_RELEASE)) {
+		return hfclk_request(true);
+	}
+
+	return 0;
 }
 
 static int timer_init(void)
@@ -663,7 +1149,7 @@ static int timer_init(void)
 	return 0;
 }
 
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 static int anomaly_timer_init(void)
 {
 	nrfx_err_t err;
@@ -673,106 +1159,231 @@ static int anomaly_timer_init(void)
 		.bit_width = NRF_TIMER_BIT_WIDTH_16,
 	};
 
+	/* The timer only drives the RSSI sampling through (D)PPI, its
+	 * interrupts are not used.
+	 */
 	err = nrfx_timer_init(&dtm_inst.anomaly_timer, &timer_cfg,
-			      anomaly_timer_handler);
+			      dtm_timer_handler);
 	if (err != NRFX_SUCCESS) {
 		printk("nrfx_timer_init failed with: %d\n", err);
 		return -EAGAIN;
 	}
 
-	IRQ_CONNECT(ANOMALY_172_TIMER_IRQ,
-		    CONFIG_ANOMALY_172_TIMER_IRQ_PRIORITY,
-		    ANOMALY_172_TIMER_IRQ_HANDLER,
-		    NULL, 0);
-
-	nrfx_timer_compare(&dtm_inst.anomaly_timer,
-		NRF_TIMER_CC_CHANNEL0,
-		nrfx_timer_ms_to_ticks(&dtm_inst.anomaly_timer,
-				       BLOCKER_FIX_WAIT_DEFAULT),
-		true);
-
 	return 0;
 }
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
 
-static int gppi_init(void)
+#if CONFIG_DTM_MEAS_TIMER
+static int meas_timer_init(void)
 {
 	nrfx_err_t err;
+	nrfx_timer_config_t timer_cfg = {
+		.frequency = NRFX_MHZ_TO_HZ(MEAS_TIMER_TICKS_PER_US),
+		.mode = NRF_TIMER_MODE_TIMER,
+		.bit_width = NRF_TIMER_BIT_WIDTH_32,
+	};
 
-	err = nrfx_gppi_channel_alloc(&dtm_inst.ppi_radio_start);
+	/* The timer only captures timestamps, no interrupts are used. */
+	err = nrfx_timer_init(&dtm_inst.meas_timer, &timer_cfg, NULL);
 	if (err != NRFX_SUCCESS) {
-		printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+		printk("nrfx_timer_init failed with: %d\n", err);
 		return -EAGAIN;
 	}
 
 	return 0;
 }
+#endif /* CONFIG_DTM_MEAS_TIMER */
 
-#if CONFIG_DTM_POWER_CONTROL_AUTOMATIC
-static int8_t dtm_radio_min_power_get(uint16_t frequency)
+#if CONFIG_DTM_TX_STATS
+static int counter_timer_init(void)
 {
-	return fem_tx_output_power_min_get(frequency);
-}
+	nrfx_err_t err;
+	nrfx_timer_config_t timer_cfg = {
+		.frequency = NRFX_MHZ_TO_HZ(1),
+		.mode = NRF_TIMER_MODE_COUNTER,
+		.bit_width = NRF_TIMER_BIT_WIDTH_32,
+	};
 
-static int8_t dtm_radio_max_power_get(uint16_t frequency)
-{
-	return fem_tx_output_power_max_get(frequency);
-}
+#if CONFIG_DTM_TX_BURST
+	err = nrfx_timer_init(&dtm_inst.counter_timer, &timer_cfg, counter_timer_handler);
+#else
+	err = nrfx_timer_init(&dtm_inst.counter_timer, &timer_cfg, NULL);
+#endif /* CONFIG_DTM_TX_BURST */
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_timer_init failed with: %d\n", err);
+		return -EAGAIN;
+	}
 
-static int8_t dtm_radio_nearest_power_get(int8_t tx_power, uint16_t frequency)
-{
-	int8_t tx_power_floor = fem_tx_output_power_check(tx_power, frequency, false);
-	int8_t tx_power_ceiling = fem_tx_output_power_check(tx_power, frequency, true);
-	int8_t output_power;
+#if CONFIG_DTM_TX_BURST
+	IRQ_CONNECT(COUNTER_TIMER_IRQ, CONFIG_DTM_TIMER_IRQ_PRIORITY,
+		    COUNTER_TIMER_IRQ_HANDLER, NULL, 0);
+#endif /* CONFIG_DTM_TX_BURST */
 
-	output_power = (abs(tx_power_floor - tx_power) > abs(tx_power_ceiling - tx_power)) ?
-		       tx_power_ceiling : tx_power_floor;
+	/* The first packet generates the COMPARE event. */
+	nrf_timer_cc_set(dtm_inst.counter_timer.p_reg, COUNTER_CC_FIRST, 1);
 
-	return output_power;
+	return 0;
 }
+#endif /* CONFIG_DTM_TX_STATS */
 
-#else
-static int8_t dtm_radio_min_power_get(uint16_t frequency)
+static int gppi_init(void)
 {
-	ARG_UNUSED(frequency);
+	nrfx_err_t err;
 
-	return dtm_hw_radio_min_power_get();
-}
+	err = nrfx_gppi_channel_alloc(&dtm_inst.ppi_radio_start);
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+		return -EAGAIN;
+	}
 
-static int8_t dtm_radio_max_power_get(uint16_t frequency)
-{
-	ARG_UNUSED(frequency);
+#if CONFIG_DTM_MEAS_TIMER
+	err = nrfx_gppi_channel_alloc(&dtm_inst.ppi_meas_address);
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+		return -EAGAIN;
+	}
 
-	return dtm_hw_radio_max_power_get();
-}
+	err = nrfx_gppi_channel_alloc(&dtm_inst.ppi_meas_end);
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+		return -EAGAIN;
+	}
 
-static int8_t dtm_radio_nearest_power_get(int8_t tx_power, uint16_t frequency)
-{
-	int8_t output_power = INT8_MAX;
-	const size_t size = dtm_hw_radio_power_array_size_get();
-	const uint32_t *power = dtm_hw_radio_power_array_get();
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_meas_address,
+		nrf_radio_event_address_get(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS),
+		nrf_timer_task_address_get(dtm_inst.meas_timer.p_reg,
+					   nrf_timer_capture_task_get(MEAS_TIMER_CC_ADDRESS)));
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_meas_end,
+		nrf_radio_event_address_get(NRF_RADIO, NRF_RADIO_EVENT_END),
+		nrf_timer_task_address_get(dtm_inst.meas_timer.p_reg,
+					   nrf_timer_capture_task_get(MEAS_TIMER_CC_END)));
+#endif /* CONFIG_DTM_MEAS_TIMER */
+
+#if CONFIG_DTM_TX_STATS
+	err = nrfx_gppi_channel_alloc(&dtm_inst.ppi_tx_first);
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+		return -EAGAIN;
+	}
 
-	ARG_UNUSED(frequency);
+	/* The counter only runs in the transmitter test. */
+	nrfx_gppi_fork_endpoint_setup(dtm_inst.ppi_meas_end,
+		nrf_timer_task_address_get(dtm_inst.counter_timer.p_reg, NRF_TIMER_TASK_COUNT));
 
-	for (size_t i = 1; i < size; i++) {
-		if (((int8_t) power[i]) > tx_power) {
-			int8_t diff = abs((int8_t) power[i] - tx_power);
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_tx_first,
+		nrf_timer_event_address_get(dtm_inst.counter_timer.p_reg,
+					    nrf_timer_compare_event_get(COUNTER_CC_FIRST)),
+		nrf_timer_task_address_get(dtm_inst.meas_timer.p_reg,
+					   nrf_timer_capture_task_get(MEAS_TIMER_CC_FIRST_END)));
+#endif /* CONFIG_DTM_TX_STATS */
+
+#if CONFIG_DTM_TX_BURST
+	err = nrfx_gppi_channel_alloc(&dtm_inst.ppi_tx_burst);
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+		return -EAGAIN;
+	}
 
-			if (diff <  abs((int8_t) power[i - 1] - tx_power)) {
-				output_power = power[i];
-			} else {
-				output_power = power[i - 1];
-			}
+	/* The last packet of a burst stops the timer triggering the transmission. */
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_tx_burst,
+		nrf_timer_event_address_get(dtm_inst.counter_timer.p_reg,
+					    nrf_timer_compare_event_get(COUNTER_CC_BURST)),
+		nrf_timer_task_address_get(dtm_inst.timer.p_reg, NRF_TIMER_TASK_STOP));
+#endif /* CONFIG_DTM_TX_BURST */
+
+#if DTM_ANOMALY_172_ENABLED
+	uint8_t *anomaly_ppi[] = {
+		&dtm_inst.ppi_anomaly_ready,
+		&dtm_inst.ppi_anomaly_address,
+		&dtm_inst.ppi_anomaly_rssi_default,
+		&dtm_inst.ppi_anomaly_rssi_end,
+		&dtm_inst.ppi_anomaly_egu_end,
+	};
 
-			break;
+	for (size_t i = 0; i < ARRAY_SIZE(anomaly_ppi); i++) {
+		err = nrfx_gppi_channel_alloc(anomaly_ppi[i]);
+		if (err != NRFX_SUCCESS) {
+			printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+			return -EAGAIN;
 		}
 	}
 
-	__ASSERT_NO_MSG(output_power != INT8_MAX);
+	err = nrfx_gppi_group_alloc(&dtm_inst.ppi_anomaly_end_group);
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_gppi_group_alloc failed with: %d\n", err);
+		return -EAGAIN;
+	}
 
-	return output_power;
+	/* The timer runs while the receiver waits for a packet. The ADDRESS
+	 * event also arms the check after the next READY event.
+	 */
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_anomaly_ready,
+		nrf_radio_event_address_get(NRF_RADIO, NRF_RADIO_EVENT_READY),
+		nrf_timer_task_address_get(dtm_inst.anomaly_timer.p_reg, NRF_TIMER_TASK_CLEAR));
+	nrfx_gppi_fork_endpoint_setup(dtm_inst.ppi_anomaly_ready,
+		nrf_timer_task_address_get(dtm_inst.anomaly_timer.p_reg, NRF_TIMER_TASK_START));
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_anomaly_address,
+		nrf_radio_event_address_get(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS),
+		nrf_timer_task_address_get(dtm_inst.anomaly_timer.p_reg, NRF_TIMER_TASK_STOP));
+	nrfx_gppi_fork_endpoint_setup(dtm_inst.ppi_anomaly_address,
+		nrfx_gppi_task_address_get(
+			nrfx_gppi_group_enable_task_get(dtm_inst.ppi_anomaly_end_group)));
+
+	/* The compare events start the RSSI samples and trigger the EGU
+	 * interrupt reading them.
+	 */
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_anomaly_rssi_default,
+		nrf_timer_event_address_get(dtm_inst.anomaly_timer.p_reg,
+					    nrf_timer_compare_event_get(BLOCKER_FIX_CC_DEFAULT)),
+		nrf_radio_task_address_get(NRF_RADIO, NRF_RADIO_TASK_RSSISTART));
+	nrfx_gppi_fork_endpoint_setup(dtm_inst.ppi_anomaly_rssi_default,
+		nrf_egu_task_address_get(DTM_EGU, DTM_EGU_ANOMALY_DEFAULT_TASK));
+
+	/* The end compare also matches after each periodic check, which clears
+	 * the timer. Only its first match since the receiver was ready is used:
+	 * the channels disable their own group.
+	 */
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_anomaly_rssi_end,
+		nrf_timer_event_address_get(dtm_inst.anomaly_timer.p_reg,
+					    nrf_timer_compare_event_get(BLOCKER_FIX_CC_END)),
+		nrf_radio_task_address_get(NRF_RADIO, NRF_RADIO_TASK_RSSISTART));
+	nrfx_gppi_fork_endpoint_setup(dtm_inst.ppi_anomaly_rssi_end,
+		nrfx_gppi_task_address_get(
+			nrfx_gppi_group_disable_task_get(dtm_inst.ppi_anomaly_end_group)));
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_anomaly_egu_end,
+		nrf_timer_event_address_get(dtm_inst.anomaly_timer.p_reg,
+					    nrf_timer_compare_event_get(BLOCKER_FIX_CC_END)),
+		nrf_egu_task_address_get(DTM_EGU, DTM_EGU_ANOMALY_END_TASK));
+	nrfx_gppi_channels_include_in_group(BIT(dtm_inst.ppi_anomaly_rssi_end) |
+					    BIT(dtm_inst.ppi_anomaly_egu_end),
+					    dtm_inst.ppi_anomaly_end_group);
+#endif /* DTM_ANOMALY_172_ENABLED */
+
+#if CONFIG_DTM_RX_HW_REARM && CONFIG_FEM
+	err = nrfx_gppi_channel_alloc(&dtm_inst.ppi_rx_rearm);
+	if (err != NRFX_SUCCESS) {
+		printk("nrfx_gppi_channel_alloc failed with: %d\n", err);
+		return -EAGAIN;
+	}
+
+	/* The EGU starts the receiver and the FEM timer, as in radio_start(). */
+	nrfx_gppi_channel_endpoints_setup(
+		dtm_inst.ppi_rx_rearm,
+		nrf_radio_event_address_get(NRF_RADIO, NRF_RADIO_EVENT_DISABLED),
+		nrf_egu_task_address_get(DTM_EGU, DTM_EGU_TASK));
+#endif /* CONFIG_DTM_RX_HW_REARM && CONFIG_FEM */
+
+	return 0;
 }
-#endif /* CONFIG_DTM_POWER_CONTROL_AUTOMATIC */
 
 static uint16_t radio_frequency_get(uint8_t channel)
 {
@@ -784,9 +1395,174 @@ static uint16_t radio_frequency_get(uint8_t channel)
 	return (channel << 1) + base_frequency;
 }
 
-static void radio_tx_power_set(uint8_t channel, int8_t tx_power)
+#if CONFIG_DTM_POWER_CONTROL_AUTOMATIC
+/* Nearest output power of each channel and requested power. */
+static int8_t power_lut[DTM_CHANNEL_COUNT][POWER_LUT_SIZE];
+
+/* Flatness compensation of each channel, in steps of the lookup table. */
+static int8_t power_comp_shift[DTM_CHANNEL_COUNT];
+#else
+/* Radio output power level resolved for each requested power. */
+static int8_t power_lut[POWER_LUT_SIZE];
+
+/* Radio output power level of each channel and set level, with the flatness
+ * compensation of the channel.
+ */
+static int8_t power_ch_lut[DTM_CHANNEL_COUNT][POWER_LUT_SIZE];
+#endif /* CONFIG_DTM_POWER_CONTROL_AUTOMATIC */
+
+#if CONFIG_DTM_POWER_CONTROL_AUTOMATIC
+static int8_t dtm_radio_min_power_get(uint16_t frequency)
+{
+	return fem_tx_output_power_min_get(frequency);
+}
+
+static int8_t dtm_radio_max_power_get(uint16_t frequency)
+{
+	return fem_tx_output_power_max_get(frequency);
+}
+
+static int8_t dtm_radio_nearest_power_get(int8_t tx_power, uint16_t frequency)
+{
+	int8_t tx_power_floor = fem_tx_output_power_check(tx_power, frequency, false);
+	int8_t tx_power_ceiling = fem_tx_output_power_check(tx_power, frequency, true);
+	int8_t output_power;
+
+	output_power = (abs(tx_power_floor - tx_power) > abs(tx_power_ceiling - tx_power)) ?
+		       tx_power_ceiling : tx_power_floor;
+
+	return output_power;
+}
+
+/* Resolve the nearest output power of each channel and requested power. */
+static void power_lut_build(void)
+{
+	for (uint8_t ch = 0; ch < DTM_CHANNEL_COUNT; ch++) {
+		uint16_t frequency = radio_frequency_get(ch);
+		int8_t min = dtm_radio_min_power_get(frequency);
+		int8_t max = dtm_radio_max_power_get(frequency);
+
+		for (int i = 0; i < POWER_LUT_SIZE; i++) {
+			int8_t tx_power = POWER_LUT_MIN_DBM + i;
+
+			if (tx_power <= min) {
+				power_lut[ch][i] = min;
+			} else if (tx_power >= max) {
+				power_lut[ch][i] = max;
+			} else {
+				power_lut[ch][i] = dtm_radio_nearest_power_get(tx_power, frequency);
+			}
+		}
+
+		power_comp_shift[ch] = DIV_ROUND_CLOSEST(dtm_inst.power_comp[ch], 4);
+	}
+}
+
+static int8_t power_lut_get(int tx_power, uint8_t channel)
+{
+	return power_lut[channel][CLAMP(tx_power, POWER_LUT_MIN_DBM, POWER_LUT_MAX_DBM) -
+				  POWER_LUT_MIN_DBM];
+}
+
+/* Output power of the channel with its flatness compensation. */
+static int8_t power_ch_get(int8_t tx_power, uint8_t channel)
+{
+	return power_lut_get(tx_power + power_comp_shift[channel], channel);
+}
+
+#else
+static int8_t dtm_radio_min_power_get(uint16_t frequency)
+{
+	ARG_UNUSED(frequency);
+
+	return dtm_hw_radio_min_power_get();
+}
+
+static int8_t dtm_radio_max_power_get(uint16_t frequency)
+{
+	ARG_UNUSED(frequency);
+
+	return dtm_hw_radio_max_power_get();
+}
+
+/* Find the radio output power level with the calibrated output nearest to the
+ * target, in 0.25 dBm. On a tie, the preferred level or else the lower level is used.
+ */
+static int8_t power_level_nearest(const int16_t *out, int32_t target, int8_t preferred)
+{
+	const size_t size = dtm_hw_radio_power_array_size_get();
+	const uint32_t *power = dtm_hw_radio_power_array_get();
+	int32_t best = INT32_MAX;
+	int8_t level = power[0];
+
+	for (size_t j = 0; j < size; j++) {
+		int32_t diff = abs(out[j] - target);
+
+		if ((diff < best) || ((diff == best) && ((int8_t)power[j] == preferred))) {
+			best = diff;
+			level = power[j];
+		}
+	}
+
+	return level;
+}
+
+static void power_lut_build(void)
+{
+	const size_t size = dtm_hw_radio_power_array_size_get();
+	const uint32_t *power = dtm_hw_radio_power_array_get();
+	int16_t out[DTM_TX_POWER_CAL_MAX];
+
+	__ASSERT_NO_MSG(size <= DTM_TX_POWER_CAL_MAX);
+
+	/* Calibrated output power of each level, in 0.25 dBm. */
+	for (size_t j = 0; j < size; j++) {
+		out[j] = ((int8_t)power[j] * 4) + dtm_inst.power_cal[j];
+	}
+
+	for (int i = 0; i < POWER_LUT_SIZE; i++) {
+		int8_t tx_power = POWER_LUT_MIN_DBM + i;
+		int32_t base = tx_power * 4;
+
+		power_lut[i] = power_level_nearest(out, base, INT8_MIN);
+
+		/* A set level starts from its calibrated output. */
+		for (size_t j = 0; j < size; j++) {
+			if ((int8_t)power[j] == tx_power) {
+				base = out[j];
+			}
+		}
+
+		/* Without compensation, a level resolves to itself. */
+		for (uint8_t ch = 0; ch < DTM_CHANNEL_COUNT; ch++) {
+			power_ch_lut[ch][i] = power_level_nearest(out, base + dtm_inst.power_comp[ch],
+								  tx_power);
+		}
+	}
+}
+
+static int8_t power_lut_get(int tx_power, uint8_t channel)
+{
+	ARG_UNUSED(channel);
+
+	return power_lut[CLAMP(tx_power, POWER_LUT_MIN_DBM, POWER_LUT_MAX_DBM) -
+			 POWER_LUT_MIN_DBM];
+}
+
+/* Radio output power level of the channel with its flatness compensation. */
+static int8_t power_ch_get(int8_t tx_power, uint8_t channel)
+{
+	return power_ch_lut[channel][CLAMP(tx_power, POWER_LUT_MIN_DBM, POWER_LUT_MAX_DBM) -
+				     POWER_LUT_MIN_DBM];
+}
+#endif /* CONFIG_DTM_POWER_CONTROL_AUTOMATIC */
+
+static void radio_tx_power_set(uint8_t channel, int8_t tx_power)
 {
-	int8_t radio_power = tx_power;
+	/* The flatness compensation of the channel is part of the lookup,
+	 * TXPOWER remains the only register written.
+	 */
+	int8_t radio_power = power_ch_get(tx_power, channel);
 
 #if CONFIG_FEM
 	uint16_t frequency;
@@ -799,11 +1575,9 @@ static void radio_tx_power_set(uint8_t channel, int8_t tx_power)
 		 * Tx output power level for channel 0. That is why output Tx power needs to be
 		 * aligned for final transmission channel.
 		 */
-		tx_power = dtm_radio_nearest_power_get(tx_power, frequency);
+		tx_power = radio_power;
 		(void)fem_tx_output_power_prepare(tx_power, &radio_power, frequency);
 	}
-#else
-	ARG_UNUSED(channel);
 #endif /* CONFIG_FEM */
 
 #ifdef NRF53_SERIES
@@ -835,7 +1609,9 @@ static void radio_reset(void)
 	nrf_radio_int_disable(NRF_RADIO,
 			NRF_RADIO_INT_READY_MASK |
 			NRF_RADIO_INT_ADDRESS_MASK |
-			NRF_RADIO_INT_END_MASK);
+			NRF_RADIO_INT_RSSIEND_MASK |
+			NRF_RADIO_INT_END_MASK |
+			NRF_RADIO_INT_DISABLED_MASK);
 
 	dtm_inst.rx_pkt_count = 0;
 }
@@ -881,8 +1657,7 @@ static int radio_init(void)
 	packet_conf.statlen = PACKET_STATIC_LEN;
 	packet_conf.maxlen = DTM_PAYLOAD_MAX_SIZE;
 
-	if (dtm_inst.radio_mode != NRF_RADIO_MODE_BLE_1MBIT &&
-	    dtm_inst.radio_mode != NRF_RADIO_MODE_BLE_2MBIT) {
+	if (radio_mode_coded(dtm_inst.radio_mode)) {
 		/* Coded PHY (Long range) */
 #if defined(RADIO_PCNF0_TERMLEN_Msk)
 		packet_conf.termlen = 3;
@@ -912,7 +1687,7 @@ int dtm_init(dtm_iq_report_callback_t callback)
 		return err;
 	}
 
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 	/* Enable the timer used by nRF52840 anomaly 172 if running on an
 	 * affected device.
 	 */
@@ -920,7 +1695,21 @@ int dtm_init(dtm_iq_report_callback_t callback)
 	if (err) {
 		return err;
 	}
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
+
+#if CONFIG_DTM_MEAS_TIMER
+	err = meas_timer_init();
+	if (err) {
+		return err;
+	}
+#endif /* CONFIG_DTM_MEAS_TIMER */
+
+#if CONFIG_DTM_TX_STATS
+	err = counter_timer_init();
+	if (err) {
+		return err;
+	}
+#endif /* CONFIG_DTM_TX_STATS */
 
 	err = gppi_init();
 	if (err) {
@@ -942,25 +1731,45 @@ int dtm_init(dtm_iq_report_callback_t callback)
 	dtm_inst.txpower = fem_default_tx_gain_get();
 #endif /* CONFIG_DTM_POWER_CONTROL_AUTOMATIC */
 
+	power_lut_build();
+
+	dtm_telemetry_init();
+	dtm_isr_stats_init();
+
 	/** Connect radio interrupts. */
+#if CONFIG_DTM_RADIO_ZLI
+	IRQ_DIRECT_CONNECT(RADIO_IRQn, CONFIG_DTM_RADIO_IRQ_PRIORITY, radio_zli_handler,
+			   IRQ_ZERO_LATENCY);
+	nrf_egu_int_enable(DTM_EGU, DTM_EGU_DEFER_INT);
+#else
 	IRQ_CONNECT(RADIO_IRQn, CONFIG_DTM_RADIO_IRQ_PRIORITY, radio_handler,
 		    NULL, 0);
+#endif /* CONFIG_DTM_RADIO_ZLI */
 	irq_enable(RADIO_IRQn);
 
+#if DTM_ANOMALY_172_ENABLED
+	nrf_egu_int_enable(DTM_EGU, DTM_EGU_ANOMALY_INT);
+#endif /* DTM_ANOMALY_172_ENABLED */
+
+#if CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED
+	IRQ_CONNECT(DTM_EGU_IRQn, DTM_EGU_IRQ_PRIORITY, egu_handler, NULL, 0);
+	irq_enable(DTM_EGU_IRQn);
+#endif /* CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED */
+
 
 	err = radio_init();
 	if (err) {
 		return err;
 	}
 
-	dtm_inst.state = STATE_IDLE;
+	state_set(STATE_IDLE);
 	dtm_inst.packet_len = 0;
 	dtm_inst.cte_info.iq_rep_cb = callback;
 
 	return 0;
 }
 
-#if DIRECTION_FINDING_SUPPORTED
+#if DTM_CTE_ENABLED
 static void report_iq(void)
 {
 	struct dtm_iq_data iq_data;
@@ -1002,9 +1811,101 @@ static void report_iq(void)
 	iq_data.sample_cnt = nrf_radio_dfe_amount_get(NRF_RADIO);
 	iq_data.samples = (struct dtm_iq_sample *)dtm_inst.cte_info.data;
 
-	dtm_inst.cte_info.iq_rep_cb(&iq_data);
+	if (dtm_iq_stream_enabled()) {
+		dtm_iq_stream_report(&iq_data);
+	} else {
+		dtm_inst.cte_info.iq_rep_cb(&iq_data);
+	}
+}
+#endif /* DTM_CTE_ENABLED */
+
+#if DTM_CTE_ENABLED && CONFIG_DTM_IQ_DSP
+/* Number of the switch slot samples between two samples taken with the same
+ * antenna, the period of the entries written in switch_pattern_set(). The
+ * antennas are only switched by the receiver in the AoA mode.
+ */
+static uint8_t cte_pattern_period(void)
+{
+	const uint8_t *pattern = dtm_inst.cte_info.antenna_pattern;
+	size_t len = dtm_inst.cte_info.antenna_pattern_len + 1;
+	size_t period;
+	size_t i;
+
+	if ((dtm_inst.cte_info.mode != DTM_CTE_MODE_AOA) || !pattern) {
+		return 1;
+	}
+
+	for (period = 1; period < len; period++) {
+		for (i = 0; i < len; i++) {
+			if (pattern[i] != pattern[(i + period) % len]) {
+				break;
+			}
+		}
+
+		if (i == len) {
+			break;
+		}
+	}
+
+	return MIN(period, UINT8_MAX);
+}
+
+#if CONFIG_DTM_AOA
+/* Antenna array of the AoA estimation. The antennas are the elements of a
+ * uniform linear array, ordered as they first appear in the pattern.
+ */
+static void cte_aoa_start(const struct dtm_iq_cfo_params *cfo)
+{
+	const uint8_t *pattern = dtm_inst.cte_info.antenna_pattern;
+	uint8_t element[UINT8_MAX];
+	uint8_t next = 0;
+	size_t j;
+	struct dtm_iq_aoa_params params = {
+		.cfo = *cfo,
+		.element = element,
+		/* Spacing in wavelengths, Q15, at the channel of the test. */
+		.spacing = (uint16_t)(((uint64_t)CONFIG_DTM_AOA_ELEMENT_SPACING_UM *
+				       radio_frequency_get(dtm_inst.phys_ch) * 32768) /
+				      299792458),
+	};
+
+	/* Outside of the AoA mode the period is 1, no sample pair is used. */
+	for (size_t i = 0; i < cfo->period; i++) {
+		for (j = 0; (j < i) && (pattern[j] != pattern[i]); j++) {
+		}
+
+		element[i] = (j < i) ? element[j] : next++;
+	}
+
+	dtm_aoa_reset(&params);
+}
+#endif /* CONFIG_DTM_AOA */
+
+static void cte_dsp_start(void)
+{
+	struct dtm_iq_cfo_params params = {
+		.ref_count = DTM_CTE_REF_SAMPLE_CNT,
+		.spacing_us = (dtm_inst.cte_info.slot == DTM_CTE_SLOT_1US) ? 2 : 4,
+		.period = cte_pattern_period(),
+		/* The CTE is a tone 250 kHz above the carrier on LE 1M PHY,
+		 * 500 kHz on LE 2M PHY.
+		 */
+		.nominal = (dtm_inst.radio_mode == NRF_RADIO_MODE_BLE_2MBIT) ?
+			   (DTM_IQ_TURN / 2) : (DTM_IQ_TURN / 4),
+	};
+
+	dtm_cte_cfo_reset(&params);
+	dtm_iq_stream_start(&params);
+
+#if CONFIG_DTM_AOA
+	cte_aoa_start(&params);
+#endif /* CONFIG_DTM_AOA */
+}
+#else
+static void cte_dsp_start(void)
+{
 }
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED && CONFIG_DTM_IQ_DSP */
 
 /* Function for verifying that a received PDU has the expected structure and
  * content.
@@ -1023,8 +1924,7 @@ static bool check_pdu(const struct dtm_pdu *pdu)
 			  (pdu->content[DTM_HEADER_OFFSET] & 0x0F);
 	length = pdu->content[DTM_LENGTH_OFFSET];
 
-	header_len = (dtm_inst.cte_info.mode != DTM_CTE_MODE_OFF) ?
-		     DTM_HEADER_WITH_CTE_SIZE : DTM_HEADER_SIZE;
+	header_len = cte_active() ? DTM_HEADER_WITH_CTE_SIZE : DTM_HEADER_SIZE;
 
 	payload = pdu->content + header_len;
 
@@ -1036,8 +1936,7 @@ static bool check_pdu(const struct dtm_pdu *pdu)
 	/* If the 1Mbit or 2Mbit radio mode is active, check that one of the
 	 * three valid uncoded DTM packet types are selected.
 	 */
-	if ((dtm_inst.radio_mode == NRF_RADIO_MODE_BLE_1MBIT ||
-	     dtm_inst.radio_mode == NRF_RADIO_MODE_BLE_2MBIT) &&
+	if (!radio_mode_coded(dtm_inst.radio_mode) &&
 	    (pdu_packet_type > (uint32_t) DTM_PDU_TYPE_0X55)) {
 		return false;
 	}
@@ -1045,7 +1944,7 @@ static bool check_pdu(const struct dtm_pdu *pdu)
 	/* If a long range radio mode is active, check that one of the four
 	 * valid coded DTM packet types are selected.
 	 */
-	if (dtm_hw_radio_lr_check(dtm_inst.radio_mode) &&
+	if (radio_mode_coded(dtm_inst.radio_mode) &&
 	    (pdu_packet_type > (uint32_t) DTM_PDU_TYPE_0XFF)) {
 		return false;
 	}
@@ -1093,9 +1992,9 @@ static bool check_pdu(const struct dtm_pdu *pdu)
 		}
 	}
 
-#if DIRECTION_FINDING_SUPPORTED
+#if DTM_CTE_ENABLED
 	/* Check CTEInfo and IQ sample cnt */
-	if (dtm_inst.cte_info.mode != DTM_CTE_MODE_OFF) {
+	if (cte_active()) {
 		uint8_t cte_info;
 		uint8_t cte_sample_cnt;
 		uint8_t expected_sample_cnt;
@@ -1108,8 +2007,25 @@ static bool check_pdu(const struct dtm_pdu *pdu)
 			((dtm_inst.cte_info.slot == DTM_CTE_SLOT_1US) ? 2 : 4);
 		cte_sample_cnt = NRF_RADIO->DFEPACKET.AMOUNT;
 
-		if (dtm_inst.cte_info.iq_rep_cb) {
+		/* The angle of arrival of each packet can replace its IQ samples. */
+		if ((dtm_inst.cte_info.iq_rep_cb || dtm_iq_stream_enabled()) &&
+		    !(IS_ENABLED(CONFIG_DTM_AOA_REPORT) &&
+		      (dtm_inst.cte_info.mode == DTM_CTE_MODE_AOA))) {
+			uint32_t isr_start = dtm_isr_stats_start();
+
 			report_iq();
+			dtm_isr_stats_record(DTM_ISR_REPORT_IQ, isr_start);
+		}
+
+		if ((cte_info == dtm_inst.cte_info.mode) &&
+		    (expected_sample_cnt == cte_sample_cnt)) {
+			dtm_cte_cfo_process((const int16_t *)dtm_inst.cte_info.data,
+					    cte_sample_cnt);
+
+			if (dtm_inst.cte_info.mode == DTM_CTE_MODE_AOA) {
+				dtm_aoa_process((const int16_t *)dtm_inst.cte_info.data,
+						cte_sample_cnt, dtm_inst.phys_ch);
+			}
 		}
 
 		memset(dtm_inst.cte_info.data, 0,
@@ -1120,12 +2036,12 @@ static bool check_pdu(const struct dtm_pdu *pdu)
 			return false;
 		}
 	}
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED */
 
 	return true;
 }
 
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 /* Radio configuration used as a workaround for nRF52840 anomaly 172 */
 static void anomaly_172_radio_operation(void)
 {
@@ -1133,20 +2049,6 @@ static void anomaly_172_radio_operation(void)
 	*(volatile uint32_t *) 0x40001038 = 1;
 }
 
-/* Function to gather RSSI data and set strict mode accordingly.
- * Used as part of the workaround for nRF52840 anomaly 172
- */
-static uint8_t anomaly_172_rssi_check(void)
-{
-	nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
-
-	nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_RSSISTART);
-	while (!nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND)) {
-	}
-
-	return nrf_radio_rssi_sample_get(NRF_RADIO);
-}
-
 /* Strict mode setting will be used only by devices affected by nRF52840
  * anomaly 172
  */
@@ -1177,6 +2079,105 @@ static void anomaly_172_strict_mode_set(bool enable)
 	dtm_inst.strict_mode = enable;
 }
 
+#define ANOMALY_172_PPI_MASK (BIT(dtm_inst.ppi_anomaly_ready) |		\
+			      BIT(dtm_inst.ppi_anomaly_address) |	\
+			      BIT(dtm_inst.ppi_anomaly_rssi_default))
+
+/* Start the RSSI checks of the receiver test. The timer is started in hardware
+ * when the receiver is ready and stopped on the ADDRESS event, its compare
+ * events start the RSSI samples, which are read in the EGU interrupt.
+ */
+static void anomaly_172_start(void)
+{
+	NRF_TIMER_Type *timer = dtm_inst.anomaly_timer.p_reg;
+
+	nrfx_timer_disable(&dtm_inst.anomaly_timer);
+	nrfx_timer_clear(&dtm_inst.anomaly_timer);
+
+	nrfx_timer_compare(&dtm_inst.anomaly_timer, BLOCKER_FIX_CC_DEFAULT,
+		nrfx_timer_ms_to_ticks(&dtm_inst.anomaly_timer, BLOCKER_FIX_WAIT_DEFAULT),
+		false);
+	nrfx_timer_compare(&dtm_inst.anomaly_timer, BLOCKER_FIX_CC_END,
+		nrfx_timer_us_to_ticks(&dtm_inst.anomaly_timer, BLOCKER_FIX_WAIT_END),
+		false);
+
+	/* The periodic check restarts the timer. */
+	nrf_timer_shorts_set(timer, nrf_timer_short_compare_clear_get(BLOCKER_FIX_CC_DEFAULT));
+	nrf_timer_event_clear(timer, nrf_timer_compare_event_get(BLOCKER_FIX_CC_DEFAULT));
+	nrf_timer_event_clear(timer, nrf_timer_compare_event_get(BLOCKER_FIX_CC_END));
+	nrf_egu_event_clear(DTM_EGU, DTM_EGU_ANOMALY_DEFAULT_EVENT);
+	nrf_egu_event_clear(DTM_EGU, DTM_EGU_ANOMALY_END_EVENT);
+
+	nrfx_gppi_group_enable(dtm_inst.ppi_anomaly_end_group);
+	nrfx_gppi_channels_enable(ANOMALY_172_PPI_MASK);
+}
+
+static void anomaly_172_stop(void)
+{
+	nrfx_gppi_channels_disable(ANOMALY_172_PPI_MASK);
+	nrfx_gppi_group_disable(dtm_inst.ppi_anomaly_end_group);
+
+	nrfx_timer_disable(&dtm_inst.anomaly_timer);
+	nrfx_timer_clear(&dtm_inst.anomaly_timer);
+}
+
+/* Set the strict mode from an RSSI sample started by the anomaly timer.
+ * Called in the EGU interrupt, the EGU event tells the periodic check from
+ * the first check since the receiver was ready.
+ */
+static void anomaly_172_rssi_handle(void)
+{
+	bool periodic = nrf_egu_event_check(DTM_EGU, DTM_EGU_ANOMALY_DEFAULT_EVENT);
+	uint8_t rssi;
+
+	nrf_egu_event_clear(DTM_EGU, DTM_EGU_ANOMALY_DEFAULT_EVENT);
+	nrf_egu_event_clear(DTM_EGU, DTM_EGU_ANOMALY_END_EVENT);
+
+	if ((dtm_inst.state != STATE_RECEIVER_TEST) || !dtm_inst.anomaly_172_wa_enabled) {
+		return;
+	}
+
+	/* The sample started with the EGU task takes 0.25 us and is complete
+	 * when the interrupt runs.
+	 */
+	rssi = nrf_radio_rssi_sample_get(NRF_RADIO);
+
+	if (periodic) {
+		if (dtm_inst.strict_mode) {
+			if (rssi > BLOCKER_FIX_RSSI_THRESHOLD) {
+				anomaly_172_strict_mode_set(false);
+			}
+		} else {
+			bool too_many_detects = false;
+			uint32_t packetcnt2 = *(volatile uint32_t *) 0x40001574;
+			uint32_t detect_cnt = packetcnt2 & 0xffff;
+			uint32_t addr_cnt = (packetcnt2 >> 16) & 0xffff;
+
+			if ((detect_cnt > BLOCKER_FIX_CNTDETECTTHR) &&
+			    (addr_cnt < BLOCKER_FIX_CNTADDRTHR)) {
+				too_many_detects = true;
+			}
+
+			if ((rssi < BLOCKER_FIX_RSSI_THRESHOLD) ||
+			    too_many_detects) {
+				anomaly_172_strict_mode_set(true);
+			}
+		}
+	} else {
+		if (dtm_inst.strict_mode) {
+			if (rssi >= BLOCKER_FIX_RSSI_THRESHOLD) {
+				anomaly_172_strict_mode_set(false);
+			}
+		} else {
+			if (rssi < BLOCKER_FIX_RSSI_THRESHOLD) {
+				anomaly_172_strict_mode_set(true);
+			}
+		}
+	}
+
+	anomaly_172_radio_operation();
+}
+
 static void errata_172_handle(bool enable)
 {
 	if (!nrf52_errata_172()) {
@@ -1189,7 +2190,7 @@ static void errata_172_handle(bool enable)
 		}
 	} else {
 		anomaly_172_strict_mode_set(false);
-		nrfx_timer_disable(&dtm_inst.anomaly_timer);
+		anomaly_172_stop();
 		dtm_inst.anomaly_172_wa_enabled = false;
 	}
 }
@@ -1198,7 +2199,7 @@ static void errata_172_handle(bool enable)
 {
 	ARG_UNUSED(enable);
 }
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
 
 static void errata_117_handle(bool enable)
 {
@@ -1285,53 +2286,445 @@ static void radio_tx_ppi_reconfigure(void)
 	nrfx_gppi_channels_enable(BIT(dtm_inst.ppi_radio_start));
 }
 
-static void dtm_test_done(void)
+#if CONFIG_DTM_MEAS_TIMER
+static void meas_start(void)
 {
-	nrfx_timer_disable(&dtm_inst.timer);
-
-	radio_ppi_clear();
+	nrfx_timer_clear(&dtm_inst.meas_timer);
+	nrfx_timer_enable(&dtm_inst.meas_timer);
 
-	/* Disable all timer shorts and interrupts. */
-	nrf_timer_shorts_set(dtm_inst.timer.p_reg, 0);
-	nrf_timer_int_disable(dtm_inst.timer.p_reg, ~((uint32_t)0));
+	nrfx_gppi_channels_enable(BIT(dtm_inst.ppi_meas_address) | BIT(dtm_inst.ppi_meas_end));
+}
 
-	nrfx_timer_clear(&dtm_inst.timer);
+static void meas_stop(void)
+{
+	nrfx_gppi_channels_disable(BIT(dtm_inst.ppi_meas_address) | BIT(dtm_inst.ppi_meas_end));
+	nrfx_timer_disable(&dtm_inst.meas_timer);
+
+#if CONFIG_DTM_TX_STATS
+	nrfx_gppi_channels_disable(BIT(dtm_inst.ppi_tx_first));
+	nrfx_timer_disable(&dtm_inst.counter_timer);
+#endif /* CONFIG_DTM_TX_STATS */
+
+#if CONFIG_DTM_TX_BURST
+	nrfx_gppi_channels_disable(BIT(dtm_inst.ppi_tx_burst));
+	nrfx_timer_compare_int_disable(&dtm_inst.counter_timer, COUNTER_CC_BURST);
+#endif /* CONFIG_DTM_TX_BURST */
+}
+#else
+static void meas_stop(void)
+{
+}
+#endif /* CONFIG_DTM_MEAS_TIMER */
 
-#if NRF52_ERRATA_172_PRESENT
-	nrfx_timer_disable(&dtm_inst.anomaly_timer);
-#endif /* NRF52_ERRATA_172_PRESENT */
+#if CONFIG_DTM_RX_TIMING
+static void rx_timing_start(void)
+{
+	memset(&dtm_inst.rx_timing, 0, sizeof(dtm_inst.rx_timing));
+	dtm_inst.rx_timing.jitter_min = INT32_MAX;
+	dtm_inst.rx_timing.jitter_max = INT32_MIN;
 
-	radio_reset();
+	meas_start();
+}
+#else
+static void rx_timing_start(void)
+{
+}
+#endif /* CONFIG_DTM_RX_TIMING */
 
-#if CONFIG_FEM
-	fem_txrx_configuration_clear();
-	fem_txrx_stop();
-	(void)fem_power_down();
-#endif /* CONFIG_FEM */
+#if CONFIG_DTM_RX_SCAN
+/* Tune the receiver to the next channel of the scan. The receiver must not be
+ * active, the new frequency is used from the next RXEN task.
+ */
+static void rx_scan_hop(void)
+{
+	struct rx_scan *scan = &dtm_inst.rx_scan;
 
-	dtm_inst.state = STATE_IDLE;
+	scan->idx = (scan->idx + 1) % scan->count;
+	dtm_inst.phys_ch = scan->channels[scan->idx];
+	nrf_radio_frequency_set(NRF_RADIO, radio_frequency_get(dtm_inst.phys_ch));
 }
 
-static void radio_start(bool rx, bool force_egu)
+/* The dwell time elapsed. The hop is left to the radio interrupt, which is
+ * not masked by irq_lock() when it is a zero-latency interrupt.
+ */
+static void rx_scan_timer_handler(struct k_timer *timer)
 {
-	if (IS_ENABLED(CONFIG_FEM) || force_egu) {
-		nrf_egu_event_clear(DTM_EGU, DTM_EGU_EVENT);
-		nrf_egu_task_trigger(DTM_EGU, DTM_EGU_TASK);
-	} else {
-		/* Shorts will start radio in RX mode when it is ready */
-		nrf_radio_task_trigger(NRF_RADIO, rx ? NRF_RADIO_TASK_RXEN : NRF_RADIO_TASK_TXEN);
-	}
-}
+	struct rx_scan *scan = &dtm_inst.rx_scan;
+
+	ARG_UNUSED(timer);
+
+	if (!scan->active) {
+		return;
+	}
+
+	scan->hop_pending = true;
+	compiler_barrier();
+	NVIC_SetPendingIRQ(RADIO_IRQn);
+}
+
+/* Radio interrupt handling of a hop requested by the dwell timer. A packet
+ * END handled first hops in rx_scan_rearm(), otherwise the reception in
+ * progress is aborted and the DISABLED event hops and restarts the receiver.
+ * A receiver already disabled is restarted by the END handling, the hop is
+ * then done at the next packet.
+ */
+static void rx_scan_radio_handler(void)
+{
+	struct rx_scan *scan = &dtm_inst.rx_scan;
+
+	if (scan->hop_disabling &&
+	    nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_DISABLED)) {
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_DISABLED);
+		nrf_radio_int_disable(NRF_RADIO, NRF_RADIO_INT_DISABLED_MASK);
+		scan->hop_disabling = false;
+
+		if (scan->hop_pending) {
+			scan->hop_pending = false;
+			rx_scan_hop();
+			radio_start(true, false);
+		}
+
+		return;
+	}
+
+	if (!scan->active || !scan->hop_pending || scan->hop_disabling ||
+	    (nrf_radio_state_get(NRF_RADIO) == NRF_RADIO_STATE_DISABLED)) {
+		return;
+	}
+
+	scan->hop_disabling = true;
+	nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_DISABLED);
+	nrf_radio_int_enable(NRF_RADIO, NRF_RADIO_INT_DISABLED_MASK);
+	nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_DISABLE);
+}
+
+static K_TIMER_DEFINE(rx_scan_timer, rx_scan_timer_handler, NULL);
+
+/* Pre-program the next scan channel before the receiver is restarted.
+ * Returns true when the channel changed, the dwell timer is then restarted
+ * in the deferred processing.
+ */
+static bool rx_scan_rearm(void)
+{
+	struct rx_scan *scan = &dtm_inst.rx_scan;
+
+	if (!scan->hop_per_packet && !scan->hop_pending) {
+		return false;
+	}
+
+	scan->hop_pending = false;
+	rx_scan_hop();
+
+	return true;
+}
+
+/* Count a received packet in the statistics of its channel. The RSSI is
+ * sampled in hardware on the ADDRESS event.
+ */
+static void rx_scan_record(uint8_t channel, bool crc_ok, int8_t rssi)
+{
+	struct rx_scan *scan = &dtm_inst.rx_scan;
+	struct dtm_rx_scan_stat *stat = &scan->stats[channel];
+
+	if (crc_ok) {
+		stat->packets += (stat->packets < UINT16_MAX) ? 1 : 0;
+	} else {
+		stat->crc_errors += (stat->crc_errors < UINT16_MAX) ? 1 : 0;
+	}
+
+	if ((scan->rssi_cnt[channel] == 0) || (rssi > stat->rssi_max)) {
+		stat->rssi_max = rssi;
+	}
+
+	scan->rssi_sum[channel] += rssi;
+	scan->rssi_cnt[channel]++;
+	stat->rssi_avg = scan->rssi_sum[channel] / (int32_t)scan->rssi_cnt[channel];
+}
+
+static void rx_scan_stop(void)
+{
+	dtm_inst.rx_scan.active = false;
+	k_timer_stop(&rx_scan_timer);
+
+	dtm_inst.rx_scan.hop_disabling = false;
+	dtm_inst.rx_scan.hop_pending = false;
+}
+#else
+static void rx_scan_stop(void)
+{
+}
+#endif /* CONFIG_DTM_RX_SCAN */
+
+#if CONFIG_DTM_RSSI_SWEEP
+static void rssi_sweep_work_handler(struct k_work *work);
+
+static K_WORK_DEFINE(rssi_sweep_work, rssi_sweep_work_handler);
+
+/* Tune the receiver to the current step and enable it. */
+static void rssi_sweep_step_start(void)
+{
+	struct rssi_sweep *sweep = &dtm_inst.rssi_sweep;
+
+	sweep->sample = 0;
+	sweep->sum = 0;
+	sweep->min = INT8_MAX;
+	sweep->max = INT8_MIN;
+
+	nrf_radio_frequency_set(NRF_RADIO, sweep->result.start_mhz +
+				(sweep->step * sweep->result.step_mhz));
+	nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_RXEN);
+}
+
+static void rssi_sweep_begin(void)
+{
+	struct rssi_sweep *sweep = &dtm_inst.rssi_sweep;
+
+	sweep->step = 0;
+	sweep->start_cycles = k_cycle_get_32();
+	state_set(STATE_RSSI_SWEEP);
+
+	/* The receiver is started on READY, no packet is received. */
+	nrf_radio_shorts_set(NRF_RADIO, NRF_RADIO_SHORT_READY_START_MASK);
+	nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_READY);
+	nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
+	nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_DISABLED);
+
+	NVIC_ClearPendingIRQ(RADIO_IRQn);
+	irq_enable(RADIO_IRQn);
+	nrf_radio_int_enable(NRF_RADIO,
+			     NRF_RADIO_INT_READY_MASK |
+			     NRF_RADIO_INT_RSSIEND_MASK |
+			     NRF_RADIO_INT_DISABLED_MASK);
+
+	rssi_sweep_step_start();
+}
+
+/* Radio interrupt handling of the sweep. Each RSSIEND event starts the next
+ * sample, the last sample of a step disables the receiver and the DISABLED
+ * event moves to the next frequency.
+ */
+static void rssi_sweep_handler(void)
+{
+	struct rssi_sweep *sweep = &dtm_inst.rssi_sweep;
+	struct dtm_rssi_sweep *result = &sweep->result;
+
+	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_READY)) {
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_READY);
+		nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_RSSISTART);
+	}
+
+	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND)) {
+		int8_t rssi = -(int8_t)nrf_radio_rssi_sample_get(NRF_RADIO);
+
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
+
+		sweep->sum += rssi;
+		sweep->min = MIN(sweep->min, rssi);
+		sweep->max = MAX(sweep->max, rssi);
+
+		if (++sweep->sample < result->samples) {
+			nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_RSSISTART);
+		} else {
+			result->min[sweep->step] = sweep->min;
+			result->avg[sweep->step] = sweep->sum / result->samples;
+			result->max[sweep->step] = sweep->max;
+
+			nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_DISABLE);
+		}
+	}
+
+	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_DISABLED)) {
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_DISABLED);
+
+		if (++sweep->step < result->count) {
+			rssi_sweep_step_start();
+			return;
+		}
+
+		nrf_radio_int_disable(NRF_RADIO,
+				      NRF_RADIO_INT_READY_MASK |
+				      NRF_RADIO_INT_RSSIEND_MASK |
+				      NRF_RADIO_INT_DISABLED_MASK);
+		nrf_radio_shorts_set(NRF_RADIO, 0);
+
+		result->seq++;
+
+		state_set(STATE_IDLE);
+		sweep->done = true;
+		radio_defer();
+	}
+}
+
+/* Report the sweep which ended in the radio interrupt. */
+static void rssi_sweep_done(void)
+{
+	struct rssi_sweep *sweep = &dtm_inst.rssi_sweep;
+
+	sweep->result.duration_us = k_cyc_to_us_floor32(k_cycle_get_32() - sweep->start_cycles);
+	k_work_submit(&rssi_sweep_work);
+}
+
+/* Restart the repeated sweep in the executor, so the state check and the
+ * restart cannot interleave with a test started by another client.
+ */
+static int rssi_sweep_restart(void *ctx)
+{
+	struct rssi_sweep *sweep = &dtm_inst.rssi_sweep;
+
+	ARG_UNUSED(ctx);
+
+	/* A test started in the meantime ends the repeated sweep. */
+	if (sweep->repeat && (dtm_inst.state == STATE_IDLE) && !dtm_exec_test_start_check()) {
+		rssi_sweep_begin();
+		return 0;
+	}
+
+	sweep->repeat = false;
+	hfclk_idle();
+
+	return 0;
+}
+
+static void rssi_sweep_work_handler(struct k_work *work)
+{
+	struct rssi_sweep *sweep = &dtm_inst.rssi_sweep;
+
+	ARG_UNUSED(work);
+
+	if (sweep->cb) {
+		sweep->cb(&sweep->result);
+	}
+
+	(void)dtm_exec_call(DTM_EXEC_CLIENT_MAIN, rssi_sweep_restart, NULL);
+}
+
+static void rssi_sweep_abort(void)
+{
+	dtm_inst.rssi_sweep.repeat = false;
+}
+#else
+static void rssi_sweep_abort(void)
+{
+}
+#endif /* CONFIG_DTM_RSSI_SWEEP */
+
+#if CONFIG_DTM_RX_HW_REARM
+/* Restart the receiver after each packet with the DISABLED_RXEN short, or
+ * through the EGU when the FEM timer must be started with the receiver.
+ * The CTE needs the radio END handling between the packets, the receiver is
+ * then restarted in software.
+ */
+static void rx_hw_rearm_set(bool enable)
+{
+	enable = enable && !cte_active();
+
+	dtm_inst.rx_hw_rearm = enable;
+
+#if CONFIG_FEM
+	if (enable) {
+		nrfx_gppi_channels_enable(BIT(dtm_inst.ppi_rx_rearm));
+	} else {
+		nrfx_gppi_channels_disable(BIT(dtm_inst.ppi_rx_rearm));
+	}
+#else
+	if (enable) {
+		nrf_radio_shorts_enable(NRF_RADIO, NRF_RADIO_SHORT_DISABLED_RXEN_MASK);
+	} else {
+		nrf_radio_shorts_disable(NRF_RADIO, NRF_RADIO_SHORT_DISABLED_RXEN_MASK);
+	}
+#endif /* CONFIG_FEM */
+}
+
+static bool rx_hw_rearm_active(void)
+{
+	return dtm_inst.rx_hw_rearm;
+}
+
+/* The packet pointer is taken on the START task. When the END handling comes
+ * after the receiver was restarted in hardware and started, the next packet
+ * is received into the buffer of the packet being captured.
+ */
+static bool rx_hw_rearm_late(void)
+{
+	nrf_radio_state_t state;
+
+	if (!dtm_inst.rx_hw_rearm) {
+		return false;
+	}
+
+	state = nrf_radio_state_get(NRF_RADIO);
+
+	return (state == NRF_RADIO_STATE_RXIDLE) || (state == NRF_RADIO_STATE_RX);
+}
+#else
+static void rx_hw_rearm_set(bool enable)
+{
+	ARG_UNUSED(enable);
+}
+
+static bool rx_hw_rearm_active(void)
+{
+	return false;
+}
+
+static bool rx_hw_rearm_late(void)
+{
+	return false;
+}
+#endif /* CONFIG_DTM_RX_HW_REARM */
+
+static void dtm_test_done(void)
+{
+	nrfx_timer_disable(&dtm_inst.timer);
+
+	radio_ppi_clear();
+
+	/* Disable all timer shorts and interrupts. */
+	nrf_timer_shorts_set(dtm_inst.timer.p_reg, 0);
+	nrf_timer_int_disable(dtm_inst.timer.p_reg, ~((uint32_t)0));
+
+	nrfx_timer_clear(&dtm_inst.timer);
+
+#if DTM_ANOMALY_172_ENABLED
+	anomaly_172_stop();
+#endif /* DTM_ANOMALY_172_ENABLED */
+
+	meas_stop();
+	rx_scan_stop();
+	rssi_sweep_abort();
+	rx_hw_rearm_set(false);
+
+	radio_reset();
+
+#if CONFIG_FEM
+	fem_txrx_configuration_clear();
+	fem_txrx_stop();
+	(void)fem_power_down();
+#endif /* CONFIG_FEM */
+
+	state_set(STATE_IDLE);
+}
+
+static void radio_start(bool rx, bool force_egu)
+{
+	if (IS_ENABLED(CONFIG_FEM) || force_egu) {
+		nrf_egu_event_clear(DTM_EGU, DTM_EGU_EVENT);
+		nrf_egu_task_trigger(DTM_EGU, DTM_EGU_TASK);
+	} else {
+		/* Shorts will start radio in RX mode when it is ready */
+		nrf_radio_task_trigger(NRF_RADIO, rx ? NRF_RADIO_TASK_RXEN : NRF_RADIO_TASK_TXEN);
+	}
+}
 
 static void radio_prepare(bool rx)
 {
-#if DIRECTION_FINDING_SUPPORTED
-	if (dtm_inst.cte_info.mode != DTM_CTE_MODE_OFF) {
+#if DTM_CTE_ENABLED
+	if (cte_active()) {
 		radio_cte_prepare(rx);
 	} else {
 		radio_cte_reset();
 	}
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED */
 
 	/* Actual frequency (MHz): 2402 + 2N */
 	nrf_radio_frequency_set(NRF_RADIO, radio_frequency_get(dtm_inst.phys_ch));
@@ -1344,10 +2737,10 @@ static void radio_prepare(bool rx)
 	 * between READY event and START task and
 	 * between END event and DISABLE task
 	 */
-#if DIRECTION_FINDING_SUPPORTED
+#if DTM_CTE_ENABLED
 	nrf_radio_shorts_set(NRF_RADIO,
 		NRF_RADIO_SHORT_READY_START_MASK |
-		(dtm_inst.cte_info.iq_rep_cb ?
+		((dtm_inst.cte_info.iq_rep_cb || dtm_iq_stream_enabled()) ?
 		 NRF_RADIO_SHORT_ADDRESS_RSSISTART_MASK : 0) |
 		(dtm_inst.cte_info.mode == DTM_CTE_MODE_OFF ?
 		 NRF_RADIO_SHORT_END_DISABLE_MASK :
@@ -1356,7 +2749,7 @@ static void radio_prepare(bool rx)
 	nrf_radio_shorts_set(NRF_RADIO,
 			     NRF_RADIO_SHORT_READY_START_MASK |
 			     NRF_RADIO_SHORT_END_DISABLE_MASK);
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED */
 
 
 #if CONFIG_FEM
@@ -1371,19 +2764,19 @@ static void radio_prepare(bool rx)
 
 	NVIC_ClearPendingIRQ(RADIO_IRQn);
 	irq_enable(RADIO_IRQn);
-	nrf_radio_int_enable(NRF_RADIO,
-			NRF_RADIO_INT_READY_MASK |
-			NRF_RADIO_INT_ADDRESS_MASK |
-			NRF_RADIO_INT_RSSIEND_MASK |
-			NRF_RADIO_INT_END_MASK);
+	nrf_radio_int_enable(NRF_RADIO, NRF_RADIO_INT_END_MASK);
 
 	if (rx) {
-#if NRF52_ERRATA_172_PRESENT
+		/* Sample the RSSI of every packet in hardware. */
+		nrf_radio_shorts_enable(NRF_RADIO, NRF_RADIO_SHORT_ADDRESS_RSSISTART_MASK);
+
+#if DTM_ANOMALY_172_ENABLED
 		/* Enable strict mode for anomaly 172 */
 		if (dtm_inst.anomaly_172_wa_enabled) {
 			anomaly_172_strict_mode_set(true);
+			anomaly_172_start();
 		}
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
 
 		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_END);
 
@@ -1395,22 +2788,17 @@ static void radio_prepare(bool rx)
 		(void)fem_rx_configure(dtm_inst.fem.ramp_up_time);
 #endif /* CONFIG_FEM */
 
+		rx_hw_rearm_set(true);
 		radio_start(rx, false);
 	} else { /* tx */
 		radio_tx_power_set(dtm_inst.phys_ch, dtm_inst.txpower);
 
-#if NRF52_ERRATA_172_PRESENT
+#if DTM_ANOMALY_172_ENABLED
 		/* Stop the timer used by anomaly 172 */
 		if (dtm_inst.anomaly_172_wa_enabled) {
-			nrfx_timer_disable(&dtm_inst.anomaly_timer);
-			nrfx_timer_clear(&dtm_inst.anomaly_timer);
-
-			nrf_timer_event_clear(dtm_inst.anomaly_timer.p_reg,
-					      NRF_TIMER_EVENT_COMPARE0);
-			nrf_timer_event_clear(dtm_inst.anomaly_timer.p_reg,
-					      NRF_TIMER_EVENT_COMPARE1);
+			anomaly_172_stop();
 		}
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* DTM_ANOMALY_172_ENABLED */
 	}
 }
 
@@ -1481,7 +2869,7 @@ static int dtm_vendor_specific_pkt(uint32_t vendor_cmd, uint32_t vendor_option)
 #endif /* CONFIG_FEM */
 
 		radio_start(false, false);
-		dtm_inst.state = STATE_CARRIER_TEST;
+		state_set(STATE_CARRIER_TEST);
 		break;
 
 #if !CONFIG_DTM_POWER_CONTROL_AUTOMATIC
@@ -1551,7 +2939,7 @@ static uint32_t dtm_packet_interval_calculate(uint32_t test_payload_length,
 		 * 24 CRC
 		 */
 		overhead_bits = 88; /* 11 bytes */
-	} else if (mode == NRF_RADIO_MODE_NRF_1MBIT) {
+	} else if (mode == NRF_RADIO_MODE_BLE_1MBIT) {
 		/*  8 preamble
 		 * 32 sync word
 		 *  8 PDU header, actually packetHeaderS0len * 8
@@ -1559,7 +2947,7 @@ static uint32_t dtm_packet_interval_calculate(uint32_t test_payload_length,
 		 * 24 CRC
 		 */
 		overhead_bits = 80; /* 10 bytes */
-#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED
+#if DTM_CODED_PHY_ENABLED
 	} else if (mode == NRF_RADIO_MODE_BLE_LR125KBIT) {
 		/* 80     preamble
 		 * 32 * 8 sync word coding=8
@@ -1584,14 +2972,14 @@ static uint32_t dtm_packet_interval_calculate(uint32_t test_payload_length,
 		 *       assumption the radio will handle this
 		 */
 		overhead_bits = 462; /* 57.75 bytes */
-#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED */
+#endif /* DTM_CODED_PHY_ENABLED */
 	}
 
 	/* Add PDU payload test_payload length */
 	test_packet_length = (test_payload_length * 8); /* in bits */
 
 	/* Account for the encoding of PDU */
-#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED
+#if DTM_CODED_PHY_ENABLED
 	if (mode == NRF_RADIO_MODE_BLE_LR125KBIT) {
 		test_packet_length *= 8; /* 1 to 8 encoding */
 	}
@@ -1599,7 +2987,7 @@ static uint32_t dtm_packet_interval_calculate(uint32_t test_payload_length,
 	if (mode == NRF_RADIO_MODE_BLE_LR500KBIT) {
 		test_packet_length *= 2; /* 1 to 2 encoding */
 	}
-#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED */
+#endif /* DTM_CODED_PHY_ENABLED */
 
 	/* Add overhead calculated above */
 	test_packet_length += overhead_bits;
@@ -1608,10 +2996,9 @@ static uint32_t dtm_packet_interval_calculate(uint32_t test_payload_length,
 		test_packet_length /= 2; /* double speed */
 	}
 
-	if (dtm_inst.cte_info.mode != DTM_CTE_MODE_OFF) {
+	if (cte_active()) {
 		/* Add 8 - bit S1 field with CTEInfo. */
-		((test_packet_length += mode) == RADIO_MODE_MODE_Ble_1Mbit) ?
-						 8 : 4;
+		test_packet_length += (mode == NRF_RADIO_MODE_BLE_1MBIT) ? 8 : 4;
 
 		/* Add CTE length in us to test packet length. */
 		test_packet_length +=
@@ -1637,6 +3024,12 @@ static uint32_t dtm_packet_interval_calculate(uint32_t test_payload_length,
 void dtm_setup_prepare(void)
 {
 	dtm_test_done();
+
+	/* A setup command is usually followed by a test. Start the crystal
+	 * now to hide its start-up time, it is released if no test follows.
+	 */
+	(void)hfclk_request(false);
+	hfclk_idle();
 }
 
 int dtm_setup_reset(void)
@@ -1648,9 +3041,9 @@ int dtm_setup_reset(void)
 	dtm_inst.radio_mode = NRF_RADIO_MODE_BLE_1MBIT;
 	dtm_inst.packet_hdr_plen = NRF_RADIO_PREAMBLE_LENGTH_8BIT;
 
-#if DIRECTION_FINDING_SUPPORTED
+#if DTM_CTE_ENABLED
 	memset(&dtm_inst.cte_info, 0, sizeof(dtm_inst.cte_info));
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED */
 
 	errata_191_handle(false);
 	errata_172_handle(false);
@@ -1680,7 +3073,7 @@ int dtm_setup_set_phy(enum dtm_phy phy)
 		errata_117_handle(true);
 		break;
 
-#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED
+#if DTM_CODED_PHY_ENABLED
 	case DTM_PHY_CODED_S8:
 		dtm_inst.radio_mode = NRF_RADIO_MODE_BLE_LR125KBIT;
 		dtm_inst.packet_hdr_plen = NRF_RADIO_PREAMBLE_LENGTH_LONG_RANGE;
@@ -1702,12 +3095,14 @@ int dtm_setup_set_phy(enum dtm_phy phy)
 	case DTM_PHY_CODED_S8:
 	case DTM_PHY_CODED_S2:
 		return -ENOTSUP;
-#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED */
+#endif /* DTM_CODED_PHY_ENABLED */
 
 	default:
 		return -EINVAL;
 	}
 
+	dtm_telemetry_phy_set(phy);
+
 	return radio_init();
 }
 
@@ -1749,14 +3144,14 @@ int dtm_setup_read_max_supported_value(enum dtm_max_supported parameter, uint16_
 		*max_val = NRF_MAX_RX_TX_TIME;
 		break;
 
-#if DIRECTION_FINDING_SUPPORTED
+#if DTM_CTE_ENABLED
 	case DTM_MAX_SUPPORTED_CTE_LENGTH:
 		*max_val = NRF_CTE_MAX_LENGTH;
 		break;
 #else
 	case DTM_MAX_SUPPORTED_CTE_LENGTH:
 		return -ENOTSUP;
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED */
 
 	default:
 		return -EINVAL;
@@ -1765,7 +3160,7 @@ int dtm_setup_read_max_supported_value(enum dtm_max_supported parameter, uint16_
 	return 0;
 }
 
-#if DIRECTION_FINDING_SUPPORTED
+#if DTM_CTE_ENABLED
 int dtm_setup_set_cte_mode(enum dtm_cte_type type, uint8_t time)
 {
 	uint8_t cte_info = time & CTEINFO_TIME_MASK;
@@ -1873,7 +3268,7 @@ int dtm_setup_set_antenna_params(uint8_t count, uint8_t *pattern, uint8_t patter
 
 	return -ENOTSUP;
 }
-#endif /* DIRECTION_FINDING_SUPPORTED */
+#endif /* DTM_CTE_ENABLED */
 
 struct dtm_tx_power dtm_setup_set_transmit_power(enum dtm_tx_power_request power, int8_t val,
 						 uint8_t channel)
@@ -1902,8 +3297,9 @@ struct dtm_tx_power dtm_setup_set_transmit_power(enum dtm_tx_power_request power
 		} else if (val >= tx_power_max) {
 			dtm_inst.txpower = tx_power_max;
 		} else {
-			dtm_inst.txpower = dtm_radio_nearest_power_get(val, frequency);
+			dtm_inst.txpower = power_lut_get(val, channel);
 		}
+		break;
 
 	default:
 		return tmp;
@@ -1922,18 +3318,29 @@ struct dtm_tx_power dtm_setup_set_transmit_power(enum dtm_tx_power_request power
 
 int dtm_test_receive(uint8_t channel)
 {
+	int err;
+
 	if (channel > PHYS_CH_MAX) {
 		return -EINVAL;
 	}
 
-#ifndef EMC_TEST_MODE
-	printk("[DEBUG] dtm_test_receive: Setting channel to %d\n", channel);
-#endif
+	if ((dtm_inst.state == STATE_RSSI_SWEEP) || dtm_exec_test_start_check()) {
+		return -EBUSY;
+	}
+
+	err = hfclk_test_start();
+	if (err) {
+		return err;
+	}
+
+	dtm_isr_stats_reset();
+	rx_scan_stop();
+
 	dtm_inst.current_pdu = dtm_inst.pdu;
+	dtm_inst.rx_ring.head = 0;
+	dtm_inst.rx_ring.tail = 0;
+	dtm_inst.rx_ring.overruns = 0;
 	dtm_inst.phys_ch = channel;
-#ifndef EMC_TEST_MODE
-	printk("[DEBUG] dtm_inst.phys_ch set to: %d\n", dtm_inst.phys_ch);
-#endif
 	dtm_inst.rx_pkt_count = 0;
 	dtm_inst.crc_error_count = 0;
 	dtm_inst.last_report_time = k_uptime_get_32();
@@ -1944,27 +3351,103 @@ int dtm_test_receive(uint8_t channel)
 	 */
 	memset(&dtm_inst.pdu, 0, sizeof(dtm_inst.pdu));
 
+	dtm_rssi_stats_reset();
+	cte_dsp_start();
+
+	/* Start the timestamps before the radio is enabled. */
+	rx_timing_start();
+
 	/* Reinitialize "everything"; RF interrupts OFF */
 	radio_prepare(RX_MODE);
 
-	dtm_inst.state = STATE_RECEIVER_TEST;
+	state_set(STATE_RECEIVER_TEST);
 	
-	/* Report RX test start via RTT - only in debug mode */
-#ifndef EMC_TEST_MODE
-	printk("\n===== RX Test Started =====\n");
-	printk("Channel: %d (%d MHz)\n", channel, 2404 + channel * 2);
-	printk("Monitoring packets... Updates every 10 packets or 2 seconds\n");
-	printk("[DEBUG] Radio state: %d, Interrupts enabled\n\n", dtm_inst.state);
-#endif
+	/* Report RX test start - only in diagnostics mode */
+	DTM_DIAG("\n===== RX Test Started =====\n");
+	DTM_DIAG("Channel: %d (%d MHz)\n", channel, 2402 + channel * 2);
+	DTM_DIAG("Monitoring packets... Updates every 10 packets or 2 seconds\n\n");
 	
 	return 0;
 }
 
+#if CONFIG_DTM_TX_STATS
+static void tx_stats_start(void)
+{
+	nrfx_timer_clear(&dtm_inst.counter_timer);
+	nrf_timer_event_clear(dtm_inst.counter_timer.p_reg,
+			      nrf_timer_compare_event_get(COUNTER_CC_FIRST));
+	nrf_timer_cc_set(dtm_inst.meas_timer.p_reg, MEAS_TIMER_CC_FIRST_END, 0);
+
+#if CONFIG_DTM_TX_BURST
+	if (dtm_inst.burst_count) {
+		nrfx_timer_compare(&dtm_inst.counter_timer, COUNTER_CC_BURST,
+				   dtm_inst.burst_count, true);
+		nrfx_gppi_channels_enable(BIT(dtm_inst.ppi_tx_burst));
+	}
+#endif /* CONFIG_DTM_TX_BURST */
+
+	nrfx_timer_enable(&dtm_inst.counter_timer);
+	nrfx_gppi_channels_enable(BIT(dtm_inst.ppi_tx_first));
+
+	dtm_inst.tx_start_time = k_uptime_get();
+
+	meas_start();
+}
+
+/* Collect the transmitter statistics, called before the test is stopped. */
+static void tx_stats_collect(void)
+{
+	struct dtm_tx_stats *stats = &dtm_inst.tx_stats;
+	uint32_t first_end;
+	uint32_t last_end;
+	uint32_t last_address;
+	uint64_t elapsed;
+	uint64_t approx;
+
+	/* Freeze the counter and the timestamps of the last packet. */
+	nrfx_gppi_channels_disable(BIT(dtm_inst.ppi_meas_address) | BIT(dtm_inst.ppi_meas_end));
+	nrf_timer_task_trigger(dtm_inst.counter_timer.p_reg,
+			       nrf_timer_capture_task_get(COUNTER_CC_READ));
+
+	memset(stats, 0, sizeof(*stats));
+	stats->packets = nrf_timer_cc_get(dtm_inst.counter_timer.p_reg, COUNTER_CC_READ);
+	stats->nominal_us = dtm_packet_interval_calculate(dtm_inst.packet_len,
+							  dtm_inst.radio_mode);
+
+	if (stats->packets < 2) {
+		return;
+	}
+
+	first_end = nrf_timer_cc_get(dtm_inst.meas_timer.p_reg, MEAS_TIMER_CC_FIRST_END);
+	last_end = nrf_timer_cc_get(dtm_inst.meas_timer.p_reg, MEAS_TIMER_CC_END);
+
+	/* The 32-bit timestamps wrap around every 268 seconds, the test
+	 * duration from the uptime resolves the number of wrap-arounds.
+	 */
+	elapsed = (uint32_t)(last_end - first_end);
+	approx = (uint64_t)(k_uptime_get() - dtm_inst.tx_start_time) *
+		 (MEAS_TIMER_TICKS_PER_US * USEC_PER_MSEC);
+	if (approx > elapsed) {
+		elapsed += ((approx - elapsed + BIT64(31)) >> 32) << 32;
+	}
+
+	stats->interval_ns = (uint32_t)((elapsed * 1000) /
+					((uint64_t)MEAS_TIMER_TICKS_PER_US * (stats->packets - 1)));
+
+	/* The ADDRESS capture is newer if a packet was being sent. */
+	last_address = nrf_timer_cc_get(dtm_inst.meas_timer.p_reg, MEAS_TIMER_CC_ADDRESS);
+	if ((last_end - last_address) < (stats->nominal_us * MEAS_TIMER_TICKS_PER_US)) {
+		stats->airtime_ns = ((last_end - last_address) * 1000) / MEAS_TIMER_TICKS_PER_US;
+	}
+}
+#endif /* CONFIG_DTM_TX_STATS */
+
 int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt)
 {
 	uint8_t header_len;
+	int err;
 
-	if (dtm_inst.state != STATE_IDLE) {
+	if ((dtm_inst.state != STATE_IDLE) || dtm_exec_test_start_check()) {
 		return -EBUSY;
 	}
 
@@ -2000,10 +3483,16 @@ int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt)
 		return -EINVAL;
 	}
 
+	err = hfclk_test_start();
+	if (err) {
+		return err;
+	}
+
+	dtm_isr_stats_reset();
+
 	dtm_inst.rx_pkt_count = 0;
 
-	header_len = (dtm_inst.cte_info.mode != DTM_CTE_MODE_OFF) ?
-		     DTM_HEADER_WITH_CTE_SIZE : DTM_HEADER_SIZE;
+	header_len = cte_active() ? DTM_HEADER_WITH_CTE_SIZE : DTM_HEADER_SIZE;
 
 	dtm_inst.current_pdu->content[DTM_LENGTH_OFFSET] = dtm_inst.packet_len;
 	/* Note that PDU uses 4 bits even though BLE DTM uses only 2
@@ -2043,7 +3532,6 @@ int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt)
 		memcpy(dtm_inst.current_pdu->content + header_len,
 		       dtm_prbs15_content, dtm_inst.packet_len);
 		break;
-		break;
 
 	case DTM_PACKET_FF:
 		dtm_inst.current_pdu->content[DTM_HEADER_OFFSET] =
@@ -2086,14 +3574,22 @@ int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt)
 		 * specific command to execute. The channel field
 		 * is used for vendor specific options to the command.
 		 */
-		return dtm_vendor_specific_pkt(length, channel);
+		err = dtm_vendor_specific_pkt(length, channel);
+
+		/* Only the carrier is a test, the other commands keep DTM idle. */
+		if (dtm_inst.state == STATE_IDLE) {
+			hfclk_idle();
+		}
+
+		return err;
 
 	default:
 		/* Parameter error */
+		hfclk_idle();
 		return -EINVAL;
 	}
 
-	if (dtm_inst.cte_info.mode != DTM_CTE_MODE_OFF) {
+	if (cte_active()) {
 		dtm_inst.current_pdu->content[DTM_HEADER_OFFSET] |=
 							DTM_PKT_CP_BIT;
 		dtm_inst.current_pdu->content[DTM_HEADER_CTEINFO_OFFSET] =
@@ -2125,6 +3621,10 @@ int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt)
 
 	radio_ppi_configure(false, 0);
 
+#if CONFIG_DTM_TX_STATS
+	tx_stats_start();
+#endif /* CONFIG_DTM_TX_STATS */
+
 	unsigned int key = irq_lock();
 	/* Trigger first radio and timer start. */
 	radio_start(false, true);
@@ -2134,47 +3634,488 @@ int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt)
 
 	irq_unlock(key);
 
-	dtm_inst.state = STATE_TRANSMITTER_TEST;
+	state_set(STATE_TRANSMITTER_TEST);
 	
-	/* Report TX test start via RTT */
-	printk("\n===== TX Test Started =====\n");
-	printk("Channel: %d (%d MHz)\n", channel, 2404 + channel * 2);
-	printk("Packet length: %d bytes\n", length);
-	printk("Packet type: %d\n\n", pkt);
+	/* Report TX test start - only in diagnostics mode */
+	DTM_DIAG("\n===== TX Test Started =====\n");
+	DTM_DIAG("Channel: %d (%d MHz)\n", channel, 2402 + channel * 2);
+	DTM_DIAG("Packet length: %d bytes\n", length);
+	DTM_DIAG("Packet type: %d\n\n", pkt);
 
 	return 0;
 }
 
-int dtm_test_end(uint16_t *pack_cnt)
+int dtm_test_transmit_burst(uint8_t channel, uint8_t length, enum dtm_packet pkt,
+			    uint32_t count, dtm_burst_done_callback_t cb)
 {
-	if (!pack_cnt) {
+#if CONFIG_DTM_TX_BURST
+	int err;
+
+	if ((count == 0) || (pkt == DTM_PACKET_FF_OR_VENDOR) || (pkt == DTM_PACKET_VENDOR)) {
 		return -EINVAL;
 	}
 
-	*pack_cnt = dtm_inst.rx_pkt_count;
-	
-	/* Report test results via RTT */
-	if (dtm_inst.state == STATE_RECEIVER_TEST) {
-		printk("\n===== RX Test Ended =====\n");
-		printk("Total packets received: %d\n", dtm_inst.rx_pkt_count);
-		printk("Total CRC errors: %d\n", dtm_inst.crc_error_count);
-		printk("Channel: %d (%d MHz)\n\n", 
-				  dtm_inst.phys_ch, 2404 + dtm_inst.phys_ch * 2);
+	dtm_inst.burst_count = count;
+	dtm_inst.burst_cb = cb;
+
+	err = dtm_test_transmit(channel, length, pkt);
+
+	/* The burst is armed when the transmission starts. */
+	dtm_inst.burst_count = 0;
+
+	return err;
+#else
+	ARG_UNUSED(channel);
+	ARG_UNUSED(length);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(count);
+	ARG_UNUSED(cb);
+
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_TX_BURST */
+}
+
+int dtm_test_receive_scan(const struct dtm_rx_scan_config *cfg)
+{
+#if CONFIG_DTM_RX_SCAN
+	struct rx_scan *scan = &dtm_inst.rx_scan;
+	unsigned int key;
+	uint8_t count = 0;
+	int err;
+
+	if (!cfg || (cfg->dwell_ms == 0)) {
+		return -EINVAL;
+	}
+
+	for (uint8_t ch = 0; ch <= PHYS_CH_MAX; ch++) {
+		if (cfg->channels[ch / 8] & BIT(ch % 8)) {
+			scan->channels[count++] = ch;
+		}
+	}
+
+	if (count == 0) {
+		return -EINVAL;
+	}
+
+	err = dtm_test_receive(scan->channels[0]);
+	if (err) {
+		return err;
+	}
+
+	key = irq_lock();
+
+	scan->count = count;
+	scan->idx = 0;
+	scan->hop_per_packet = cfg->hop_per_packet;
+	scan->hop_pending = false;
+	scan->hop_disabling = false;
+	scan->dwell = K_MSEC(cfg->dwell_ms);
+	memset(scan->stats, 0, sizeof(scan->stats));
+	memset(scan->rssi_sum, 0, sizeof(scan->rssi_sum));
+	memset(scan->rssi_cnt, 0, sizeof(scan->rssi_cnt));
+
+	/* The next channel is programmed before the receiver is restarted. */
+	rx_hw_rearm_set(false);
+
+	scan->active = true;
+
+	irq_unlock(key);
+
+	k_timer_start(&rx_scan_timer, scan->dwell, scan->dwell);
+
+	DTM_DIAG("Scanning %d channels, dwell %d ms%s\n", count, cfg->dwell_ms,
+		 cfg->hop_per_packet ? ", hop per packet" : "");
+
+	return 0;
+#else
+	ARG_UNUSED(cfg);
+
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_RX_SCAN */
+}
+
+int dtm_test_end(uint16_t *pack_cnt)
+{
+	if (!pack_cnt) {
+		return -EINVAL;
+	}
+
+	*pack_cnt = dtm_inst.rx_pkt_count;
+	
+	/* Report test results - only in diagnostics mode */
+	if (dtm_inst.state == STATE_RECEIVER_TEST) {
+		DTM_DIAG("\n===== RX Test Ended =====\n");
+		DTM_DIAG("Total packets received: %d\n", dtm_inst.rx_pkt_count);
+		DTM_DIAG("Total CRC errors: %d\n", dtm_inst.crc_error_count);
+		if (dtm_inst.rx_ring.overruns) {
+			DTM_DIAG("Packets dropped unchecked: %u\n", dtm_inst.rx_ring.overruns);
+		}
+		DTM_DIAG("Channel: %d (%d MHz)\n\n",
+			 dtm_inst.phys_ch, 2402 + dtm_inst.phys_ch * 2);
 	} else if (dtm_inst.state == STATE_TRANSMITTER_TEST) {
-		printk("\n===== TX Test Ended =====\n");
-		printk("Channel: %d (%d MHz)\n\n", 
-				  dtm_inst.phys_ch, 2404 + dtm_inst.phys_ch * 2);
+#if CONFIG_DTM_TX_STATS
+		tx_stats_collect();
+#endif /* CONFIG_DTM_TX_STATS */
+
+		DTM_DIAG("\n===== TX Test Ended =====\n");
+#if CONFIG_DTM_TX_STATS
+		DTM_DIAG("Total packets sent: %u\n", dtm_inst.tx_stats.packets);
+		DTM_DIAG("Packet interval: %u ns (nominal %u us)\n",
+			 dtm_inst.tx_stats.interval_ns, dtm_inst.tx_stats.nominal_us);
+#endif /* CONFIG_DTM_TX_STATS */
+		DTM_DIAG("Channel: %d (%d MHz)\n\n",
+			 dtm_inst.phys_ch, 2402 + dtm_inst.phys_ch * 2);
 	}
 	
 	dtm_test_done();
+	hfclk_idle();
+
+	return 0;
+}
+
+uint32_t dtm_packet_interval_get(uint8_t length)
+{
+	return dtm_packet_interval_calculate(length, dtm_inst.radio_mode);
+}
+
+int dtm_rx_stats_get(struct dtm_rx_stats *stats)
+{
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	stats->packets = dtm_inst.rx_pkt_count;
+	stats->crc_errors = dtm_inst.crc_error_count;
+
+	return 0;
+}
+
+int dtm_rx_scan_stats_get(struct dtm_rx_scan_stat *stats, size_t count)
+{
+#if CONFIG_DTM_RX_SCAN
+	unsigned int key;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	memcpy(stats, dtm_inst.rx_scan.stats,
+	       MIN(count, DTM_CHANNEL_COUNT) * sizeof(*stats));
+	irq_unlock(key);
+
+	return 0;
+#else
+	ARG_UNUSED(stats);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_RX_SCAN */
+}
+
+int dtm_rssi_sweep_start(const struct dtm_rssi_sweep_config *cfg, dtm_rssi_sweep_callback_t cb)
+{
+#if CONFIG_DTM_RSSI_SWEEP
+	struct rssi_sweep *sweep = &dtm_inst.rssi_sweep;
+	int err;
+
+	if (!cfg || ((cfg->step_mhz != 1) && (cfg->step_mhz != 2)) || (cfg->samples == 0)) {
+		return -EINVAL;
+	}
+
+	if ((dtm_inst.state != STATE_IDLE) || sweep->repeat ||
+	    k_work_is_pending(&rssi_sweep_work) || dtm_exec_test_start_check()) {
+		return -EBUSY;
+	}
+
+	err = hfclk_test_start();
+	if (err) {
+		return err;
+	}
+
+	memset(&sweep->result, 0, sizeof(sweep->result));
+	sweep->result.step_mhz = cfg->step_mhz;
+	sweep->result.start_mhz = (cfg->step_mhz == 1) ? 2400 : 2402;
+	sweep->result.count = (cfg->step_mhz == 1) ? DTM_RSSI_SWEEP_STEPS_MAX : DTM_CHANNEL_COUNT;
+	sweep->result.samples = cfg->samples;
+	sweep->cb = cb;
+	sweep->repeat = cfg->repeat;
+
+	rssi_sweep_begin();
+
+	return 0;
+#else
+	ARG_UNUSED(cfg);
+	ARG_UNUSED(cb);
+
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_RSSI_SWEEP */
+}
+
+void dtm_rssi_sweep_stop(void)
+{
+	rssi_sweep_abort();
+}
+
+int dtm_rssi_sweep_get(struct dtm_rssi_sweep *sweep)
+{
+#if CONFIG_DTM_RSSI_SWEEP
+	if (!sweep) {
+		return -EINVAL;
+	}
+
+	if (dtm_inst.state == STATE_RSSI_SWEEP) {
+		return -EBUSY;
+	}
+
+	*sweep = dtm_inst.rssi_sweep.result;
+
+	return 0;
+#else
+	ARG_UNUSED(sweep);
+
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_RSSI_SWEEP */
+}
+
+int dtm_tx_power_cal_set(const int8_t *offsets, size_t count)
+{
+#if !CONFIG_DTM_POWER_CONTROL_AUTOMATIC
+	if (!offsets || (count > dtm_hw_radio_power_array_size_get())) {
+		return -EINVAL;
+	}
+
+	if (dtm_inst.state > STATE_IDLE) {
+		/* Radio must be idle to change the output power levels. */
+		return -EBUSY;
+	}
+
+	memset(dtm_inst.power_cal, 0, sizeof(dtm_inst.power_cal));
+	memcpy(dtm_inst.power_cal, offsets, count);
+
+	/* The table is built in dtm_init() when the calibration is loaded at boot. */
+	if (dtm_inst.state == STATE_IDLE) {
+		power_lut_build();
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(offsets);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+#endif /* !CONFIG_DTM_POWER_CONTROL_AUTOMATIC */
+}
+
+int dtm_tx_power_cal_get(int8_t *offsets, size_t count)
+{
+#if !CONFIG_DTM_POWER_CONTROL_AUTOMATIC
+	size_t size = dtm_hw_radio_power_array_size_get();
+
+	if (!offsets) {
+		return -EINVAL;
+	}
+
+	count = MIN(count, size);
+	memcpy(offsets, dtm_inst.power_cal, count);
+
+	return count;
+#else
+	ARG_UNUSED(offsets);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+#endif /* !CONFIG_DTM_POWER_CONTROL_AUTOMATIC */
+}
+
+int dtm_tx_power_comp_set(const int8_t *comp, size_t count)
+{
+	if (!comp || (count > DTM_CHANNEL_COUNT)) {
+		return -EINVAL;
+	}
+
+	if (dtm_inst.state > STATE_IDLE) {
+		/* Radio must be idle to change the output power levels. */
+		return -EBUSY;
+	}
+
+	memset(dtm_inst.power_comp, 0, sizeof(dtm_inst.power_comp));
+	memcpy(dtm_inst.power_comp, comp, count);
+
+	/* The table is built in dtm_init() when the compensation is loaded at boot. */
+	if (dtm_inst.state == STATE_IDLE) {
+		power_lut_build();
+	}
+
+	return 0;
+}
+
+int dtm_tx_power_comp_get(int8_t *comp, size_t count)
+{
+	if (!comp) {
+		return -EINVAL;
+	}
+
+	count = MIN(count, DTM_CHANNEL_COUNT);
+	memcpy(comp, dtm_inst.power_comp, count);
+
+	return count;
+}
+
+int dtm_tx_stats_get(struct dtm_tx_stats *stats)
+{
+#if CONFIG_DTM_TX_STATS
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	*stats = dtm_inst.tx_stats;
+
+	return 0;
+#else
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_TX_STATS */
+}
+
+#if CONFIG_DTM_RX_TIMING
+static uint32_t meas_ticks_to_ns(uint64_t ticks)
+{
+	return (uint32_t)((ticks * 1000) / MEAS_TIMER_TICKS_PER_US);
+}
+
+static uint32_t isqrt64(uint64_t val)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > val) {
+		bit >>= 2;
+	}
+
+	while (bit) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)res;
+}
+
+/* Update the packet timing with the timestamps captured for the last packet.
+ * Only the packets with a valid CRC are used, the length of a corrupted
+ * packet is unknown.
+ */
+static void rx_timing_update(uint32_t address_ts, uint32_t end_ts,
+			     const struct dtm_pdu *pdu)
+{
+	struct rx_timing *timing = &dtm_inst.rx_timing;
+	uint8_t len = pdu->content[DTM_LENGTH_OFFSET];
+	uint32_t delta;
+	uint32_t periods;
+	int32_t jitter;
+	int32_t bin;
+
+	timing->airtime_max = MAX(timing->airtime_max, end_ts - address_ts);
+
+	if ((timing->nominal == 0) || (len != timing->last_len)) {
+		/* First packet or new packet length, restart the intervals. */
+		timing->nominal = dtm_packet_interval_calculate(len, dtm_inst.radio_mode) *
+				  MEAS_TIMER_TICKS_PER_US;
+		timing->last_len = len;
+		timing->last_ts = address_ts;
+		return;
+	}
+
+	/* Unsigned arithmetic handles the timer wrap-around. */
+	delta = address_ts - timing->last_ts;
+	timing->last_ts = address_ts;
+
+	periods = MAX(1, (delta + (timing->nominal / 2)) / timing->nominal);
+	jitter = (int32_t)(delta - (periods * timing->nominal));
+
+	timing->intervals++;
+	timing->missed += periods - 1;
+	timing->jitter_min = MIN(timing->jitter_min, jitter);
+	timing->jitter_max = MAX(timing->jitter_max, jitter);
+	timing->jitter_sum += jitter;
+	timing->jitter_sq_sum += (uint64_t)((int64_t)jitter * jitter);
+
+	bin = (jitter / (int32_t)RX_TIMING_HIST_BIN_TICKS) + (DTM_RX_TIMING_HIST_BINS / 2);
+	if (jitter < 0) {
+		/* Round towards negative infinity. */
+		bin -= ((jitter % (int32_t)RX_TIMING_HIST_BIN_TICKS) != 0);
+	}
+	timing->hist[CLAMP(bin, 0, DTM_RX_TIMING_HIST_BINS - 1)]++;
+}
+
+int dtm_rx_timing_get(struct dtm_rx_timing *timing)
+{
+	struct rx_timing tmp;
+	unsigned int key;
+	int64_t avg;
+	uint64_t var;
+
+	if (!timing) {
+		return -EINVAL;
+	}
+
+	/* The statistics are updated from the radio interrupt. */
+	key = irq_lock();
+	tmp = dtm_inst.rx_timing;
+	irq_unlock(key);
+
+	memset(timing, 0, sizeof(*timing));
+	timing->nominal_ns = meas_ticks_to_ns(tmp.nominal);
+	timing->airtime_max_ns = meas_ticks_to_ns(tmp.airtime_max);
+	memcpy(timing->hist, tmp.hist, sizeof(timing->hist));
+
+	if (tmp.intervals == 0) {
+		return 0;
+	}
+
+	avg = tmp.jitter_sum / tmp.intervals;
+	var = tmp.jitter_sq_sum / tmp.intervals;
+	/* Guard against the rounding of the integer average. */
+	var = (var > (uint64_t)(avg * avg)) ? (var - (uint64_t)(avg * avg)) : 0;
+
+	timing->intervals = tmp.intervals;
+	timing->missed = tmp.missed;
+	timing->jitter_avg_ns = (int32_t)((avg * 1000) / MEAS_TIMER_TICKS_PER_US);
+	timing->jitter_min_ns = (tmp.jitter_min * 1000) / MEAS_TIMER_TICKS_PER_US;
+	timing->jitter_max_ns = (tmp.jitter_max * 1000) / MEAS_TIMER_TICKS_PER_US;
+	timing->jitter_std_ns = meas_ticks_to_ns(isqrt64(var));
+	timing->drift_ppm = (int32_t)((tmp.jitter_sum * 1000000) /
+				      ((int64_t)tmp.nominal * tmp.intervals));
 
 	return 0;
 }
+#else
+int dtm_rx_timing_get(struct dtm_rx_timing *timing)
+{
+	ARG_UNUSED(timing);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_DTM_RX_TIMING */
 
+/* Move the packet pointer to the next buffer of the ring. The radio takes the
+ * new pointer on the next START task, so a received packet stays in its buffer
+ * until the ring wraps around.
+ */
 static struct dtm_pdu *radio_buffer_swap(void)
 {
 	struct dtm_pdu *received_pdu = dtm_inst.current_pdu;
-	uint32_t packet_index = (dtm_inst.current_pdu == dtm_inst.pdu);
+	size_t packet_index = (received_pdu - dtm_inst.pdu) + 1;
+
+	if (packet_index == ARRAY_SIZE(dtm_inst.pdu)) {
+		packet_index = 0;
+	}
 
 	dtm_inst.current_pdu = &dtm_inst.pdu[packet_index];
 
@@ -2183,271 +4124,317 @@ static struct dtm_pdu *radio_buffer_swap(void)
 	return received_pdu;
 }
 
-static void on_radio_end_event(void)
+/* Print summary every 10 packets or every 2 seconds. */
+static void rx_packet_report(int8_t rssi)
 {
-	if (dtm_inst.state != STATE_RECEIVER_TEST) {
+	uint32_t now = k_uptime_get_32();
+	uint32_t elapsed = now - dtm_inst.last_report_time;
+	bool should_report = (dtm_inst.rx_pkt_count % 10 == 0) || (elapsed >= 2000);
+
+	/* Also report if this is the first packet */
+	if (dtm_inst.rx_pkt_count == 1) {
+		should_report = true;
+	}
+
+	if (!should_report) {
 		return;
 	}
-	
-	/* Debug: Increment a counter for every END event */
-	static uint32_t end_event_count = 0;
-	static uint32_t last_debug_time = 0;
-	end_event_count++;
-	
-	/* Print debug info every 2 seconds */
-	#if !EMC_TEST_MODE
-	uint32_t now = k_uptime_get_32();
-	if ((now - last_debug_time) >= 2000) {
-		printk("[DEBUG] Radio END events: %d, State: %d, Ch: %d\n", 
-		       end_event_count, dtm_inst.state, dtm_inst.phys_ch);
-		last_debug_time = now;
-	}
-	#endif
-
-	struct dtm_pdu *received_pdu = radio_buffer_swap();
-
-	radio_start(true, false);
-
-#if NRF52_ERRATA_172_PRESENT
-	if (dtm_inst.anomaly_172_wa_enabled) {
-		nrfx_timer_compare(&dtm_inst.anomaly_timer,
-			NRF_TIMER_CC_CHANNEL0,
-			nrfx_timer_ms_to_ticks(
-				&dtm_inst.anomaly_timer,
-				BLOCKER_FIX_WAIT_DEFAULT),
-			true);
-		nrfx_timer_compare(&dtm_inst.anomaly_timer,
-			NRF_TIMER_CC_CHANNEL1,
-			nrfx_timer_us_to_ticks(
-				&dtm_inst.anomaly_timer,
-				BLOCKER_FIX_WAIT_END),
-			true);
-		nrf_timer_event_clear(dtm_inst.anomaly_timer.p_reg,
-				      NRF_TIMER_EVENT_COMPARE0);
-		nrf_timer_event_clear(dtm_inst.anomaly_timer.p_reg,
-				      NRF_TIMER_EVENT_COMPARE1);
-		nrfx_timer_clear(&dtm_inst.anomaly_timer);
-		nrfx_timer_enable(&dtm_inst.anomaly_timer);
-	}
-#endif /* NRF52_ERRATA_172_PRESENT */
-
-	/* Debug: Check if we're getting here */
-	bool crc_ok = nrf_radio_crc_status_check(NRF_RADIO);
+
+	/* Calculate packet rate if time has elapsed */
+	if (elapsed >= 1000) {
+		uint32_t pkt_diff = dtm_inst.rx_pkt_count - dtm_inst.last_report_count;
+		uint32_t pkt_per_sec = (pkt_diff * 1000) / elapsed;
+
+		printk("[RX] Ch:%02d | Total:%5d | Rate:%4d pkt/s | RSSI:%3d dBm | Errors:%d\n",
+		       dtm_inst.phys_ch, dtm_inst.rx_pkt_count,
+		       pkt_per_sec, rssi, dtm_inst.crc_error_count);
+
+		dtm_inst.last_report_time = now;
+		dtm_inst.last_report_count = dtm_inst.rx_pkt_count;
+	} else {
+		/* Just packet count update */
+		printk("[RX] Ch:%02d | Total:%5d | RSSI:%3d dBm | Errors:%d\n",
+		       dtm_inst.phys_ch, dtm_inst.rx_pkt_count,
+		       rssi, dtm_inst.crc_error_count);
+	}
+}
+
+/* Check and count a packet captured in the radio END handling. */
+static void rx_capture_process(const struct rx_capture *cap)
+{
+	bool diag = !dtm_config_quiet_get();
 	bool pdu_ok = false;
-	if (crc_ok) {
-		pdu_ok = check_pdu(received_pdu);
+
+#if CONFIG_DTM_RX_SCAN
+	if (cap->hopped) {
+		/* The new channel gets the full dwell time. */
+		k_timer_start(&rx_scan_timer, dtm_inst.rx_scan.dwell, dtm_inst.rx_scan.dwell);
 	}
-	
-	if (crc_ok && pdu_ok) {
+#endif /* CONFIG_DTM_RX_SCAN */
+
+	if (cap->crc_ok) {
+		uint32_t pdu_start = dtm_isr_stats_start();
+
+		pdu_ok = check_pdu(cap->pdu);
+		dtm_isr_stats_record(DTM_ISR_CHECK_PDU, pdu_start);
+	}
+
+#if CONFIG_DTM_RX_TIMING
+	if (cap->crc_ok) {
+		rx_timing_update(cap->address_ts, cap->end_ts, cap->pdu);
+	}
+#endif /* CONFIG_DTM_RX_TIMING */
+
+#if CONFIG_DTM_RX_SCAN
+	if (dtm_inst.rx_scan.active && (pdu_ok || !cap->crc_ok)) {
+		rx_scan_record(cap->channel, cap->crc_ok, cap->rssi);
+	}
+#endif /* CONFIG_DTM_RX_SCAN */
+
+	if (cap->crc_ok && pdu_ok) {
 		/* Count the number of successfully received
 		 * packets.
 		 */
 		dtm_inst.rx_pkt_count++;
-		
-		/* Get current time and RSSI */
-		uint32_t now = k_uptime_get_32();
-		/* RSSI must be sampled after packet reception, get the actual value */
-		nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_RSSISTART);
-		while (!nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND)) {
-			/* Wait for RSSI measurement */
-		}
-		int8_t rssi = -(int8_t)nrf_radio_rssi_sample_get(NRF_RADIO);
-		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
-		
-		/* Print summary every 10 packets or every 2 seconds */
-		bool should_report = (dtm_inst.rx_pkt_count % 10 == 0) ||
-				     ((now - dtm_inst.last_report_time) >= 2000);
-		
-		/* Packet reporting - only in debug mode to avoid EMI during EMC testing */
-#ifndef EMC_TEST_MODE
-		/* Also report if this is the first packet */
-		if (dtm_inst.rx_pkt_count == 1) {
-			should_report = true;
-			printk("[DEBUG] First packet received!\n");
-		}
-		
-		if (should_report) {
-			/* Calculate packet rate if time has elapsed */
-			if ((now - dtm_inst.last_report_time) >= 1000) {
-				uint32_t time_diff_ms = now - dtm_inst.last_report_time;
-				uint32_t pkt_diff = dtm_inst.rx_pkt_count - dtm_inst.last_report_count;
-				uint32_t pkt_per_sec = (pkt_diff * 1000) / time_diff_ms;
-				
-				printk("[RX] Ch:%02d | Total:%5d | Rate:%4d pkt/s | RSSI:%3d dBm | Errors:%d\n", 
-						  dtm_inst.phys_ch, dtm_inst.rx_pkt_count, 
-						  pkt_per_sec, rssi, dtm_inst.crc_error_count);
-				
-				dtm_inst.last_report_time = now;
-				dtm_inst.last_report_count = dtm_inst.rx_pkt_count;
-			} else {
-				/* Just packet count update */
-				printk("[RX] Ch:%02d | Total:%5d | RSSI:%3d dBm | Errors:%d\n", 
-						  dtm_inst.phys_ch, dtm_inst.rx_pkt_count, 
-						  rssi, dtm_inst.crc_error_count);
-			}
+		dtm_rssi_stats_record(DTM_RSSI_CLASS_GOOD, cap->rssi);
+
+		/* Packet reporting only in diagnostics mode, so there is no
+		 * console activity during EMC testing.
+		 */
+		if (diag) {
+			rx_packet_report(cap->rssi);
 		}
-#endif
-	} else {
+	} else if (!cap->crc_ok) {
 		/* Count CRC errors */
-		if (!nrf_radio_crc_status_check(NRF_RADIO)) {
-			dtm_inst.crc_error_count++;
-			
-			/* Report first few CRC errors for debugging - only in debug mode */
-#ifndef EMC_TEST_MODE
-			if (dtm_inst.crc_error_count <= 5) {
-				/* Get RSSI for CRC error */
-				nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_RSSISTART);
-				while (!nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND)) {
-					/* Wait */
-				}
-				int8_t rssi = -(int8_t)nrf_radio_rssi_sample_get(NRF_RADIO);
-				nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
-				printk("[RX] Ch:%02d | CRC ERROR #%d | RSSI:%3d dBm\n", 
-				       dtm_inst.phys_ch, dtm_inst.crc_error_count, rssi);
-			}
-#endif
+		dtm_inst.crc_error_count++;
+		dtm_rssi_stats_record(DTM_RSSI_CLASS_CRC_ERROR, cap->rssi);
+
+		/* Report first few CRC errors for debugging */
+		if (diag && (dtm_inst.crc_error_count <= 5)) {
+			printk("[RX] Ch:%02d | CRC ERROR #%d | RSSI:%3d dBm\n",
+			       cap->channel, dtm_inst.crc_error_count, cap->rssi);
 		}
 	}
 
 	/* Note that failing packets are simply ignored (CRC or
 	 * contents error).
 	 */
+	dtm_telemetry_rx(cap->crc_ok && pdu_ok, cap->crc_ok, cap->rssi);
 
 	/* Zero fill all pdu fields to avoid stray data */
-	memset(received_pdu, 0, DTM_PDU_MAX_MEMORY_SIZE);
+	memset(cap->pdu, 0, DTM_PDU_MAX_MEMORY_SIZE);
+
+	if (cap->restart) {
+		radio_start(true, false);
+	}
 }
 
-static void radio_handler(const void *context)
+/* Radio END handling in the radio interrupt. Only the radio and the timers are
+ * accessed, the packet is captured into the ring and checked in the deferred
+ * processing.
+ */
+static void on_radio_end_event(void)
 {
-	/* Debug counter for handler calls - only in debug mode */
-#ifndef EMC_TEST_MODE
-	static uint32_t handler_count = 0;
-	handler_count++;
-	if (handler_count % 1000 == 0) {
-		printk("[DEBUG] Radio handler called %d times\n", handler_count);
+	if (dtm_inst.state != STATE_RECEIVER_TEST) {
+		return;
 	}
-#endif
-	
-	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS)) {
-		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS);
-#if NRF52_ERRATA_172_PRESENT
-		if (dtm_inst.state == STATE_RECEIVER_TEST &&
-		    dtm_inst.anomaly_172_wa_enabled) {
-			nrfx_timer_disable(&dtm_inst.anomaly_timer);
+
+	uint32_t isr_start = dtm_isr_stats_start();
+	struct rx_ring *ring = &dtm_inst.rx_ring;
+	uint32_t head = ring->head;
+	struct rx_capture *cap = &ring->buf[head % ARRAY_SIZE(ring->buf)];
+	bool restart;
+
+	/* The radio receives into the only free buffer, the packet is dropped
+	 * when the deferred processing does not keep up. It is also dropped
+	 * when the receiver restarted in hardware already receives into its
+	 * buffer, the buffer is then kept for the reception in progress.
+	 */
+	if (((head - ring->tail) >= (ARRAY_SIZE(ring->buf) - 1)) || rx_hw_rearm_late()) {
+		ring->overruns++;
+		if (!rx_hw_rearm_active()) {
+			radio_start(true, false);
 		}
-#endif /* NRF52_ERRATA_172_PRESENT */
+
+		dtm_isr_stats_record(DTM_ISR_RADIO_END, isr_start);
+		return;
 	}
 
-	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_END)) {
-		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_END);
+	/* When the receiver is restarted in hardware, the new packet pointer
+	 * must be set before the receiver is ready, and the CRC status is only
+	 * valid until the end of the next packet.
+	 */
+	cap->pdu = radio_buffer_swap();
+	cap->crc_ok = nrf_radio_crc_status_check(NRF_RADIO);
+	cap->channel = dtm_inst.phys_ch;
+	cap->rssi = -(int8_t)nrf_radio_rssi_sample_get(NRF_RADIO);
+	cap->hopped = false;
+
+#if CONFIG_DTM_RX_TIMING
+	/* Read the captures before the next packet is received. */
+	cap->address_ts = nrf_timer_cc_get(dtm_inst.meas_timer.p_reg, MEAS_TIMER_CC_ADDRESS);
+	cap->end_ts = nrf_timer_cc_get(dtm_inst.meas_timer.p_reg, MEAS_TIMER_CC_END);
+#endif /* CONFIG_DTM_RX_TIMING */
+
+#if CONFIG_DTM_RX_SCAN
+	if (dtm_inst.rx_scan.active) {
+		cap->hopped = rx_scan_rearm();
+	}
+#endif /* CONFIG_DTM_RX_SCAN */
 
-		NVIC_ClearPendingIRQ(RADIO_IRQn);
+	/* The IQ samples of the packet are reported in the deferred processing,
+	 * the next CTE must not overwrite them.
+	 */
+	restart = !rx_hw_rearm_active();
+	cap->restart = restart && IS_ENABLED(CONFIG_DTM_RADIO_ZLI) && cte_active();
 
-		on_radio_end_event();
+	if (restart && !cap->restart) {
+		radio_start(true, false);
 	}
 
-	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_READY)) {
-		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_READY);
+	/* Publish the capture after it is complete. */
+	compiler_barrier();
+	ring->head = head + 1;
 
-#if NRF52_ERRATA_172_PRESENT
-		if (dtm_inst.state == STATE_RECEIVER_TEST &&
-		    dtm_inst.anomaly_172_wa_enabled) {
-			nrfx_timer_clear(&dtm_inst.anomaly_timer);
-			if (!nrfx_timer_is_enabled(&dtm_inst.anomaly_timer)) {
-				nrfx_timer_enable(&dtm_inst.anomaly_timer);
-			}
-		}
-#endif /* NRF52_ERRATA_172_PRESENT */
+	radio_defer();
+
+	dtm_isr_stats_record(DTM_ISR_RADIO_END, isr_start);
+}
+
+/* Processing deferred from the radio interrupt. With CONFIG_DTM_RADIO_ZLI it
+ * runs in the EGU interrupt, which can use the kernel, otherwise it is called
+ * at the end of the radio interrupt.
+ */
+static void radio_deferred_handler(const void *context)
+{
+	struct rx_ring *ring = &dtm_inst.rx_ring;
+	uint32_t isr_start = dtm_isr_stats_start();
+
+	ARG_UNUSED(context);
+
+#if CONFIG_DTM_RADIO_ZLI
+	nrf_egu_event_clear(DTM_EGU, DTM_EGU_DEFER_EVENT);
+#endif /* CONFIG_DTM_RADIO_ZLI */
+
+#if CONFIG_DTM_RSSI_SWEEP
+	if (dtm_inst.rssi_sweep.done) {
+		dtm_inst.rssi_sweep.done = false;
+		rssi_sweep_done();
 	}
+#endif /* CONFIG_DTM_RSSI_SWEEP */
 
-	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND)) {
-		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_RSSIEND);
+	while (ring->tail != ring->head) {
+		rx_capture_process(&ring->buf[ring->tail % ARRAY_SIZE(ring->buf)]);
+
+		/* Release the buffer after the packet is checked. */
+		compiler_barrier();
+		ring->tail++;
 	}
+
+	dtm_isr_stats_record(DTM_ISR_RADIO_DEFERRED, isr_start);
 }
 
-static void dtm_timer_handler(nrf_timer_event_t event_type, void *context)
+static void radio_defer(void)
 {
-	// Do nothing
+#if CONFIG_DTM_RADIO_ZLI
+	nrf_egu_task_trigger(DTM_EGU, DTM_EGU_DEFER_TASK);
+#else
+	radio_deferred_handler(NULL);
+#endif /* CONFIG_DTM_RADIO_ZLI */
 }
 
-#if NRF52_ERRATA_172_PRESENT
-static void anomaly_timer_handler(nrf_timer_event_t event_type, void *context)
+/* Radio interrupt handler. With CONFIG_DTM_RADIO_ZLI it runs as a zero-latency
+ * interrupt and must not call the kernel, the rest of the work is deferred
+ * with radio_defer().
+ */
+static void radio_handler(const void *context)
 {
-	switch (event_type) {
-	case NRF_TIMER_EVENT_COMPARE0:
-	{
-		uint8_t rssi = anomaly_172_rssi_check();
+	uint32_t isr_start = dtm_isr_stats_start();
 
-		if (dtm_inst.strict_mode) {
-			if (rssi > BLOCKER_FIX_RSSI_THRESHOLD) {
-				anomaly_172_strict_mode_set(false);
-			}
-		} else {
-			bool too_many_detects = false;
-			uint32_t packetcnt2 = *(volatile uint32_t *) 0x40001574;
-			uint32_t detect_cnt = packetcnt2 & 0xffff;
-			uint32_t addr_cnt = (packetcnt2 >> 16) & 0xffff;
+#if CONFIG_DTM_RSSI_SWEEP
+	if (dtm_inst.state == STATE_RSSI_SWEEP) {
+		rssi_sweep_handler();
+		dtm_isr_stats_record(DTM_ISR_RADIO, isr_start);
+		return;
+	}
+#endif /* CONFIG_DTM_RSSI_SWEEP */
 
-			if ((detect_cnt > BLOCKER_FIX_CNTDETECTTHR) &&
-			    (addr_cnt < BLOCKER_FIX_CNTADDRTHR)) {
-				too_many_detects = true;
-			}
+	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS)) {
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS);
+	}
 
-			if ((rssi < BLOCKER_FIX_RSSI_THRESHOLD) ||
-			    too_many_detects) {
-				anomaly_172_strict_mode_set(true);
-			}
+	if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_END)) {
+		nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_END);
+
+		NVIC_ClearPendingIRQ(RADIO_IRQn);
+
+		if (dtm_inst.state == STATE_TRANSMITTER_TEST) {
+			dtm_telemetry_tx();
 		}
 
-		anomaly_172_radio_operation();
+		on_radio_end_event();
+	}
 
-		nrfx_timer_disable(&dtm_inst.anomaly_timer);
+#if CONFIG_DTM_RX_SCAN
+	if (dtm_inst.state == STATE_RECEIVER_TEST) {
+		rx_scan_radio_handler();
+	}
+#endif /* CONFIG_DTM_RX_SCAN */
 
-		nrfx_timer_compare(&dtm_inst.anomaly_timer,
-			NRF_TIMER_CC_CHANNEL0,
-			nrfx_timer_ms_to_ticks(&dtm_inst.anomaly_timer,
-					       BLOCKER_FIX_WAIT_DEFAULT),
-			true);
+	dtm_isr_stats_record(DTM_ISR_RADIO, isr_start);
+}
 
-		nrfx_timer_clear(&dtm_inst.anomaly_timer);
-		nrf_timer_event_clear(dtm_inst.anomaly_timer.p_reg,
-				      NRF_TIMER_EVENT_COMPARE0);
-		nrfx_timer_enable(&dtm_inst.anomaly_timer);
+#if CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED
+/* EGU interrupt handler: the processing deferred from the zero-latency radio
+ * interrupt and the anomaly 172 RSSI samples.
+ */
+static void egu_handler(const void *context)
+{
+#if DTM_ANOMALY_172_ENABLED
+	if (nrf_egu_event_check(DTM_EGU, DTM_EGU_ANOMALY_DEFAULT_EVENT) ||
+	    nrf_egu_event_check(DTM_EGU, DTM_EGU_ANOMALY_END_EVENT)) {
+		uint32_t anomaly_start = dtm_isr_stats_start();
+
+		anomaly_172_rssi_handle();
+		dtm_isr_stats_record(DTM_ISR_ANOMALY_172, anomaly_start);
+	}
+#endif /* DTM_ANOMALY_172_ENABLED */
 
-		NRFX_IRQ_PENDING_CLEAR(
-			nrfx_get_irq_number(dtm_inst.anomaly_timer.p_reg));
-	} break;
+#if CONFIG_DTM_RADIO_ZLI
+	if (nrf_egu_event_check(DTM_EGU, DTM_EGU_DEFER_EVENT)) {
+		radio_deferred_handler(context);
+	}
+#endif /* CONFIG_DTM_RADIO_ZLI */
+}
+#endif /* CONFIG_DTM_RADIO_ZLI || DTM_ANOMALY_172_ENABLED */
 
-	case NRF_TIMER_EVENT_COMPARE1:
-	{
-		uint8_t rssi = anomaly_172_rssi_check();
+#if CONFIG_DTM_RADIO_ZLI
+ISR_DIRECT_DECLARE(radio_zli_handler)
+{
+	radio_handler(NULL);
 
-		if (dtm_inst.strict_mode) {
-			if (rssi >= BLOCKER_FIX_RSSI_THRESHOLD) {
-				anomaly_172_strict_mode_set(false);
-			}
-		} else {
-			if (rssi < BLOCKER_FIX_RSSI_THRESHOLD) {
-				anomaly_172_strict_mode_set(true);
-			}
-		}
+	/* No kernel object is used, there is nothing to reschedule. */
+	return 0;
+}
+#endif /* CONFIG_DTM_RADIO_ZLI */
 
-		anomaly_172_radio_operation();
+static void dtm_timer_handler(nrf_timer_event_t event_type, void *context)
+{
+	// Do nothing
+}
 
-		nrf_timer_event_clear(dtm_inst.anomaly_timer.p_reg,
-				      NRF_TIMER_EVENT_COMPARE1);
-		/* Disable this event. */
-		nrfx_timer_compare(&dtm_inst.anomaly_timer,
-				   NRF_TIMER_CC_CHANNEL1,
-				   0,
-				   false);
+#if CONFIG_DTM_TX_BURST
+static void counter_timer_handler(nrf_timer_event_t event_type, void *context)
+{
+	if (event_type != nrf_timer_compare_event_get(COUNTER_CC_BURST)) {
+		return;
+	}
 
-		NRFX_IRQ_PENDING_CLEAR(
-			nrfx_get_irq_number(dtm_inst.anomaly_timer.p_reg));
-	} break;
+	nrfx_timer_compare_int_disable(&dtm_inst.counter_timer, COUNTER_CC_BURST);
 
-	default:
-		break;
+	if (dtm_inst.burst_cb) {
+		dtm_inst.burst_cb(nrf_timer_cc_get(dtm_inst.counter_timer.p_reg,
+						   COUNTER_CC_BURST));
 	}
 }
-#endif /* NRF52_ERRATA_172_PRESENT */
+#endif /* CONFIG_DTM_TX_BURST */
@@ -8,7 +8,9 @@
 #define DTM_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <zephyr/types.h>
+#include <zephyr/toolchain.h>
 #include <zephyr/devicetree.h>
 
 #ifdef __cplusplus
@@ -17,6 +19,18 @@ extern "C" {
 
 #define NRF_IQ_SAMPLE_INVALID -32768
 
+/** Number of bins of the receiver packet interval jitter histogram. */
+#define DTM_RX_TIMING_HIST_BINS 16
+
+/** Number of DTM channels. */
+#define DTM_CHANNEL_COUNT 40
+
+/** Maximum number of frequencies of an RSSI sweep, 2400 to 2480 MHz in 1 MHz steps. */
+#define DTM_RSSI_SWEEP_STEPS_MAX 81
+
+/** Maximum number of radio output power levels with a calibration offset. */
+#define DTM_TX_POWER_CAL_MAX 24
+
 /** @brief DTM PHY mode */
 enum dtm_phy {
 	/** Bluetooth Low Energy 1 Mbps PHY. */
@@ -95,6 +109,153 @@ enum dtm_tx_power_request {
 	DTM_TX_POWER_REQUEST_VAL
 };
 
+/** @brief DTM receiver test statistics. */
+struct dtm_rx_stats {
+	/** Number of packets received with a valid CRC and payload. */
+	uint16_t packets;
+
+	/** Number of packets received with an invalid CRC. */
+	uint32_t crc_errors;
+};
+
+/** @brief DTM transmitter test statistics.
+ *
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_tx_stats {
+	/** Number of packets sent. */
+	uint32_t packets;
+
+	/** Nominal packet interval in microseconds. */
+	uint32_t nominal_us;
+
+	/** Measured average packet interval in nanoseconds. */
+	uint32_t interval_ns;
+
+	/** Time from the ADDRESS to the END event of the last packet in nanoseconds. */
+	uint32_t airtime_ns;
+} __packed;
+
+/** @brief DTM receiver packet timing statistics.
+ *
+ * The packet intervals are measured between the radio ADDRESS events of
+ * consecutive packets received with a valid CRC. The jitter is the deviation
+ * of an interval from the nearest multiple of the nominal packet interval.
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_rx_timing {
+	/** Number of measured packet intervals. */
+	uint32_t intervals;
+
+	/** Nominal packet interval in nanoseconds. */
+	uint32_t nominal_ns;
+
+	/** Number of packets missed between the measured intervals. */
+	uint32_t missed;
+
+	/** Average jitter in nanoseconds. */
+	int32_t jitter_avg_ns;
+
+	/** Smallest jitter in nanoseconds. */
+	int32_t jitter_min_ns;
+
+	/** Largest jitter in nanoseconds. */
+	int32_t jitter_max_ns;
+
+	/** Standard deviation of the jitter in nanoseconds. */
+	uint32_t jitter_std_ns;
+
+	/** Transmitter clock drift estimated from the average jitter, in ppm. */
+	int32_t drift_ppm;
+
+	/** Longest time from the ADDRESS to the END event in nanoseconds. */
+	uint32_t airtime_max_ns;
+
+	/** Jitter histogram. The bins are CONFIG_DTM_RX_TIMING_HIST_BIN_NS wide,
+	 *  centered on zero jitter. The first and the last bin also count the
+	 *  jitter outside the histogram range.
+	 */
+	uint32_t hist[DTM_RX_TIMING_HIST_BINS];
+} __packed;
+
+/** @brief DTM receiver scan configuration.
+ *
+ * The structure is also the wire format of the configuration, little-endian.
+ */
+struct dtm_rx_scan_config {
+	/** Channels to scan, bit n selects the DTM channel n. */
+	uint8_t channels[5];
+
+	/** Time spent on a channel in milliseconds. */
+	uint16_t dwell_ms;
+
+	/** Hop to the next channel after each received packet,
+	 *  or at the latest after the dwell time.
+	 */
+	uint8_t hop_per_packet;
+} __packed;
+
+/** @brief DTM receiver scan statistics of a channel.
+ *
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_rx_scan_stat {
+	/** Number of packets received with a valid CRC and payload. */
+	uint16_t packets;
+
+	/** Number of packets received with an invalid CRC. */
+	uint16_t crc_errors;
+
+	/** Average RSSI of the received packets in dBm, 0 if no packet was received. */
+	int8_t rssi_avg;
+
+	/** Highest RSSI of the received packets in dBm, 0 if no packet was received. */
+	int8_t rssi_max;
+} __packed;
+
+/** @brief DTM RSSI sweep configuration.
+ *
+ * The structure is also the wire format of the configuration.
+ */
+struct dtm_rssi_sweep_config {
+	/** Frequency step in MHz. 2 sweeps the 40 DTM channels from 2402 MHz,
+	 *  1 sweeps the 81 frequencies from 2400 MHz.
+	 */
+	uint8_t step_mhz;
+
+	/** Number of RSSI samples per frequency, at least 1. */
+	uint8_t samples;
+
+	/** Restart the sweep when it ends, until dtm_rssi_sweep_stop() is called. */
+	uint8_t repeat;
+} __packed;
+
+/** @brief DTM RSSI sweep result. */
+struct dtm_rssi_sweep {
+	/** Number of the sweep since it was started, from 1. */
+	uint32_t seq;
+
+	/** Duration of the sweep in microseconds. */
+	uint32_t duration_us;
+
+	/** Frequency of the first step in MHz. */
+	uint16_t start_mhz;
+
+	/** Frequency step in MHz. */
+	uint8_t step_mhz;
+
+	/** Number of frequencies. */
+	uint8_t count;
+
+	/** Number of RSSI samples per frequency. */
+	uint8_t samples;
+
+	/** Lowest, average and highest RSSI of each frequency in dBm. */
+	int8_t min[DTM_RSSI_SWEEP_STEPS_MAX];
+	int8_t avg[DTM_RSSI_SWEEP_STEPS_MAX];
+	int8_t max[DTM_RSSI_SWEEP_STEPS_MAX];
+};
+
 /** @brief DTM packet type. */
 enum dtm_packet {
 	/** Packet filled with PRBS9 stream as payload. */
@@ -235,6 +396,23 @@ struct dtm_iq_data {
  */
 typedef void (*dtm_iq_report_callback_t)(struct dtm_iq_data *data);
 
+/** @brief Callback to report the end of a transmitter burst.
+ *
+ * @note The callback is called from the interrupt context.
+ *
+ * @param[in] packets Number of packets sent.
+ */
+typedef void (*dtm_burst_done_callback_t)(uint32_t packets);
+
+/** @brief Callback to report a completed RSSI sweep.
+ *
+ * The callback is called from the system work queue. The result is valid
+ * until the callback returns.
+ *
+ * @param[in] sweep The sweep result.
+ */
+typedef void (*dtm_rssi_sweep_callback_t)(const struct dtm_rssi_sweep *sweep);
+
 /** @brief Initialize the DTM module.
  *
  * This function initializes the DTM module and registers the IQ sampling callback.
@@ -340,6 +518,21 @@ struct dtm_tx_power dtm_setup_set_transmit_power(enum dtm_tx_power_request power
  */
 int dtm_test_receive(uint8_t channel);
 
+/** @brief Start the DTM reception test hopping through a channel list.
+ *
+ * The receiver hops through the selected channels in ascending order, after
+ * the dwell time or after each received packet. The statistics are kept
+ * per channel, see dtm_rx_scan_stats_get(). The test is ended with
+ * dtm_test_end(), which returns the number of packets received on all channels.
+ *
+ * @param[in] cfg The scan configuration.
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOTSUP if CONFIG_DTM_RX_SCAN is disabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_test_receive_scan(const struct dtm_rx_scan_config *cfg);
+
 /** @brief Start the DTM transmission test.
  *
  * @param[in] channel The transmission channel.
@@ -350,6 +543,24 @@ int dtm_test_receive(uint8_t channel);
  */
 int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt);
 
+/** @brief Start the DTM transmission test with a finite number of packets.
+ *
+ * The transmission stops in hardware after the requested number of packets.
+ * The test remains active until it is ended with dtm_test_end().
+ *
+ * @param[in] channel The transmission channel.
+ * @param[in] length  The packet length.
+ * @param[in] pkt     The packet type. The vendor specific packets are not supported.
+ * @param[in] count   Number of packets to send.
+ * @param[in] cb      Callback called when the last packet is sent, can be NULL.
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOTSUP if CONFIG_DTM_TX_BURST is disabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_test_transmit_burst(uint8_t channel, uint8_t length, enum dtm_packet pkt,
+			    uint32_t count, dtm_burst_done_callback_t cb);
+
 /** @brief Stop the DTM test.
  *
  * Stop current DTM test and return the number of received packets.
@@ -360,6 +571,153 @@ int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt);
  */
 int dtm_test_end(uint16_t *pack_cnt);
 
+/** @brief Get the DTM packet interval.
+ *
+ * The interval depends on the current PHY and Constant Tone Extension setup,
+ * see Bluetooth Core Specification Vol. 6 Part F Section 4.1.6.
+ *
+ * @param[in] length The packet payload length.
+ *
+ * @return Packet interval in microseconds.
+ */
+uint32_t dtm_packet_interval_get(uint8_t length);
+
+/** @brief Get the receiver test statistics.
+ *
+ * The statistics of the last receiver test remain available after the test ends,
+ * until the next receiver test starts.
+ *
+ * @param[out] stats The receiver test statistics.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_rx_stats_get(struct dtm_rx_stats *stats);
+
+/** @brief Get the transmitter test statistics.
+ *
+ * The statistics are collected when the transmitter test ends and remain
+ * available until the next transmitter test ends.
+ *
+ * @param[out] stats The transmitter test statistics.
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOTSUP if CONFIG_DTM_TX_STATS is disabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_tx_stats_get(struct dtm_tx_stats *stats);
+
+/** @brief Set the calibration offsets of the radio output power levels.
+ *
+ * The offset of a level is the measured output power minus the nominal
+ * output power of the level, in 0.25 dB units. The offsets are ordered as
+ * the radio output power levels, from the lowest. The requested output
+ * power is resolved to the level with the nearest calibrated output power.
+ *
+ * @param[in] offsets The calibration offsets.
+ * @param[in] count   Number of offsets, the missing offsets are 0.
+ *
+ * @retval 0 in case of success.
+ * @retval -EBUSY if a test is running.
+ * @retval -ENOTSUP if CONFIG_DTM_POWER_CONTROL_AUTOMATIC is enabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_tx_power_cal_set(const int8_t *offsets, size_t count);
+
+/** @brief Get the calibration offsets of the radio output power levels.
+ *
+ * @param[out] offsets The calibration offsets.
+ * @param[in]  count   Number of offsets that fit the buffer.
+ *
+ * @retval Number of offsets read, one per radio output power level.
+ * @retval -ENOTSUP if CONFIG_DTM_POWER_CONTROL_AUTOMATIC is enabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_tx_power_cal_get(int8_t *offsets, size_t count);
+
+/** @brief Set the output power flatness compensation of the channels.
+ *
+ * The compensation of a channel is added to the output power of every test on
+ * that channel, in 0.25 dB units, positive values raise the output power.
+ * It is resolved when the lookup tables are built, so setting up the radio
+ * for a channel only selects the compensated TXPOWER value.
+ *
+ * @param[in] comp  The compensation, indexed by the DTM channel.
+ * @param[in] count Number of channels, the missing channels are 0.
+ *
+ * @retval 0 in case of success.
+ * @retval -EBUSY if a test is running.
+ * @return Other negative value in case of error.
+ */
+int dtm_tx_power_comp_set(const int8_t *comp, size_t count);
+
+/** @brief Get the output power flatness compensation of the channels.
+ *
+ * @param[out] comp  The compensation, indexed by the DTM channel.
+ * @param[in]  count Number of channels that fit the buffer.
+ *
+ * @retval Number of channels read.
+ * @return Negative value in case of error.
+ */
+int dtm_tx_power_comp_get(int8_t *comp, size_t count);
+
+/** @brief Get the receiver packet timing statistics.
+ *
+ * The statistics of the last receiver test remain available after the test ends,
+ * until the next receiver test starts.
+ *
+ * @param[out] timing The receiver packet timing statistics.
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOTSUP if CONFIG_DTM_RX_TIMING is disabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_rx_timing_get(struct dtm_rx_timing *timing);
+
+/** @brief Get the receiver scan statistics.
+ *
+ * The statistics of the last receiver scan remain available after the test
+ * ends, until the next receiver scan starts.
+ *
+ * @param[out] stats The statistics, indexed by the DTM channel.
+ * @param[in]  count Number of entries of the statistics array,
+ *                   at most DTM_CHANNEL_COUNT are written.
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOTSUP if CONFIG_DTM_RX_SCAN is disabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_rx_scan_stats_get(struct dtm_rx_scan_stat *stats, size_t count);
+
+/** @brief Start an RSSI sweep of the 2.4 GHz band.
+ *
+ * The receiver steps through the frequencies and takes the RSSI samples
+ * from the radio interrupts, without polling. The sweep runs while DTM
+ * is idle and ends with dtm_rssi_sweep_stop() or dtm_test_end().
+ *
+ * @param[in] cfg The sweep configuration.
+ * @param[in] cb  Callback called after each sweep, can be NULL.
+ *
+ * @retval 0 in case of success.
+ * @retval -EBUSY if a test or a sweep is running.
+ * @retval -ENOTSUP if CONFIG_DTM_RSSI_SWEEP is disabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_rssi_sweep_start(const struct dtm_rssi_sweep_config *cfg, dtm_rssi_sweep_callback_t cb);
+
+/** @brief Stop the repeated RSSI sweep after the current sweep. */
+void dtm_rssi_sweep_stop(void);
+
+/** @brief Get the result of the last RSSI sweep.
+ *
+ * @param[out] sweep The sweep result.
+ *
+ * @retval 0 in case of success.
+ * @retval -EBUSY if a sweep is in progress.
+ * @retval -ENOTSUP if CONFIG_DTM_RSSI_SWEEP is disabled.
+ * @return Other negative value in case of error.
+ */
+int dtm_rssi_sweep_get(struct dtm_rssi_sweep *sweep);
+
 #ifdef __cplusplus
 }
 #endif
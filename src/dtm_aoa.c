@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm_aoa.h"
+#include "dtm_welford.h"
+
+/* Running angle of arrival statistics. */
+struct aoa {
+	/* Antenna array of the test, with the element positions below. */
+	struct dtm_iq_aoa_params params;
+
+	/* Number of packets with an estimate. */
+	uint32_t packets;
+
+	/* Angle extremes, average and spread. */
+	int16_t angle_min;
+	int16_t angle_max;
+	struct dtm_welford angle;
+
+	/* Quality sum. */
+	uint64_t quality_sum;
+
+	/* Angle and quality of the last packet. */
+	int16_t angle_last;
+	uint16_t quality_last;
+};
+
+/* Updated from the radio interrupt processing, read by the threads. */
+static struct aoa aoa;
+
+/* Element position of each sample in the switching period. */
+static uint8_t aoa_element[UINT8_MAX];
+
+static dtm_aoa_report_cb_t report_cb;
+
+void dtm_aoa_reset(const struct dtm_iq_aoa_params *params)
+{
+	unsigned int key = irq_lock();
+
+	memset(&aoa, 0, sizeof(aoa));
+	aoa.params = *params;
+	aoa.params.cfo.period = MIN(params->cfo.period, ARRAY_SIZE(aoa_element));
+	memcpy(aoa_element, params->element, aoa.params.cfo.period);
+	aoa.params.element = aoa_element;
+	aoa.angle_min = INT16_MAX;
+	aoa.angle_max = INT16_MIN;
+	dtm_welford_reset(&aoa.angle);
+
+	irq_unlock(key);
+}
+
+void dtm_aoa_process(const int16_t *iq, size_t count, uint8_t channel)
+{
+	struct dtm_iq_aoa est;
+
+	if (dtm_iq_aoa_estimate(iq, count, &aoa.params, &est)) {
+		return;
+	}
+
+	aoa.packets++;
+	aoa.angle_last = est.angle;
+	aoa.quality_last = est.quality;
+	aoa.angle_min = MIN(aoa.angle_min, est.angle);
+	aoa.angle_max = MAX(aoa.angle_max, est.angle);
+	dtm_welford_add(&aoa.angle, est.angle);
+	aoa.quality_sum += est.quality;
+
+	if (report_cb) {
+		struct dtm_aoa_report report = {
+			.channel = channel,
+			.angle = est.angle,
+			.quality = est.quality,
+		};
+
+		report_cb(&report);
+	}
+}
+
+int dtm_aoa_stats_get(struct dtm_aoa_stats *stats)
+{
+	struct aoa tmp;
+	unsigned int key;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	tmp = aoa;
+	irq_unlock(key);
+
+	memset(stats, 0, sizeof(*stats));
+
+	if (tmp.packets == 0) {
+		return 0;
+	}
+
+	stats->packets = tmp.packets;
+	stats->angle_avg = (int16_t)dtm_welford_mean_get(&tmp.angle, 1);
+	stats->angle_min = tmp.angle_min;
+	stats->angle_max = tmp.angle_max;
+	stats->angle_std = (uint16_t)dtm_welford_std_get(&tmp.angle, 1);
+	stats->quality_avg = (uint16_t)(tmp.quality_sum / tmp.packets);
+	stats->angle_last = tmp.angle_last;
+	stats->quality_last = tmp.quality_last;
+
+	return 0;
+}
+
+void dtm_aoa_report_cb_set(dtm_aoa_report_cb_t cb)
+{
+	report_cb = cb;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_AOA_H_
+#define DTM_AOA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#include "dtm_iq_dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Angle of arrival statistics of the receiver test.
+ *
+ * The angle of each packet is estimated from the IQ samples of its CTE,
+ * see dtm_iq_aoa_estimate().
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_aoa_stats {
+	/** Number of packets with an estimate. */
+	uint32_t packets;
+
+	/** Average angle in 0.1 degree. */
+	int16_t angle_avg;
+
+	/** Smallest angle in 0.1 degree. */
+	int16_t angle_min;
+
+	/** Largest angle in 0.1 degree. */
+	int16_t angle_max;
+
+	/** Standard deviation of the angle in 0.1 degree. */
+	uint16_t angle_std;
+
+	/** Average quality, Q15. */
+	uint16_t quality_avg;
+
+	/** Angle of the last packet in 0.1 degree. */
+	int16_t angle_last;
+
+	/** Quality of the last packet, Q15. */
+	uint16_t quality_last;
+} __packed;
+
+/** @brief Angle of arrival of a received packet.
+ *
+ * The structure is also the wire format of DTM_VENDOR_EVT_AOA, little-endian.
+ */
+struct dtm_aoa_report {
+	/** Physical channel of the packet. */
+	uint8_t channel;
+
+	/** Angle in 0.1 degree. */
+	int16_t angle;
+
+	/** Quality, Q15. */
+	uint16_t quality;
+} __packed;
+
+/** @brief Callback to report the angle of each received packet.
+ *
+ * @note The callback is called from the interrupt context.
+ *
+ * @param[in] report Angle of arrival of the packet.
+ */
+typedef void (*dtm_aoa_report_cb_t)(const struct dtm_aoa_report *report);
+
+#if CONFIG_DTM_AOA
+/** @brief Clear the statistics, called when a receiver test starts.
+ *
+ * @param[in] params Antenna array and CTE sampling of the test, the element
+ *                   positions are copied.
+ */
+void dtm_aoa_reset(const struct dtm_iq_aoa_params *params);
+
+/** @brief Estimate the angle of arrival of a received packet.
+ *
+ * @param[in] iq      IQ samples of the CTE, I and Q interleaved.
+ * @param[in] count   Number of IQ samples.
+ * @param[in] channel Physical channel of the packet.
+ */
+void dtm_aoa_process(const int16_t *iq, size_t count, uint8_t channel);
+
+/** @brief Get the angle of arrival statistics.
+ *
+ * The statistics of the last receiver test remain available after the test ends,
+ * until the next receiver test starts.
+ *
+ * @param[out] stats The statistics, all fields are 0 if no packet was received.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_aoa_stats_get(struct dtm_aoa_stats *stats);
+
+/** @brief Set the callback reporting the angle of each received packet.
+ *
+ * @param[in] cb Report callback, NULL to only collect the statistics.
+ */
+void dtm_aoa_report_cb_set(dtm_aoa_report_cb_t cb);
+#else
+static inline void dtm_aoa_reset(const struct dtm_iq_aoa_params *params)
+{
+	ARG_UNUSED(params);
+}
+
+static inline void dtm_aoa_process(const int16_t *iq, size_t count, uint8_t channel)
+{
+	ARG_UNUSED(iq);
+	ARG_UNUSED(count);
+	ARG_UNUSED(channel);
+}
+#endif /* CONFIG_DTM_AOA */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_AOA_H_ */
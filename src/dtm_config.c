@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/settings/settings.h>
+
+#include "dtm.h"
+#include "dtm_config.h"
+
+LOG_MODULE_REGISTER(dtm_config, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
+
+/* Settings subtree of the persistent configuration. */
+#define DTM_CONFIG_SETTINGS_ROOT "dtm/cfg"
+
+/* Highest DTM channel. */
+#define DTM_CONFIG_CHANNEL_MAX 39
+
+/* Packet length of the transmitter test started at boot. */
+#define DTM_CONFIG_AUTOSTART_TX_LENGTH 37
+
+/* Persistent record of the auto-start parameters. */
+struct dtm_config_autostart_record {
+	uint8_t mode;
+	uint8_t channel;
+	uint8_t phy;
+} __packed;
+
+#if CONFIG_DTM_AUTO_START_RX
+#define DTM_CONFIG_AUTOSTART_MODE DTM_AUTOSTART_RX
+#elif CONFIG_DTM_AUTO_START_TX
+#define DTM_CONFIG_AUTOSTART_MODE DTM_AUTOSTART_TX
+#elif CONFIG_DTM_AUTO_START_CARRIER
+#define DTM_CONFIG_AUTOSTART_MODE DTM_AUTOSTART_CARRIER
+#else
+#define DTM_CONFIG_AUTOSTART_MODE DTM_AUTOSTART_NONE
+#endif /* CONFIG_DTM_AUTO_START_RX */
+
+#if CONFIG_DTM_AUTO_START_PHY_2M
+#define DTM_CONFIG_AUTOSTART_PHY DTM_PHY_2M
+#elif CONFIG_DTM_AUTO_START_PHY_CODED_S8
+#define DTM_CONFIG_AUTOSTART_PHY DTM_PHY_CODED_S8
+#elif CONFIG_DTM_AUTO_START_PHY_CODED_S2
+#define DTM_CONFIG_AUTOSTART_PHY DTM_PHY_CODED_S2
+#else
+#define DTM_CONFIG_AUTOSTART_PHY DTM_PHY_1M
+#endif /* CONFIG_DTM_AUTO_START_PHY_2M */
+
+static volatile bool quiet = IS_ENABLED(CONFIG_DTM_QUIET_MODE);
+
+static struct dtm_autostart autostart_cfg = {
+	.mode = DTM_CONFIG_AUTOSTART_MODE,
+	.channel = CONFIG_DTM_AUTO_START_CHANNEL,
+	.phy = DTM_CONFIG_AUTOSTART_PHY,
+};
+
+/* Log backends which were active before entering the quiet mode. */
+static uint32_t suspended_backends;
+
+static K_SEM_DEFINE(quiet_change_sem, 0, 1);
+
+static bool autostart_valid(const struct dtm_autostart *cfg)
+{
+	return (cfg->mode <= DTM_AUTOSTART_CARRIER) &&
+	       (cfg->channel <= DTM_CONFIG_CHANNEL_MAX) &&
+	       (cfg->phy <= DTM_PHY_CODED_S2);
+}
+
+static void log_backends_suspend(void)
+{
+	if (!IS_ENABLED(CONFIG_LOG)) {
+		return;
+	}
+
+	for (int i = 0; i < MIN(log_backend_count_get(), 32); i++) {
+		const struct log_backend *backend = log_backend_get(i);
+
+		if (log_backend_is_active(backend)) {
+			suspended_backends |= BIT(i);
+			log_backend_deactivate(backend);
+		}
+	}
+}
+
+static void log_backends_resume(void)
+{
+	if (!IS_ENABLED(CONFIG_LOG)) {
+		return;
+	}
+
+	for (int i = 0; i < MIN(log_backend_count_get(), 32); i++) {
+		const struct log_backend *backend = log_backend_get(i);
+
+		if (suspended_backends & BIT(i)) {
+			/* Reactivate with the context the backend was activated with. */
+			log_backend_activate(backend, backend->cb->ctx);
+		}
+	}
+
+	suspended_backends = 0;
+}
+
+static void quiet_apply(bool enable)
+{
+	if (enable == quiet) {
+		return;
+	}
+
+	if (enable) {
+		quiet = true;
+		log_backends_suspend();
+	} else {
+		log_backends_resume();
+		quiet = false;
+	}
+
+	k_sem_give(&quiet_change_sem);
+}
+
+#if CONFIG_DTM_SETTINGS
+static int dtm_config_settings_set(const char *name, size_t len,
+				   settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	ssize_t rc;
+
+	if (settings_name_steq(name, "quiet", &next) && !next) {
+		uint8_t val;
+
+		if (len != sizeof(val)) {
+			return -EINVAL;
+		}
+
+		rc = read_cb(cb_arg, &val, sizeof(val));
+		if (rc < 0) {
+			return rc;
+		}
+
+		quiet_apply(val != 0);
+
+		return 0;
+	}
+
+	if (settings_name_steq(name, "autostart", &next) && !next) {
+		struct dtm_config_autostart_record rec;
+		struct dtm_autostart cfg;
+
+		if (len != sizeof(rec)) {
+			return -EINVAL;
+		}
+
+		rc = read_cb(cb_arg, &rec, sizeof(rec));
+		if (rc < 0) {
+			return rc;
+		}
+
+		cfg.mode = rec.mode;
+		cfg.channel = rec.channel;
+		cfg.phy = rec.phy;
+
+		if (!autostart_valid(&cfg)) {
+			return -EINVAL;
+		}
+
+		autostart_cfg = cfg;
+
+		return 0;
+	}
+
+	if (settings_name_steq(name, "txcal", &next) && !next) {
+		int8_t offsets[DTM_TX_POWER_CAL_MAX];
+
+		if (len > sizeof(offsets)) {
+			return -EINVAL;
+		}
+
+		rc = read_cb(cb_arg, offsets, len);
+		if (rc < 0) {
+			return rc;
+		}
+
+		/* Applied before dtm_init(), which builds the power lookup table. */
+		return dtm_tx_power_cal_set(offsets, len);
+	}
+
+	if (settings_name_steq(name, "txcomp", &next) && !next) {
+		int8_t comp[DTM_CHANNEL_COUNT];
+
+		if (len > sizeof(comp)) {
+			return -EINVAL;
+		}
+
+		rc = read_cb(cb_arg, comp, len);
+		if (rc < 0) {
+			return rc;
+		}
+
+		return dtm_tx_power_comp_set(comp, len);
+	}
+
+	return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(dtm_config, DTM_CONFIG_SETTINGS_ROOT, NULL,
+			       dtm_config_settings_set, NULL, NULL);
+#endif /* CONFIG_DTM_SETTINGS */
+
+int dtm_config_init(void)
+{
+	int err = 0;
+
+	/* Apply the Kconfig default first, so the log backends are quiet
+	 * before anything else is printed.
+	 */
+	if (quiet) {
+		log_backends_suspend();
+	}
+
+#if CONFIG_DTM_SETTINGS
+	err = settings_subsys_init();
+	if (err) {
+		LOG_ERR("Settings initialization failed: %d", err);
+		return err;
+	}
+
+	err = settings_load_subtree(DTM_CONFIG_SETTINGS_ROOT);
+	if (err) {
+		LOG_ERR("Loading the DTM configuration failed: %d", err);
+	}
+#endif /* CONFIG_DTM_SETTINGS */
+
+	/* Loading the configuration is not a mode change. */
+	k_sem_reset(&quiet_change_sem);
+
+	return err;
+}
+
+bool dtm_config_quiet_get(void)
+{
+	return quiet;
+}
+
+int dtm_config_quiet_set(bool enable, bool persist)
+{
+	quiet_apply(enable);
+
+	if (!persist) {
+		return 0;
+	}
+
+#if CONFIG_DTM_SETTINGS
+	uint8_t val = enable;
+
+	return settings_save_one(DTM_CONFIG_SETTINGS_ROOT "/quiet", &val, sizeof(val));
+#else
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_SETTINGS */
+}
+
+int dtm_config_quiet_wait(k_timeout_t timeout)
+{
+	return k_sem_take(&quiet_change_sem, timeout) ? -EAGAIN : 0;
+}
+
+void dtm_config_autostart_get(struct dtm_autostart *autostart)
+{
+	*autostart = autostart_cfg;
+}
+
+int dtm_config_autostart_set(const struct dtm_autostart *autostart)
+{
+	if (!autostart || !autostart_valid(autostart)) {
+		return -EINVAL;
+	}
+
+#if CONFIG_DTM_SETTINGS
+	struct dtm_config_autostart_record rec = {
+		.mode = autostart->mode,
+		.channel = autostart->channel,
+		.phy = autostart->phy,
+	};
+	int err;
+
+	err = settings_save_one(DTM_CONFIG_SETTINGS_ROOT "/autostart", &rec, sizeof(rec));
+	if (err) {
+		return err;
+	}
+
+	autostart_cfg = *autostart;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* CONFIG_DTM_SETTINGS */
+}
+
+int dtm_config_tx_power_cal_set(const int8_t *offsets, size_t count)
+{
+	int err;
+
+	err = dtm_tx_power_cal_set(offsets, count);
+	if (err) {
+		return err;
+	}
+
+#if CONFIG_DTM_SETTINGS
+	return settings_save_one(DTM_CONFIG_SETTINGS_ROOT "/txcal", offsets, count);
+#else
+	/* Applied until the next reset, there is no storage to persist it. */
+	return 0;
+#endif /* CONFIG_DTM_SETTINGS */
+}
+
+int dtm_config_tx_power_comp_set(const int8_t *comp, size_t count)
+{
+	int err;
+
+	err = dtm_tx_power_comp_set(comp, count);
+	if (err) {
+		return err;
+	}
+
+#if CONFIG_DTM_SETTINGS
+	return settings_save_one(DTM_CONFIG_SETTINGS_ROOT "/txcomp", comp, count);
+#else
+	/* Applied until the next reset, there is no storage to persist it. */
+	return 0;
+#endif /* CONFIG_DTM_SETTINGS */
+}
+
+int dtm_config_autostart_run(const struct dtm_autostart *autostart)
+{
+	int err;
+
+	if (!autostart || !autostart_valid(autostart)) {
+		return -EINVAL;
+	}
+
+	if (autostart->mode == DTM_AUTOSTART_NONE) {
+		return 0;
+	}
+
+	err = dtm_setup_reset();
+	if (err) {
+		return err;
+	}
+
+	/* The vendor specific carrier is only available on the uncoded PHYs. */
+	err = dtm_setup_set_phy((autostart->mode == DTM_AUTOSTART_CARRIER) ?
+				DTM_PHY_1M : autostart->phy);
+	if (err) {
+		return err;
+	}
+
+	switch (autostart->mode) {
+	case DTM_AUTOSTART_RX:
+		return dtm_test_receive(autostart->channel);
+
+	case DTM_AUTOSTART_TX:
+		return dtm_test_transmit(autostart->channel,
+					 DTM_CONFIG_AUTOSTART_TX_LENGTH,
+					 DTM_PACKET_PRBS9);
+
+	case DTM_AUTOSTART_CARRIER:
+		/* Zero length vendor specific packet is the carrier test. */
+		return dtm_test_transmit(autostart->channel, 0,
+					 DTM_PACKET_FF_OR_VENDOR);
+
+	default:
+		return -EINVAL;
+	}
+}
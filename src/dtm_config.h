@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_CONFIG_H_
+#define DTM_CONFIG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "dtm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Test started automatically at boot. */
+enum dtm_autostart_mode {
+	/** No test is started. */
+	DTM_AUTOSTART_NONE,
+
+	/** Receiver test. */
+	DTM_AUTOSTART_RX,
+
+	/** Transmitter test with the PRBS9 payload. */
+	DTM_AUTOSTART_TX,
+
+	/** Unmodulated carrier. */
+	DTM_AUTOSTART_CARRIER,
+};
+
+/** @brief Parameters of the test started automatically at boot. */
+struct dtm_autostart {
+	/** Test mode. */
+	enum dtm_autostart_mode mode;
+
+	/** DTM channel, 0 - 39. */
+	uint8_t channel;
+
+	/** PHY used for the receiver and transmitter tests. */
+	enum dtm_phy phy;
+};
+
+/** @brief Print a diagnostic message unless the quiet mode is active.
+ *
+ * Use it for all console output that can occur while a test is running.
+ */
+#define DTM_DIAG(...)                          \
+	do {                                   \
+		if (!dtm_config_quiet_get()) { \
+			printk(__VA_ARGS__);   \
+		}                              \
+	} while (0)
+
+/** @brief Initialize the DTM configuration.
+ *
+ * Load the persistent configuration, if enabled, and apply the quiet mode.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ *         The Kconfig defaults are used if the configuration cannot be loaded.
+ */
+int dtm_config_init(void);
+
+/** @brief Check if the quiet mode is active.
+ *
+ * The function can be called from the interrupt context.
+ *
+ * @return True if the quiet mode is active.
+ */
+bool dtm_config_quiet_get(void);
+
+/** @brief Switch between the quiet mode and the diagnostics mode.
+ *
+ * The log backends are deactivated in the quiet mode and reactivated
+ * in the diagnostics mode.
+ *
+ * @param[in] quiet   True to enter the quiet mode.
+ * @param[in] persist True to store the mode in the persistent configuration.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_config_quiet_set(bool quiet, bool persist);
+
+/** @brief Wait for a change of the quiet mode.
+ *
+ * @param[in] timeout Waiting period.
+ *
+ * @return 0 if the mode has changed, -EAGAIN if the waiting period expired.
+ */
+int dtm_config_quiet_wait(k_timeout_t timeout);
+
+/** @brief Get the parameters of the test started at boot.
+ *
+ * @param[out] autostart Auto-start parameters.
+ */
+void dtm_config_autostart_get(struct dtm_autostart *autostart);
+
+/** @brief Set the parameters of the test started at boot.
+ *
+ * The parameters are stored in the persistent configuration and take effect
+ * after the next reset.
+ *
+ * @param[in] autostart Auto-start parameters.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_config_autostart_set(const struct dtm_autostart *autostart);
+
+/** @brief Start the test described by the auto-start parameters.
+ *
+ * @param[in] autostart Auto-start parameters.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_config_autostart_run(const struct dtm_autostart *autostart);
+
+/** @brief Set and store the calibration offsets of the radio output power levels.
+ *
+ * The offsets are applied immediately. With CONFIG_DTM_SETTINGS they are also
+ * stored and loaded at boot, see dtm_tx_power_cal_set().
+ *
+ * @param[in] offsets The calibration offsets, in 0.25 dB units.
+ * @param[in] count   Number of offsets.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_config_tx_power_cal_set(const int8_t *offsets, size_t count);
+
+/** @brief Set and store the output power flatness compensation of the channels.
+ *
+ * The compensation is applied immediately. With CONFIG_DTM_SETTINGS it is also
+ * stored and loaded at boot, see dtm_tx_power_comp_set().
+ *
+ * @param[in] comp  The compensation of each DTM channel, in 0.25 dB units.
+ * @param[in] count Number of channels.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_config_tx_power_comp_set(const int8_t *comp, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_CONFIG_H_ */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm_cte_cfo.h"
+#include "dtm_welford.h"
+
+/* Running frequency offset statistics. */
+struct cte_cfo {
+	/* CTE sampling of the test. */
+	struct dtm_iq_cfo_params params;
+
+	/* Number of packets with an estimate. */
+	uint32_t packets;
+
+	/* Offset extremes, average and spread. */
+	int32_t offset_min;
+	int32_t offset_max;
+	struct dtm_welford offset;
+
+	/* Offset of the first and the last packet. */
+	int32_t offset_first;
+	int32_t offset_last;
+
+	/* Drift extremes and sum. */
+	int32_t drift_min;
+	int32_t drift_max;
+	int64_t drift_sum;
+};
+
+/* Updated from the radio interrupt processing, read by the threads. */
+static struct cte_cfo cte_cfo;
+
+void dtm_cte_cfo_reset(const struct dtm_iq_cfo_params *params)
+{
+	unsigned int key = irq_lock();
+
+	memset(&cte_cfo, 0, sizeof(cte_cfo));
+	cte_cfo.params = *params;
+	dtm_welford_reset(&cte_cfo.offset);
+	cte_cfo.offset_min = INT32_MAX;
+	cte_cfo.offset_max = INT32_MIN;
+	cte_cfo.drift_min = INT32_MAX;
+	cte_cfo.drift_max = INT32_MIN;
+
+	irq_unlock(key);
+}
+
+void dtm_cte_cfo_process(const int16_t *iq, size_t count)
+{
+	struct dtm_iq_cfo cfo;
+
+	if (dtm_iq_cfo_estimate(iq, count, &cte_cfo.params, &cfo)) {
+		return;
+	}
+
+	if (cte_cfo.packets == 0) {
+		cte_cfo.offset_first = cfo.offset_hz;
+	}
+
+	cte_cfo.packets++;
+	cte_cfo.offset_last = cfo.offset_hz;
+	cte_cfo.offset_min = MIN(cte_cfo.offset_min, cfo.offset_hz);
+	cte_cfo.offset_max = MAX(cte_cfo.offset_max, cfo.offset_hz);
+	dtm_welford_add(&cte_cfo.offset, cfo.offset_hz);
+	cte_cfo.drift_min = MIN(cte_cfo.drift_min, cfo.drift_hz);
+	cte_cfo.drift_max = MAX(cte_cfo.drift_max, cfo.drift_hz);
+	cte_cfo.drift_sum += cfo.drift_hz;
+}
+
+int dtm_cte_cfo_stats_get(struct dtm_cte_cfo_stats *stats)
+{
+	struct cte_cfo tmp;
+	unsigned int key;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	tmp = cte_cfo;
+	irq_unlock(key);
+
+	memset(stats, 0, sizeof(*stats));
+
+	if (tmp.packets == 0) {
+		return 0;
+	}
+
+	stats->packets = tmp.packets;
+	stats->offset_avg_hz = dtm_welford_mean_get(&tmp.offset, 1);
+	stats->offset_min_hz = tmp.offset_min;
+	stats->offset_max_hz = tmp.offset_max;
+	stats->offset_std_hz = dtm_welford_std_get(&tmp.offset, 1);
+	stats->offset_first_hz = tmp.offset_first;
+	stats->offset_last_hz = tmp.offset_last;
+	stats->drift_avg_hz = (int32_t)(tmp.drift_sum / tmp.packets);
+	stats->drift_min_hz = tmp.drift_min;
+	stats->drift_max_hz = tmp.drift_max;
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_CTE_CFO_H_
+#define DTM_CTE_CFO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#include "dtm_iq_dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Carrier frequency offset statistics of the receiver test.
+ *
+ * The offset and the drift of each packet are estimated from the IQ
+ * samples of its CTE, see dtm_iq_cfo_estimate().
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_cte_cfo_stats {
+	/** Number of packets with an estimate. */
+	uint32_t packets;
+
+	/** Average frequency offset in Hz. */
+	int32_t offset_avg_hz;
+
+	/** Smallest frequency offset in Hz. */
+	int32_t offset_min_hz;
+
+	/** Largest frequency offset in Hz. */
+	int32_t offset_max_hz;
+
+	/** Standard deviation of the frequency offset in Hz. */
+	uint32_t offset_std_hz;
+
+	/** Frequency offset of the first packet in Hz. */
+	int32_t offset_first_hz;
+
+	/** Frequency offset of the last packet in Hz. */
+	int32_t offset_last_hz;
+
+	/** Average drift over the CTE in Hz. */
+	int32_t drift_avg_hz;
+
+	/** Smallest drift over the CTE in Hz. */
+	int32_t drift_min_hz;
+
+	/** Largest drift over the CTE in Hz. */
+	int32_t drift_max_hz;
+} __packed;
+
+#if CONFIG_DTM_CTE_CFO
+/** @brief Clear the statistics, called when a receiver test starts.
+ *
+ * @param[in] params CTE sampling of the test.
+ */
+void dtm_cte_cfo_reset(const struct dtm_iq_cfo_params *params);
+
+/** @brief Estimate the frequency offset of a received packet.
+ *
+ * @param[in] iq    IQ samples of the CTE, I and Q interleaved.
+ * @param[in] count Number of IQ samples.
+ */
+void dtm_cte_cfo_process(const int16_t *iq, size_t count);
+
+/** @brief Get the frequency offset statistics.
+ *
+ * The statistics of the last receiver test remain available after the test ends,
+ * until the next receiver test starts.
+ *
+ * @param[out] stats The statistics, all fields are 0 if no packet was received.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_cte_cfo_stats_get(struct dtm_cte_cfo_stats *stats);
+#else
+static inline void dtm_cte_cfo_reset(const struct dtm_iq_cfo_params *params)
+{
+	ARG_UNUSED(params);
+}
+
+static inline void dtm_cte_cfo_process(const int16_t *iq, size_t count)
+{
+	ARG_UNUSED(iq);
+	ARG_UNUSED(count);
+}
+#endif /* CONFIG_DTM_CTE_CFO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_CTE_CFO_H_ */
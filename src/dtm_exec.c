@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm_exec.h"
+
+/* Command queued to the executor. */
+struct exec_req {
+	dtm_exec_handler_t handler;
+	void *ctx;
+	uint32_t submitted;
+	uint8_t client;
+	bool contended;
+};
+
+/* Running statistics of a client, in cycles. */
+struct exec_stat {
+	uint32_t count;
+	uint32_t contended;
+	uint64_t wait_sum;
+	uint32_t wait_max;
+	uint64_t run_sum;
+	uint32_t run_max;
+};
+
+/* A client has one outstanding command at a time, its result is returned
+ * through the reply semaphore.
+ */
+struct exec_client {
+	struct k_mutex lock;
+	struct k_sem reply;
+	int ret;
+	struct exec_stat stat;
+};
+
+static struct exec_client clients[DTM_EXEC_CLIENT_COUNT];
+
+static const char *const client_names[DTM_EXEC_CLIENT_COUNT] = {
+	[DTM_EXEC_CLIENT_TESTER] = "tester",
+	[DTM_EXEC_CLIENT_SHELL] = "shell",
+	[DTM_EXEC_CLIENT_MAIN] = "main",
+	[DTM_EXEC_CLIENT_RUNNER] = "runner",
+};
+
+/* The tester transport has its own queue, served first. As each client
+ * waits for its reply, the queues cannot overflow.
+ */
+K_MSGQ_DEFINE(exec_tester_q, sizeof(struct exec_req), 1, 4);
+K_MSGQ_DEFINE(exec_q, sizeof(struct exec_req), DTM_EXEC_CLIENT_COUNT - 1, 4);
+K_SEM_DEFINE(exec_pending, 0, DTM_EXEC_CLIENT_COUNT);
+
+static struct k_spinlock stats_lock;
+static atomic_t exec_busy;
+
+/* Client owning the DTM engine, DTM_EXEC_CLIENT_COUNT if none. */
+static atomic_t exec_owner = ATOMIC_INIT(DTM_EXEC_CLIENT_COUNT);
+
+/* Client whose claim was revoked by the tester, DTM_EXEC_CLIENT_COUNT if
+ * none. Its commands are cancelled until it releases the engine.
+ */
+static atomic_t exec_revoked = ATOMIC_INIT(DTM_EXEC_CLIENT_COUNT);
+
+/* Client of the command being executed. */
+static uint8_t exec_current;
+
+static void stat_record(const struct exec_req *req, uint32_t start, uint32_t end)
+{
+	struct exec_stat *stat = &clients[req->client].stat;
+	uint32_t wait = start - req->submitted;
+	uint32_t run = end - start;
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stat->count++;
+	stat->contended += req->contended ? 1 : 0;
+	stat->wait_sum += wait;
+	stat->wait_max = MAX(stat->wait_max, wait);
+	stat->run_sum += run;
+	stat->run_max = MAX(stat->run_max, run);
+
+	k_spin_unlock(&stats_lock, key);
+}
+
+static void exec_thread(void *p1, void *p2, void *p3)
+{
+	struct exec_req req;
+	uint32_t start;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		(void)k_sem_take(&exec_pending, K_FOREVER);
+
+		if (k_msgq_get(&exec_tester_q, &req, K_NO_WAIT) &&
+		    k_msgq_get(&exec_q, &req, K_NO_WAIT)) {
+			continue;
+		}
+
+		start = k_cycle_get_32();
+		atomic_set(&exec_busy, 1);
+		exec_current = req.client;
+
+		if (atomic_get(&exec_revoked) == req.client) {
+			clients[req.client].ret = -ECANCELED;
+		} else {
+			clients[req.client].ret = req.handler(req.ctx);
+		}
+
+		atomic_set(&exec_busy, 0);
+		stat_record(&req, start, k_cycle_get_32());
+
+		k_sem_give(&clients[req.client].reply);
+	}
+}
+
+K_THREAD_DEFINE(dtm_exec_thread, CONFIG_DTM_EXEC_THREAD_STACK_SIZE, exec_thread,
+		NULL, NULL, NULL, CONFIG_DTM_EXEC_THREAD_PRIORITY, 0, 0);
+
+int dtm_exec_call(enum dtm_exec_client client, dtm_exec_handler_t handler, void *ctx)
+{
+	struct exec_req req = {
+		.handler = handler,
+		.ctx = ctx,
+		.submitted = k_cycle_get_32(),
+		.client = client,
+	};
+	struct exec_client *cl;
+	int err;
+
+	__ASSERT_NO_MSG(!k_is_in_isr());
+
+	if ((client >= DTM_EXEC_CLIENT_COUNT) || !handler) {
+		return -EINVAL;
+	}
+
+	/* Nested command, the executor already owns the DTM engine. */
+	if (k_current_get() == dtm_exec_thread) {
+		return handler(ctx);
+	}
+
+	cl = &clients[client];
+
+	(void)k_mutex_lock(&cl->lock, K_FOREVER);
+
+	req.contended = atomic_get(&exec_busy) || (k_sem_count_get(&exec_pending) > 0);
+
+	err = k_msgq_put((client == DTM_EXEC_CLIENT_TESTER) ? &exec_tester_q : &exec_q,
+			 &req, K_NO_WAIT);
+	__ASSERT_NO_MSG(!err);
+
+	k_sem_give(&exec_pending);
+	(void)k_sem_take(&cl->reply, K_FOREVER);
+	err = cl->ret;
+
+	k_mutex_unlock(&cl->lock);
+
+	return err;
+}
+
+int dtm_exec_stats_get(enum dtm_exec_client client, struct dtm_exec_stat *stat)
+{
+	struct exec_stat tmp;
+	k_spinlock_key_t key;
+
+	if ((client >= DTM_EXEC_CLIENT_COUNT) || !stat) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&stats_lock);
+	tmp = clients[client].stat;
+	k_spin_unlock(&stats_lock, key);
+
+	stat->count = tmp.count;
+	stat->contended = tmp.contended;
+	stat->wait_avg = tmp.count ? k_cyc_to_us_floor32(tmp.wait_sum / tmp.count) : 0;
+	stat->wait_max = k_cyc_to_us_floor32(tmp.wait_max);
+	stat->run_max = k_cyc_to_us_floor32(tmp.run_max);
+	stat->run_avg = tmp.count ? k_cyc_to_us_floor32(tmp.run_sum / tmp.count) : 0;
+
+	return 0;
+}
+
+void dtm_exec_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(clients); i++) {
+		memset(&clients[i].stat, 0, sizeof(clients[i].stat));
+	}
+
+	k_spin_unlock(&stats_lock, key);
+}
+
+const char *dtm_exec_client_name(enum dtm_exec_client client)
+{
+	return (client < DTM_EXEC_CLIENT_COUNT) ? client_names[client] : "unknown";
+}
+
+int dtm_exec_claim(enum dtm_exec_client client)
+{
+	if (client >= DTM_EXEC_CLIENT_COUNT) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&exec_owner, DTM_EXEC_CLIENT_COUNT, client)) {
+		return -EBUSY;
+	}
+
+	return 0;
+}
+
+void dtm_exec_release(enum dtm_exec_client client)
+{
+	(void)atomic_cas(&exec_revoked, client, DTM_EXEC_CLIENT_COUNT);
+	(void)atomic_cas(&exec_owner, client, DTM_EXEC_CLIENT_COUNT);
+}
+
+void dtm_exec_tester_reset(void)
+{
+	atomic_val_t owner;
+
+	__ASSERT_NO_MSG(k_current_get() == dtm_exec_thread);
+
+	if (exec_current != DTM_EXEC_CLIENT_TESTER) {
+		return;
+	}
+
+	/* The revoked client keeps the claim until it releases it, so no other
+	 * client can claim the engine before the revoked run has ended.
+	 */
+	owner = atomic_get(&exec_owner);
+	if ((owner != DTM_EXEC_CLIENT_COUNT) && (owner != DTM_EXEC_CLIENT_TESTER)) {
+		atomic_set(&exec_revoked, owner);
+	}
+}
+
+int dtm_exec_test_start_check(void)
+{
+	atomic_val_t owner = atomic_get(&exec_owner);
+
+	__ASSERT_NO_MSG(k_current_get() == dtm_exec_thread);
+
+	if ((owner != DTM_EXEC_CLIENT_COUNT) && (owner != exec_current) &&
+	    (owner != atomic_get(&exec_revoked))) {
+		return -EBUSY;
+	}
+
+	return 0;
+}
+
+static int exec_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(clients); i++) {
+		k_mutex_init(&clients[i].lock);
+		k_sem_init(&clients[i].reply, 0, 1);
+	}
+
+	return 0;
+}
+
+SYS_INIT(exec_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
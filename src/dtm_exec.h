@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_EXEC_H_
+#define DTM_EXEC_H_
+
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Front ends submitting commands to the DTM executor. */
+enum dtm_exec_client {
+	/** Tester transport: Two Wire, HCI or the framed RTT protocol.
+	 *  Its commands are served before the commands of the other clients.
+	 */
+	DTM_EXEC_CLIENT_TESTER,
+
+	/** Shell commands. */
+	DTM_EXEC_CLIENT_SHELL,
+
+	/** Main thread, the test started at boot, and the repeated RSSI
+	 *  sweep.
+	 */
+	DTM_EXEC_CLIENT_MAIN,
+
+	/** Background runners: the test plan and the PER measurement. */
+	DTM_EXEC_CLIENT_RUNNER,
+
+	/** Number of the clients. */
+	DTM_EXEC_CLIENT_COUNT
+};
+
+/** @brief Command executed by the DTM executor.
+ *
+ * @param[in] ctx Command context.
+ *
+ * @return Command result, returned to the client.
+ */
+typedef int (*dtm_exec_handler_t)(void *ctx);
+
+/** @brief Command latency statistics of a client, in microseconds.
+ *
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_exec_stat {
+	/** Number of executed commands. */
+	uint32_t count;
+
+	/** Number of commands queued while the executor was busy. */
+	uint32_t contended;
+
+	/** Average time from the submission to the start of the execution. */
+	uint32_t wait_avg;
+
+	/** Longest time from the submission to the start of the execution. */
+	uint32_t wait_max;
+
+	/** Longest execution. */
+	uint32_t run_max;
+
+	/** Average execution. */
+	uint32_t run_avg;
+} __packed;
+
+#if CONFIG_DTM_EXEC
+/** @brief Execute a command in the DTM executor thread.
+ *
+ * The executor is the only thread driving the DTM engine. The caller is
+ * blocked until the command is executed. A command submitted from the
+ * executor thread itself is executed immediately.
+ *
+ * @note The function must not be called from the interrupt context.
+ *
+ * @param[in] client  Client submitting the command.
+ * @param[in] handler Command.
+ * @param[in] ctx     Command context.
+ *
+ * @return Command result, or -EINVAL if the client is invalid.
+ */
+int dtm_exec_call(enum dtm_exec_client client, dtm_exec_handler_t handler, void *ctx);
+
+/** @brief Get the command latency statistics of a client.
+ *
+ * @param[in]  client Client.
+ * @param[out] stat   Statistics since the boot or the last reset.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_exec_stats_get(enum dtm_exec_client client, struct dtm_exec_stat *stat);
+
+/** @brief Clear the command latency statistics. */
+void dtm_exec_stats_reset(void);
+
+/** @brief Get the name of a client.
+ *
+ * @param[in] client Client.
+ *
+ * @return Client name.
+ */
+const char *dtm_exec_client_name(enum dtm_exec_client client);
+
+/** @brief Claim the DTM engine for a client.
+ *
+ * While the engine is claimed, the commands of the other clients cannot
+ * start a test, see dtm_exec_test_start_check().
+ *
+ * @param[in] client Client claiming the engine.
+ *
+ * @return 0 in case of success, -EBUSY if the engine is claimed by another
+ *         client or -EINVAL if the client is invalid.
+ */
+int dtm_exec_claim(enum dtm_exec_client client);
+
+/** @brief Release the DTM engine claimed with dtm_exec_claim().
+ *
+ * @param[in] client Client owning the engine.
+ */
+void dtm_exec_release(enum dtm_exec_client client);
+
+/** @brief Hand the DTM engine over to the tester.
+ *
+ * Called by the reset command of the tester transport. The claim of another
+ * client is revoked: its commands fail with -ECANCELED without being executed
+ * and no longer block the tests of the other clients until it releases the
+ * engine, so a test plan started at boot cannot lock the tester out.
+ *
+ * @note The function must be called from the executed command. It has no
+ *       effect for the commands of the other clients.
+ */
+void dtm_exec_tester_reset(void);
+
+/** @brief Check if the command being executed may start a test.
+ *
+ * @note The function must be called from the executed command.
+ *
+ * @return 0 if the engine is free or owned by the client of the command,
+ *         -EBUSY otherwise.
+ */
+int dtm_exec_test_start_check(void);
+#else
+static inline int dtm_exec_call(enum dtm_exec_client client, dtm_exec_handler_t handler,
+				void *ctx)
+{
+	ARG_UNUSED(client);
+
+	return handler(ctx);
+}
+
+static inline int dtm_exec_claim(enum dtm_exec_client client)
+{
+	ARG_UNUSED(client);
+
+	return 0;
+}
+
+static inline void dtm_exec_release(enum dtm_exec_client client)
+{
+	ARG_UNUSED(client);
+}
+
+static inline void dtm_exec_tester_reset(void)
+{
+}
+
+static inline int dtm_exec_test_start_check(void)
+{
+	return 0;
+}
+#endif /* CONFIG_DTM_EXEC */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_EXEC_H_ */
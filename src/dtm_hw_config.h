@@ -7,6 +7,8 @@
 #ifndef DTM_HW_CONFIG_H_
 #define DTM_HW_CONFIG_H_
 
+#include <nrf_erratas.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -23,6 +25,29 @@ extern "C" {
 	* DT_NODE_HAS_STATUS(RADIO_NODE, okay)
 	*/
 
+/* Constant Tone Extension support compiled into the DTM engine.
+ * Restricted DTM profiles drop it even if the radio supports it.
+ */
+#if DIRECTION_FINDING_SUPPORTED && CONFIG_DTM_PROFILE_FULL
+#define DTM_CTE_ENABLED 1
+#else
+#define DTM_CTE_ENABLED 0
+#endif /* DIRECTION_FINDING_SUPPORTED && CONFIG_DTM_PROFILE_FULL */
+
+/* LE Coded PHY support compiled into the DTM engine. */
+#if CONFIG_HAS_HW_NRF_RADIO_BLE_CODED && !CONFIG_DTM_PROFILE_UNCODED_NO_CTE
+#define DTM_CODED_PHY_ENABLED 1
+#else
+#define DTM_CODED_PHY_ENABLED 0
+#endif /* CONFIG_HAS_HW_NRF_RADIO_BLE_CODED && !CONFIG_DTM_PROFILE_UNCODED_NO_CTE */
+
+/* The nRF52840 anomaly 172 workaround is only needed with LE Coded PHY. */
+#if NRF52_ERRATA_172_PRESENT && DTM_CODED_PHY_ENABLED
+#define DTM_ANOMALY_172_ENABLED 1
+#else
+#define DTM_ANOMALY_172_ENABLED 0
+#endif /* NRF52_ERRATA_172_PRESENT && DTM_CODED_PHY_ENABLED */
+
 /* Maximum transmit or receive time, in microseconds, that the local
  * Controller supports for transmission of a single
  * Link Layer Data Physical Channel PDU, divided by 2.
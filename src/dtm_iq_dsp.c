@@ -0,0 +1,619 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "dtm_iq_dsp.h"
+
+/* Largest number of IQ samples of a CTE processed at once. */
+#define IQ_SAMPLES_MAX 128
+
+/* Fractional bits of the phase slopes. */
+#define SLOPE_FRAC_BITS 8
+
+/* CORDIC rotation angles, atan(2^-k) as binary angles. */
+static const uint16_t cordic_atan[] = {
+	8192, 4836, 2555, 1297, 651, 326, 163, 81, 41, 20, 10, 5, 3, 1
+};
+
+/* Quarter wave of the sine in 64 segments, Q15. */
+static const int16_t sin_table[] = {
+	0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+	6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+	12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+	18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+	23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+	27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+	30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+	32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+	32767,
+};
+
+int16_t dtm_iq_sin_q15(uint16_t angle)
+{
+	uint16_t quarter = angle & (DTM_IQ_TURN / 4 - 1);
+	size_t idx;
+	uint16_t frac;
+	int32_t val;
+
+	/* Mirror the second and the fourth quarter into the first one. */
+	if (angle & (DTM_IQ_TURN / 4)) {
+		quarter = DTM_IQ_TURN / 4 - quarter;
+	}
+
+	idx = quarter >> 8;
+	frac = quarter & 0xFF;
+	val = sin_table[idx];
+
+	if (frac) {
+		val += ((sin_table[idx + 1] - sin_table[idx]) * frac + 128) >> 8;
+	}
+
+	return (angle & (DTM_IQ_TURN / 2)) ? (int16_t)-val : (int16_t)val;
+}
+
+uint16_t dtm_iq_phase(int16_t i, int16_t q)
+{
+	/* Scaled up for the precision of the shifts, the CORDIC gain of
+	 * 1.65 still fits 32 bits.
+	 */
+	int32_t x = (int32_t)i * (1 << 14);
+	int32_t y = (int32_t)q * (1 << 14);
+	uint16_t angle = 0;
+	int32_t tmp;
+
+	if ((x == 0) && (y == 0)) {
+		return 0;
+	}
+
+	/* Rotate the vector into the right half-plane. */
+	if (x < 0) {
+		x = -x;
+		y = -y;
+		angle = DTM_IQ_TURN / 2;
+	}
+
+	for (int k = 0; k < (int)(sizeof(cordic_atan) / sizeof(cordic_atan[0])); k++) {
+		if (y > 0) {
+			tmp = x + (y >> k);
+			y -= x >> k;
+			angle += cordic_atan[k];
+		} else {
+			tmp = x - (y >> k);
+			y += x >> k;
+			angle -= cordic_atan[k];
+		}
+		x = tmp;
+	}
+
+	return angle;
+}
+
+uint32_t dtm_iq_isqrt(uint64_t val)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > val) {
+		bit >>= 2;
+	}
+
+	while (bit) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)res;
+}
+
+static bool sample_valid(const int16_t *iq, size_t idx)
+{
+	return (iq[2 * idx] != DTM_IQ_INVALID) && (iq[2 * idx + 1] != DTM_IQ_INVALID);
+}
+
+/* Convert a phase advance in binary angles over a time in microseconds to Hz. */
+static int32_t advance_to_hz(int64_t advance, int64_t time_us)
+{
+	return (int32_t)((advance * 1000000) / (time_us * DTM_IQ_TURN));
+}
+
+static void phases_get(const int16_t *iq, size_t count, uint16_t *phase)
+{
+	for (size_t k = 0; k < count; k++) {
+		phase[k] = dtm_iq_phase(iq[2 * k], iq[2 * k + 1]);
+	}
+}
+
+static int cfo_estimate(const int16_t *iq, const uint16_t *phase, size_t count,
+			const struct dtm_iq_cfo_params *params, struct dtm_iq_cfo *cfo)
+{
+	size_t n;
+	size_t lag;
+	uint32_t dt;
+	uint16_t nominal_adv;
+	int32_t unwrapped = 0;
+	int64_t num = 0;
+	int32_t pred;
+	int64_t sum[2] = {0};
+	uint32_t cnt[2] = {0};
+	int64_t w_ref;
+	int64_t w_pairs;
+
+	n = params->ref_count;
+
+	/* Reference period: least squares phase slope of the derotated samples,
+	 * sum((k - mean) * phase) / sum((k - mean)^2). The phase advances by less
+	 * than half a turn per microsecond up to an offset of 500 kHz.
+	 */
+	for (size_t k = 0; k < n; k++) {
+		if (!sample_valid(iq, k)) {
+			return -EINVAL;
+		}
+
+		if (k > 0) {
+			unwrapped += (int16_t)((uint16_t)(phase[k] - phase[k - 1]) -
+					       params->nominal);
+		}
+
+		num += (int64_t)((int32_t)(2 * k) - (int32_t)(n - 1)) * unwrapped;
+	}
+
+	pred = (int32_t)((num * 6 * (1 << SLOPE_FRAC_BITS)) / (int64_t)(n * (n * n - 1)));
+
+	cfo->ref_hz = advance_to_hz(pred, 1LL << SLOPE_FRAC_BITS);
+
+	/* Samples after the reference period: phase advance between the samples
+	 * taken with the same antenna. The advance predicted from the average so
+	 * far resolves the whole turns.
+	 */
+	lag = params->period;
+	dt = lag * params->spacing_us;
+	nominal_adv = (uint16_t)(dt * params->nominal);
+	pred = (int32_t)(((int64_t)pred * dt) >> SLOPE_FRAC_BITS);
+
+	for (size_t m = n; m + lag < count; m++) {
+		uint16_t adv;
+		int32_t full;
+		int half;
+
+		if (!sample_valid(iq, m) || !sample_valid(iq, m + lag)) {
+			continue;
+		}
+
+		adv = (uint16_t)(phase[m + lag] - phase[m]) - nominal_adv;
+		full = pred + (int16_t)(adv - (uint16_t)pred);
+
+		/* The pairs are split at the middle of the samples. */
+		half = ((2 * m) + lag < n + count) ? 0 : 1;
+		sum[half] += full;
+		cnt[half]++;
+
+		pred = (int32_t)((sum[0] + sum[1]) / (int64_t)(cnt[0] + cnt[1]));
+	}
+
+	cfo->pairs = cnt[0] + cnt[1];
+
+	if (cfo->pairs == 0) {
+		cfo->offset_hz = cfo->ref_hz;
+		cfo->drift_hz = 0;
+		return 0;
+	}
+
+	/* Both estimates are weighted with the inverse of their variance, the
+	 * sum of the squared sample time deviations of the reference period and
+	 * half of the squared time between the samples of a pair, times 12.
+	 */
+	w_ref = (int64_t)(n * (n * n - 1));
+	w_pairs = 6 * (int64_t)cfo->pairs * dt * dt;
+	cfo->offset_hz = (int32_t)((w_ref * cfo->ref_hz +
+				    w_pairs * advance_to_hz(sum[0] + sum[1],
+							    (int64_t)cfo->pairs * dt)) /
+				   (w_ref + w_pairs));
+	cfo->drift_hz = (cnt[0] && cnt[1]) ?
+			(advance_to_hz(sum[1], (int64_t)cnt[1] * dt) -
+			 advance_to_hz(sum[0], (int64_t)cnt[0] * dt)) : 0;
+
+	return 0;
+}
+
+static bool cfo_params_valid(const struct dtm_iq_cfo_params *params, size_t count)
+{
+	return (count <= IQ_SAMPLES_MAX) && (params->ref_count >= 2) &&
+	       (count >= params->ref_count) && (params->spacing_us != 0) &&
+	       (params->period != 0);
+}
+
+int dtm_iq_cfo_estimate(const int16_t *iq, size_t count,
+			const struct dtm_iq_cfo_params *params, struct dtm_iq_cfo *cfo)
+{
+	uint16_t phase[IQ_SAMPLES_MAX];
+
+	if (!iq || !params || !cfo || !cfo_params_valid(params, count)) {
+		return -EINVAL;
+	}
+
+	phases_get(iq, count, phase);
+
+	return cfo_estimate(iq, phase, count, params, cfo);
+}
+
+int dtm_iq_aoa_estimate(const int16_t *iq, size_t count,
+			const struct dtm_iq_aoa_params *params, struct dtm_iq_aoa *aoa)
+{
+	uint16_t phase[IQ_SAMPLES_MAX];
+	struct dtm_iq_cfo cfo;
+	size_t n;
+	size_t lag;
+	uint16_t adv;
+	int32_t sum_cos = 0;
+	int32_t sum_sin = 0;
+	uint32_t pairs = 0;
+	int16_t avg_cos;
+	int16_t avg_sin;
+	int16_t diff;
+	int32_t sin_theta;
+	uint32_t cos_theta;
+	int32_t theta;
+	int err;
+
+	if (!iq || !params || !aoa || !params->element || (params->spacing == 0) ||
+	    !cfo_params_valid(&params->cfo, count)) {
+		return -EINVAL;
+	}
+
+	phases_get(iq, count, phase);
+
+	err = cfo_estimate(iq, phase, count, &params->cfo, &cfo);
+	if (err) {
+		return err;
+	}
+
+	n = params->cfo.ref_count;
+	lag = params->cfo.period;
+
+	/* Phase advance of the tone between two consecutive samples. */
+	adv = (uint16_t)(params->cfo.spacing_us * params->cfo.nominal +
+			 (((int64_t)cfo.offset_hz * params->cfo.spacing_us * DTM_IQ_TURN) /
+			  1000000));
+
+	for (size_t m = n; m + 1 < count; m++) {
+		int step = params->element[(m + 1 - n) % lag] - params->element[(m - n) % lag];
+		uint16_t res;
+
+		/* Only the neighbouring elements have no phase ambiguity up to
+		 * a spacing of half a wavelength.
+		 */
+		if (((step != 1) && (step != -1)) ||
+		    !sample_valid(iq, m) || !sample_valid(iq, m + 1)) {
+			continue;
+		}
+
+		res = (uint16_t)(phase[m + 1] - phase[m]) - adv;
+		if (step < 0) {
+			res = -res;
+		}
+
+		sum_cos += dtm_iq_sin_q15(res + DTM_IQ_TURN / 4);
+		sum_sin += dtm_iq_sin_q15(res);
+		pairs++;
+	}
+
+	if (pairs == 0) {
+		return -EINVAL;
+	}
+
+	avg_cos = (int16_t)(sum_cos / (int32_t)pairs);
+	avg_sin = (int16_t)(sum_sin / (int32_t)pairs);
+	diff = (int16_t)dtm_iq_phase(avg_cos, avg_sin);
+
+	/* The phase difference is a full turn times the spacing times the sine
+	 * of the angle.
+	 */
+	sin_theta = ((int32_t)diff * (DTM_IQ_TURN / 4)) / params->spacing;
+	sin_theta = (sin_theta > INT16_MAX) ? INT16_MAX :
+		    ((sin_theta < -INT16_MAX) ? -INT16_MAX : sin_theta);
+
+	/* Arcsine as the phase of the unit vector with the sine as Q. */
+	cos_theta = dtm_iq_isqrt((1ULL << 30) - (uint64_t)(sin_theta * sin_theta));
+	theta = (int16_t)dtm_iq_phase((int16_t)((cos_theta > INT16_MAX) ? INT16_MAX : cos_theta),
+				      (int16_t)sin_theta);
+
+	aoa->angle = (int16_t)((theta * 3600 + ((theta < 0) ? -DTM_IQ_TURN / 2 :
+						     DTM_IQ_TURN / 2)) / DTM_IQ_TURN);
+	aoa->quality = (uint16_t)dtm_iq_isqrt((int64_t)avg_cos * avg_cos +
+					      (int64_t)avg_sin * avg_sin);
+	aoa->pairs = pairs;
+
+	return 0;
+}
+
+/* Bits of the block width of the packed format. */
+#define PACK_WIDTH_BITS 5
+
+/* Largest block width, all residual bits. */
+#define PACK_WIDTH_MAX 16
+
+/* Rotation by a phase advance of the tone, Q15. */
+struct pack_rot {
+	int32_t cos;
+	int32_t sin;
+};
+
+/* Rotations predicting the samples of a block. */
+struct pack_adv {
+	/* Between the reference period samples. */
+	struct pack_rot ref;
+
+	/* Between consecutive samples after the reference period. */
+	struct pack_rot step;
+
+	/* Between the samples taken with the same antenna. */
+	struct pack_rot lag;
+};
+
+struct bit_writer {
+	uint8_t *out;
+	size_t len;
+	uint32_t acc;
+	unsigned int cnt;
+};
+
+struct bit_reader {
+	const uint8_t *in;
+	size_t len;
+	size_t pos;
+	uint32_t acc;
+	unsigned int cnt;
+};
+
+static void bits_put(struct bit_writer *w, uint32_t val, unsigned int bits)
+{
+	w->acc |= val << w->cnt;
+	w->cnt += bits;
+
+	while (w->cnt >= 8) {
+		w->out[w->len++] = (uint8_t)w->acc;
+		w->acc >>= 8;
+		w->cnt -= 8;
+	}
+}
+
+static int bits_get(struct bit_reader *r, unsigned int bits, uint32_t *val)
+{
+	while (r->cnt < bits) {
+		if (r->pos == r->len) {
+			return -EINVAL;
+		}
+
+		r->acc |= (uint32_t)r->in[r->pos++] << r->cnt;
+		r->cnt += 8;
+	}
+
+	*val = r->acc & ((1UL << bits) - 1);
+	r->acc >>= bits;
+	r->cnt -= bits;
+
+	return 0;
+}
+
+/* Phase of a sum of products, scaled down to the CORDIC input range. */
+static uint16_t sum_phase(const int64_t *sum, uint16_t empty)
+{
+	int64_t re = sum[0];
+	int64_t im = sum[1];
+
+	if ((re == 0) && (im == 0)) {
+		return empty;
+	}
+
+	while ((re > INT16_MAX) || (re < -INT16_MAX) || (im > INT16_MAX) || (im < -INT16_MAX)) {
+		re /= 2;
+		im /= 2;
+	}
+
+	return dtm_iq_phase((int16_t)re, (int16_t)im);
+}
+
+static void pack_rot_set(struct pack_rot *rot, uint16_t angle)
+{
+	rot->cos = dtm_iq_sin_q15(angle + DTM_IQ_TURN / 4);
+	rot->sin = dtm_iq_sin_q15(angle);
+}
+
+static void pack_adv_get(const struct dtm_iq_codec *codec, struct pack_adv *adv)
+{
+	uint16_t ref = sum_phase(codec->ref_sum, codec->params.nominal);
+	uint16_t step = (uint16_t)(ref * codec->params.spacing_us);
+
+	pack_rot_set(&adv->ref, ref);
+	pack_rot_set(&adv->step, step);
+	pack_rot_set(&adv->lag, sum_phase(codec->lag_sum,
+					  (uint16_t)(step * codec->params.period)));
+}
+
+static void sample_predict(const struct dtm_iq_codec *codec, const struct pack_adv *adv,
+			   const int16_t *iq, size_t k, int32_t *pred)
+{
+	size_t n = codec->params.ref_count;
+	const struct pack_rot *rot;
+	size_t from;
+
+	pred[0] = 0;
+	pred[1] = 0;
+
+	if (k == 0) {
+		return;
+	}
+
+	if (k < n) {
+		from = k - 1;
+		rot = &adv->ref;
+	} else if (k < n + codec->params.period) {
+		/* No earlier sample of the same antenna yet. */
+		from = k - 1;
+		rot = &adv->step;
+	} else {
+		from = k - codec->params.period;
+		rot = &adv->lag;
+	}
+
+	if (!sample_valid(iq, from)) {
+		return;
+	}
+
+	pred[0] = (int32_t)((((int64_t)iq[2 * from] * rot->cos) -
+			     ((int64_t)iq[2 * from + 1] * rot->sin) + (1 << 14)) >> 15);
+	pred[1] = (int32_t)((((int64_t)iq[2 * from] * rot->sin) +
+			     ((int64_t)iq[2 * from + 1] * rot->cos) + (1 << 14)) >> 15);
+}
+
+/* Accumulate the phase advance ending at a sample. */
+static void sums_update(struct dtm_iq_codec *codec, const int16_t *iq, size_t k)
+{
+	size_t n = codec->params.ref_count;
+	size_t prev;
+	int64_t *sum;
+
+	if ((k > 0) && (k < n)) {
+		prev = k - 1;
+		sum = codec->ref_sum;
+	} else if (k >= n + codec->params.period) {
+		prev = k - codec->params.period;
+		sum = codec->lag_sum;
+	} else {
+		return;
+	}
+
+	if (!sample_valid(iq, k) || !sample_valid(iq, prev)) {
+		return;
+	}
+
+	/* Sample times the conjugate of the earlier sample. */
+	sum[0] += ((int64_t)iq[2 * k] * iq[2 * prev]) + ((int64_t)iq[2 * k + 1] * iq[2 * prev + 1]);
+	sum[1] += ((int64_t)iq[2 * k + 1] * iq[2 * prev]) - ((int64_t)iq[2 * k] * iq[2 * prev + 1]);
+}
+
+void dtm_iq_codec_init(struct dtm_iq_codec *codec, const struct dtm_iq_cfo_params *params)
+{
+	memset(codec, 0, sizeof(*codec));
+	codec->params = *params;
+
+	if (codec->params.period == 0) {
+		codec->params.period = 1;
+	}
+}
+
+size_t dtm_iq_pack(struct dtm_iq_codec *codec, const int16_t *iq, size_t count,
+		   uint8_t *out, size_t size)
+{
+	struct bit_writer w = {
+		.out = out,
+	};
+	uint16_t res[2 * DTM_IQ_PACK_BLOCK];
+	struct pack_adv adv;
+	int32_t pred[2];
+
+	while (codec->next < count) {
+		size_t first = codec->next;
+		size_t n = ((count - first) < DTM_IQ_PACK_BLOCK) ? (count - first) :
+			   DTM_IQ_PACK_BLOCK;
+		uint16_t bits = 0;
+		unsigned int width = 0;
+
+		pack_adv_get(codec, &adv);
+
+		for (size_t j = 0; j < n; j++) {
+			sample_predict(codec, &adv, iq, first + j, pred);
+
+			for (size_t c = 0; c < 2; c++) {
+				/* The residual wraps around, as the reconstruction. */
+				int16_t r = (int16_t)(uint16_t)(iq[2 * (first + j) + c] - pred[c]);
+
+				res[2 * j + c] = (uint16_t)(((uint16_t)r << 1) ^ (uint16_t)(r >> 15));
+				bits |= res[2 * j + c];
+			}
+		}
+
+		while (bits >> width) {
+			width++;
+		}
+
+		if ((w.len + ((w.cnt + PACK_WIDTH_BITS + (2 * n * width) + 7) / 8)) > size) {
+			break;
+		}
+
+		bits_put(&w, width, PACK_WIDTH_BITS);
+
+		for (size_t j = 0; j < 2 * n; j++) {
+			bits_put(&w, res[j], width);
+		}
+
+		for (size_t j = 0; j < n; j++) {
+			sums_update(codec, iq, first + j);
+		}
+
+		codec->next += n;
+	}
+
+	if (w.cnt) {
+		w.out[w.len++] = (uint8_t)w.acc;
+	}
+
+	return w.len;
+}
+
+int dtm_iq_unpack(struct dtm_iq_codec *codec, const uint8_t *in, size_t len,
+		  int16_t *iq, size_t end)
+{
+	struct bit_reader r = {
+		.in = in,
+		.len = len,
+	};
+	struct pack_adv adv;
+	int32_t pred[2];
+	uint32_t width;
+	uint32_t val;
+
+	while (codec->next < end) {
+		size_t first = codec->next;
+		size_t n = ((end - first) < DTM_IQ_PACK_BLOCK) ? (end - first) :
+			   DTM_IQ_PACK_BLOCK;
+
+		pack_adv_get(codec, &adv);
+
+		if (bits_get(&r, PACK_WIDTH_BITS, &width) || (width > PACK_WIDTH_MAX)) {
+			return -EINVAL;
+		}
+
+		for (size_t j = 0; j < n; j++) {
+			size_t k = first + j;
+
+			sample_predict(codec, &adv, iq, k, pred);
+
+			for (size_t c = 0; c < 2; c++) {
+				if (bits_get(&r, width, &val)) {
+					return -EINVAL;
+				}
+
+				iq[2 * k + c] = (int16_t)(uint16_t)(pred[c] +
+								    ((int32_t)(val >> 1) ^ -(int32_t)(val & 1)));
+			}
+
+			sums_update(codec, iq, k);
+		}
+
+		codec->next += n;
+	}
+
+	return 0;
+}
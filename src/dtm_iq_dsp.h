@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_IQ_DSP_H_
+#define DTM_IQ_DSP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fixed-point kernels processing the CTE IQ samples on the device.
+ * They only depend on the C library, so the same sources are built and
+ * checked on the host, see scripts/dtm_iq_check.py.
+ *
+ * The IQ samples are passed as I and Q interleaved, the memory layout of
+ * struct dtm_iq_sample. The phases are binary angles, a full turn is 65536.
+ */
+
+/** Binary angle of a full turn. */
+#define DTM_IQ_TURN 65536
+
+/** Invalid IQ sample value, as NRF_IQ_SAMPLE_INVALID. */
+#define DTM_IQ_INVALID INT16_MIN
+
+/** @brief Sampling of the CTE for the frequency offset estimation. */
+struct dtm_iq_cfo_params {
+	/** Number of reference period samples, taken 1 us apart. */
+	uint8_t ref_count;
+
+	/** Spacing of the samples after the reference period, in microseconds. */
+	uint8_t spacing_us;
+
+	/** Number of samples after the reference period between two samples
+	 *  taken with the same antenna, 1 if the antenna is not switched.
+	 */
+	uint8_t period;
+
+	/** Phase advance of the nominal CTE tone in 1 us, binary angle. */
+	uint16_t nominal;
+};
+
+/** @brief Frequency offset of a received CTE. */
+struct dtm_iq_cfo {
+	/** Frequency offset over the whole CTE, in Hz. */
+	int32_t offset_hz;
+
+	/** Frequency offset in the reference period, in Hz. */
+	int32_t ref_hz;
+
+	/** Frequency offset in the second half of the samples after the
+	 *  reference period minus the offset in the first half, in Hz.
+	 */
+	int32_t drift_hz;
+
+	/** Number of sample pairs used after the reference period. */
+	uint16_t pairs;
+};
+
+/** @brief Antenna array of the angle of arrival estimation. */
+struct dtm_iq_aoa_params {
+	/** CTE sampling, the antennas are switched with a period of
+	 *  cfo.period samples after the reference period.
+	 */
+	struct dtm_iq_cfo_params cfo;
+
+	/** Position of the antenna of each sample in the switching period,
+	 *  in elements of a uniform linear array.
+	 */
+	const uint8_t *element;
+
+	/** Spacing of the array elements in wavelengths, Q15. */
+	uint16_t spacing;
+};
+
+/** @brief Angle of arrival of a received CTE. */
+struct dtm_iq_aoa {
+	/** Angle from the array broadside in 0.1 degree, -900 to 900, positive
+	 *  when the wave reaches the elements at the higher positions first.
+	 */
+	int16_t angle;
+
+	/** Coherence of the phase differences between the elements, Q15.
+	 *  32767 if all the sample pairs agree, close to 0 for noise.
+	 */
+	uint16_t quality;
+
+	/** Number of sample pairs of neighbouring elements used. */
+	uint16_t pairs;
+};
+
+/** Number of IQ samples of a block of the packed format. */
+#define DTM_IQ_PACK_BLOCK 4
+
+/** @brief State of the packed IQ sample format coder.
+ *
+ * The encoder and the decoder keep the same state, so the samples of a CTE
+ * are packed and unpacked in the same pieces, in order.
+ */
+struct dtm_iq_codec {
+	/** CTE sampling. */
+	struct dtm_iq_cfo_params params;
+
+	/** Index of the next sample. */
+	size_t next;
+
+	/** Sum of the products of the reference period samples with the
+	 *  conjugate of the previous sample, real and imaginary part.
+	 */
+	int64_t ref_sum[2];
+
+	/** Sum of the products of the samples after the reference period with
+	 *  the conjugate of the sample taken with the same antenna before,
+	 *  real and imaginary part.
+	 */
+	int64_t lag_sum[2];
+};
+
+/** @brief Get the sine of a binary angle.
+ *
+ * The sine is interpolated from a quarter wave table of 64 segments, the
+ * error is at most 3 Q15 units. The cosine is the sine of the angle plus a
+ * quarter turn.
+ *
+ * @param[in] angle Binary angle.
+ *
+ * @return Sine in Q15.
+ */
+int16_t dtm_iq_sin_q15(uint16_t angle);
+
+/** @brief Get the phase of an IQ sample.
+ *
+ * The phase is computed with CORDIC in 14 iterations, the error is below
+ * 2 binary angle units (0.011 degrees).
+ *
+ * @param[in] i I sample value.
+ * @param[in] q Q sample value.
+ *
+ * @return Phase as a binary angle, 0 for the zero sample.
+ */
+uint16_t dtm_iq_phase(int16_t i, int16_t q);
+
+/** @brief Get the integer square root.
+ *
+ * @param[in] val Value.
+ *
+ * @return Square root of the value, rounded down.
+ */
+uint32_t dtm_iq_isqrt(uint64_t val);
+
+/** @brief Estimate the carrier frequency offset of a received CTE.
+ *
+ * The phase of the samples is derotated with the nominal CTE tone. The
+ * phase slope over the reference period gives a first estimate, which
+ * unwraps the phase advance between the later samples taken with the same
+ * antenna. The advance of all sample pairs, combined with the reference
+ * period slope in proportion to their precision, gives the offset over the
+ * whole CTE, and its change between the first and the second half gives
+ * the drift.
+ * Pairs with an invalid sample are skipped.
+ *
+ * @param[in]  iq     IQ samples, I and Q interleaved.
+ * @param[in]  count  Number of IQ samples.
+ * @param[in]  params CTE sampling.
+ * @param[out] cfo    Frequency offset.
+ *
+ * @retval 0 in case of success.
+ * @retval -EINVAL if the parameters are invalid or a reference sample is invalid.
+ */
+int dtm_iq_cfo_estimate(const int16_t *iq, size_t count,
+			const struct dtm_iq_cfo_params *params, struct dtm_iq_cfo *cfo);
+
+/** @brief Estimate the angle of arrival of a received CTE.
+ *
+ * The phase difference between two consecutive samples taken with
+ * neighbouring elements is the phase advance of the tone, from the
+ * frequency offset of dtm_iq_cfo_estimate(), plus the phase difference
+ * of the wave between the elements. The unit vectors of the differences
+ * left after the tone advance are averaged, the phase of the average gives
+ * the angle and its length the quality.
+ * The phase differences of the antenna paths are not calibrated.
+ *
+ * @param[in]  iq     IQ samples, I and Q interleaved.
+ * @param[in]  count  Number of IQ samples.
+ * @param[in]  params Antenna array and CTE sampling.
+ * @param[out] aoa    Angle of arrival.
+ *
+ * @retval 0 in case of success.
+ * @retval -EINVAL if the parameters are invalid, a reference sample is
+ *         invalid or no sample pair of neighbouring elements is valid.
+ */
+int dtm_iq_aoa_estimate(const int16_t *iq, size_t count,
+			const struct dtm_iq_aoa_params *params, struct dtm_iq_aoa *aoa);
+
+/** @brief Start packing or unpacking the IQ samples of a CTE.
+ *
+ * @param[out] codec  Coder state.
+ * @param[in]  params CTE sampling, the nominal tone and the antenna switching
+ *                    period drive the prediction of the samples.
+ */
+void dtm_iq_codec_init(struct dtm_iq_codec *codec, const struct dtm_iq_cfo_params *params);
+
+/** @brief Pack the IQ samples of a CTE losslessly.
+ *
+ * Each sample is predicted from an earlier sample, rotated by the phase
+ * advance of the tone measured so far: the previous sample in the reference
+ * period and the previous sample taken with the same antenna after it. The
+ * prediction residuals are zigzag coded and packed in blocks of
+ * DTM_IQ_PACK_BLOCK samples, with the bit width of the largest residual of
+ * the block in 5 bits followed by the I and Q residuals of each sample.
+ *
+ * Whole blocks are packed from the next sample while they fit the buffer,
+ * the rest is packed by the next call into another buffer.
+ *
+ * @param[in,out] codec Coder state.
+ * @param[in]     iq    IQ samples, I and Q interleaved, the whole CTE.
+ * @param[in]     count Number of IQ samples.
+ * @param[out]    out   Packed data.
+ * @param[in]     size  Size of the packed data buffer.
+ *
+ * @return Length of the packed data, the last octet padded with zero bits.
+ */
+size_t dtm_iq_pack(struct dtm_iq_codec *codec, const int16_t *iq, size_t count,
+		   uint8_t *out, size_t size);
+
+/** @brief Unpack IQ samples packed with dtm_iq_pack().
+ *
+ * @param[in,out] codec Coder state.
+ * @param[in]     in    Packed data of one dtm_iq_pack() call.
+ * @param[in]     len   Length of the packed data.
+ * @param[out]    iq    IQ samples, I and Q interleaved, the whole CTE.
+ * @param[in]     end   Index after the last sample of the packed data.
+ *
+ * @retval 0 in case of success.
+ * @retval -EINVAL if the packed data is shorter than the samples.
+ */
+int dtm_iq_unpack(struct dtm_iq_codec *codec, const uint8_t *in, size_t len,
+		  int16_t *iq, size_t end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_IQ_DSP_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+#include "dtm_iq_stream.h"
+#include "dtm_vendor.h"
+
+/* CTE sampling of the receiver test. */
+static struct dtm_iq_cfo_params stream_params;
+
+/* Packet number of the next report. */
+static uint16_t stream_packet;
+
+static dtm_iq_stream_cb_t stream_cb;
+
+/* Only used from the radio interrupt processing, kept off its stack. */
+static uint8_t piece[DTM_VENDOR_RSP_MAX_SIZE];
+
+void dtm_iq_stream_start(const struct dtm_iq_cfo_params *params)
+{
+	unsigned int key = irq_lock();
+
+	stream_params = *params;
+	stream_packet = 0;
+
+	irq_unlock(key);
+}
+
+bool dtm_iq_stream_enabled(void)
+{
+	return stream_cb != NULL;
+}
+
+void dtm_iq_stream_report(const struct dtm_iq_data *data)
+{
+	struct dtm_iq_stream_hdr *hdr = (struct dtm_iq_stream_hdr *)piece;
+	dtm_iq_stream_cb_t cb = stream_cb;
+	struct dtm_iq_codec codec;
+	size_t len;
+
+	if (!cb) {
+		return;
+	}
+
+	*hdr = (struct dtm_iq_stream_hdr) {
+		.packet = stream_packet++,
+		.channel = data->channel,
+		.rssi = data->rssi,
+		.rssi_ant = data->rssi_ant,
+		.type = data->type,
+		.slot = data->slot,
+		.status = data->status,
+		.sample_cnt = data->sample_cnt,
+		.ref_count = stream_params.ref_count,
+		.spacing_us = stream_params.spacing_us,
+		.period = stream_params.period,
+		.nominal = stream_params.nominal,
+	};
+
+	dtm_iq_codec_init(&codec, &stream_params);
+
+	/* A piece holds at least one block of samples. */
+	do {
+		hdr->first = codec.next;
+		len = dtm_iq_pack(&codec, (const int16_t *)data->samples, data->sample_cnt,
+				  piece + sizeof(*hdr), sizeof(piece) - sizeof(*hdr));
+		hdr->count = codec.next - hdr->first;
+
+		cb(piece, sizeof(*hdr) + len);
+	} while (codec.next < data->sample_cnt);
+}
+
+void dtm_iq_stream_cb_set(dtm_iq_stream_cb_t cb)
+{
+	stream_cb = cb;
+}
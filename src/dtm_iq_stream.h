@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_IQ_STREAM_H_
+#define DTM_IQ_STREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#include "dtm.h"
+#include "dtm_iq_dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Header of a piece of the packed IQ samples of a packet.
+ *
+ * The header is followed by the samples packed with dtm_iq_pack(), from the
+ * first sample of the piece. The pieces of a packet are sent in order, the
+ * samples of a piece are unpacked with the coder state left by the previous
+ * pieces, started with the CTE sampling of the header.
+ * The structure is also the wire format of the header, little-endian.
+ */
+struct dtm_iq_stream_hdr {
+	/** Packet number since the receiver test started. */
+	uint16_t packet;
+
+	/** DTM channel. */
+	uint8_t channel;
+
+	/** RSSI of the packet, in 0.1 dBm. */
+	int16_t rssi;
+
+	/** Antenna used to measure the RSSI. */
+	uint8_t rssi_ant;
+
+	/** CTE type, see enum dtm_cte_type. */
+	uint8_t type;
+
+	/** CTE slot duration, see enum dtm_cte_slot_duration. */
+	uint8_t slot;
+
+	/** Packet status, see enum dtm_packet_status. */
+	uint8_t status;
+
+	/** Number of samples of the packet. */
+	uint8_t sample_cnt;
+
+	/** Index of the first sample of the piece. */
+	uint8_t first;
+
+	/** Number of samples of the piece. */
+	uint8_t count;
+
+	/** Number of reference period samples, see struct dtm_iq_cfo_params. */
+	uint8_t ref_count;
+
+	/** Spacing of the samples after the reference period, in microseconds. */
+	uint8_t spacing_us;
+
+	/** Antenna switching period in samples. */
+	uint8_t period;
+
+	/** Phase advance of the nominal CTE tone in 1 us, binary angle. */
+	uint16_t nominal;
+} __packed;
+
+/** @brief Callback to send a piece of the packed IQ samples of a packet.
+ *
+ * @note The callback is called from the interrupt context.
+ *
+ * @param[in] data Piece, struct dtm_iq_stream_hdr followed by the packed samples.
+ * @param[in] len  Length of the piece.
+ */
+typedef void (*dtm_iq_stream_cb_t)(const uint8_t *data, size_t len);
+
+#if CONFIG_DTM_IQ_STREAM
+/** @brief Set the CTE sampling, called when a receiver test starts.
+ *
+ * @param[in] params CTE sampling of the test.
+ */
+void dtm_iq_stream_start(const struct dtm_iq_cfo_params *params);
+
+/** @brief Check if the IQ samples are streamed packed.
+ *
+ * @return true if the packed stream replaces the IQ report callback.
+ */
+bool dtm_iq_stream_enabled(void);
+
+/** @brief Pack the IQ samples of a received packet and send them.
+ *
+ * @param[in] data IQ sampling data.
+ */
+void dtm_iq_stream_report(const struct dtm_iq_data *data);
+
+/** @brief Set the callback sending the packed IQ samples.
+ *
+ * @param[in] cb Callback, NULL to stop the stream and go back to the IQ
+ *               report callback.
+ */
+void dtm_iq_stream_cb_set(dtm_iq_stream_cb_t cb);
+#else
+static inline void dtm_iq_stream_start(const struct dtm_iq_cfo_params *params)
+{
+	ARG_UNUSED(params);
+}
+
+static inline bool dtm_iq_stream_enabled(void)
+{
+	return false;
+}
+
+static inline void dtm_iq_stream_report(const struct dtm_iq_data *data)
+{
+	ARG_UNUSED(data);
+}
+#endif /* CONFIG_DTM_IQ_STREAM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_IQ_STREAM_H_ */
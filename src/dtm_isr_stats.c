@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm_isr_stats.h"
+#include "dtm_telemetry.h"
+
+/* Running statistics of a handler. */
+struct isr_stat {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t hist[DTM_ISR_STATS_HIST_BINS];
+};
+
+static struct isr_stat isr_stats[DTM_ISR_COUNT];
+
+static const char *const isr_names[DTM_ISR_COUNT] = {
+	[DTM_ISR_RADIO] = "radio_handler",
+	[DTM_ISR_RADIO_END] = "on_radio_end_event",
+	[DTM_ISR_CHECK_PDU] = "check_pdu",
+	[DTM_ISR_REPORT_IQ] = "report_iq",
+	[DTM_ISR_ANOMALY_172] = "anomaly_172_rssi_handle",
+	[DTM_ISR_RADIO_DEFERRED] = "radio_deferred_handler",
+};
+
+static uint32_t hist_bin(uint32_t cycles)
+{
+	uint32_t scaled = cycles / DTM_ISR_STATS_HIST_BASE;
+
+	if (scaled == 0) {
+		return 0;
+	}
+
+	return MIN(31 - __builtin_clz(scaled), DTM_ISR_STATS_HIST_BINS - 1);
+}
+
+/* The handlers run at different priorities and can preempt each other.
+ * The zero-latency radio interrupt is not masked by irq_lock().
+ */
+static inline unsigned int stats_lock(void)
+{
+#if CONFIG_DTM_RADIO_ZLI
+	unsigned int key = __get_PRIMASK();
+
+	__disable_irq();
+
+	return key;
+#else
+	return irq_lock();
+#endif /* CONFIG_DTM_RADIO_ZLI */
+}
+
+static inline void stats_unlock(unsigned int key)
+{
+#if CONFIG_DTM_RADIO_ZLI
+	__set_PRIMASK(key);
+#else
+	irq_unlock(key);
+#endif /* CONFIG_DTM_RADIO_ZLI */
+}
+
+void dtm_isr_stats_record(enum dtm_isr_id id, uint32_t start)
+{
+	/* Unsigned arithmetic handles the counter wrap-around. */
+	uint32_t cycles = DWT->CYCCNT - start;
+	struct isr_stat *stat = &isr_stats[id];
+	unsigned int key;
+
+	key = stats_lock();
+
+	stat->count++;
+	stat->sum += cycles;
+	stat->min = MIN(stat->min, cycles);
+	stat->max = MAX(stat->max, cycles);
+	stat->hist[hist_bin(cycles)]++;
+
+	dtm_telemetry_isr(id, stat->count, stat->max);
+
+	stats_unlock(key);
+}
+
+void dtm_isr_stats_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	dtm_isr_stats_reset();
+}
+
+void dtm_isr_stats_reset(void)
+{
+	unsigned int key = stats_lock();
+
+	memset(isr_stats, 0, sizeof(isr_stats));
+	for (size_t i = 0; i < ARRAY_SIZE(isr_stats); i++) {
+		isr_stats[i].min = UINT32_MAX;
+		dtm_telemetry_isr(i, 0, 0);
+	}
+
+	stats_unlock(key);
+}
+
+int dtm_isr_stats_get(enum dtm_isr_id id, struct dtm_isr_stat *stat)
+{
+	struct isr_stat tmp;
+	unsigned int key;
+
+	if ((id >= DTM_ISR_COUNT) || !stat) {
+		return -EINVAL;
+	}
+
+	key = stats_lock();
+	tmp = isr_stats[id];
+	stats_unlock(key);
+
+	stat->count = tmp.count;
+	stat->min = tmp.count ? tmp.min : 0;
+	stat->max = tmp.max;
+	stat->avg = tmp.count ? (uint32_t)(tmp.sum / tmp.count) : 0;
+	memcpy(stat->hist, tmp.hist, sizeof(stat->hist));
+
+	return 0;
+}
+
+const char *dtm_isr_stats_name(enum dtm_isr_id id)
+{
+	return (id < DTM_ISR_COUNT) ? isr_names[id] : "unknown";
+}
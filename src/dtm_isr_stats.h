@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_ISR_STATS_H_
+#define DTM_ISR_STATS_H_
+
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#if CONFIG_DTM_ISR_STATS
+#include <nrfx.h>
+#endif /* CONFIG_DTM_ISR_STATS */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of histogram bins. Bin 0 counts executions shorter than
+ *  2 * DTM_ISR_STATS_HIST_BASE cycles, bin n counts executions of
+ *  DTM_ISR_STATS_HIST_BASE * 2^n to DTM_ISR_STATS_HIST_BASE * 2^(n + 1) cycles,
+ *  the last bin counts all longer executions.
+ */
+#define DTM_ISR_STATS_HIST_BINS 16
+
+/** Execution time of the first histogram bin in CPU cycles. */
+#define DTM_ISR_STATS_HIST_BASE 64
+
+/** @brief Instrumented interrupt handlers. */
+enum dtm_isr_id {
+	/** Radio interrupt handler. */
+	DTM_ISR_RADIO,
+
+	/** Radio END event handling. */
+	DTM_ISR_RADIO_END,
+
+	/** Received PDU check. */
+	DTM_ISR_CHECK_PDU,
+
+	/** IQ samples report. */
+	DTM_ISR_REPORT_IQ,
+
+	/** Anomaly 172 RSSI sample handling. */
+	DTM_ISR_ANOMALY_172,
+
+	/** Processing deferred from the radio interrupt handler. */
+	DTM_ISR_RADIO_DEFERRED,
+
+	/** Number of the instrumented handlers. */
+	DTM_ISR_COUNT
+};
+
+/** @brief Execution time statistics of a handler, in CPU cycles.
+ *
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_isr_stat {
+	/** Number of executions. */
+	uint32_t count;
+
+	/** Shortest execution. */
+	uint32_t min;
+
+	/** Longest execution. */
+	uint32_t max;
+
+	/** Average execution. */
+	uint32_t avg;
+
+	/** Execution time histogram. */
+	uint32_t hist[DTM_ISR_STATS_HIST_BINS];
+} __packed;
+
+#if CONFIG_DTM_ISR_STATS
+/** @brief Get the start timestamp of a handler execution.
+ *
+ * @return Cycle counter value.
+ */
+static inline uint32_t dtm_isr_stats_start(void)
+{
+	return DWT->CYCCNT;
+}
+
+/** @brief Record a handler execution.
+ *
+ * @param[in] id    Handler.
+ * @param[in] start Timestamp returned by dtm_isr_stats_start().
+ */
+void dtm_isr_stats_record(enum dtm_isr_id id, uint32_t start);
+
+/** @brief Initialize the cycle counter. */
+void dtm_isr_stats_init(void);
+
+/** @brief Clear the statistics, called when a test starts. */
+void dtm_isr_stats_reset(void);
+
+/** @brief Get the statistics of a handler.
+ *
+ * @param[in]  id   Handler.
+ * @param[out] stat Statistics since the start of the current or last test.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_isr_stats_get(enum dtm_isr_id id, struct dtm_isr_stat *stat);
+
+/** @brief Get the name of a handler.
+ *
+ * @param[in] id Handler.
+ *
+ * @return Handler name.
+ */
+const char *dtm_isr_stats_name(enum dtm_isr_id id);
+#else
+static inline uint32_t dtm_isr_stats_start(void)
+{
+	return 0;
+}
+
+static inline void dtm_isr_stats_record(enum dtm_isr_id id, uint32_t start)
+{
+	ARG_UNUSED(id);
+	ARG_UNUSED(start);
+}
+
+static inline void dtm_isr_stats_init(void)
+{
+}
+
+static inline void dtm_isr_stats_reset(void)
+{
+}
+#endif /* CONFIG_DTM_ISR_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_ISR_STATS_H_ */
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm.h"
+#include "dtm_config.h"
+#include "dtm_exec.h"
+#include "dtm_per.h"
+
+#if CONFIG_DTM_TEST_PLAN
+#include "dtm_test_plan.h"
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+LOG_MODULE_REGISTER(dtm_per, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
+
+#define DTM_PEER_UART DT_CHOSEN(ncs_dtm_peer_uart)
+
+/* Two Wire command codes, bits 15:14 of the command. */
+#define PEER_CMD_SETUP 0x0000
+#define PEER_CMD_TX    0x8000
+#define PEER_CMD_END   0xC000
+
+/* Test Setup controls, bits 13:8 of the command. */
+#define PEER_SETUP_RESET   0x00
+#define PEER_SETUP_SET_PHY 0x02
+
+/* Test Setup command: control in bits 13:8, parameter in bits 7:0. */
+#define PEER_SETUP_WORD(control, param) \
+	(PEER_CMD_SETUP | (((control) & 0x3F) << 8) | ((param) & 0xFF))
+
+/* Transmitter Test command: channel in bits 13:8, length in bits 7:2,
+ * packet type in bits 1:0. Packet type 0 is PRBS9.
+ */
+#define PEER_TX_WORD(channel, length) \
+	(PEER_CMD_TX | (((channel) & 0x3F) << 8) | (((length) & 0x3F) << 2))
+
+/* Decode the words the way cmd_execute() does on the peer. */
+#define PEER_DEC_CODE(cmd)    (((cmd) >> 14) & 0x03)
+#define PEER_DEC_CHAN(cmd)    (((cmd) >> 8) & 0x3F)
+#define PEER_DEC_LENGTH(cmd)  (((cmd) >> 2) & 0x3F)
+#define PEER_DEC_TYPE(cmd)    ((cmd) & 0x03)
+#define PEER_DEC_CONTROL(cmd) (((cmd) >> 8) & 0x3F)
+#define PEER_DEC_PARAM(cmd)   ((uint8_t)(cmd))
+
+BUILD_ASSERT(PEER_DEC_CODE(PEER_TX_WORD(39, CONFIG_DTM_PER_PACKET_LENGTH)) ==
+	     (PEER_CMD_TX >> 14));
+BUILD_ASSERT(PEER_DEC_CHAN(PEER_TX_WORD(39, CONFIG_DTM_PER_PACKET_LENGTH)) == 39);
+BUILD_ASSERT(PEER_DEC_LENGTH(PEER_TX_WORD(39, CONFIG_DTM_PER_PACKET_LENGTH)) ==
+	     CONFIG_DTM_PER_PACKET_LENGTH);
+BUILD_ASSERT(PEER_DEC_TYPE(PEER_TX_WORD(39, CONFIG_DTM_PER_PACKET_LENGTH)) == 0);
+BUILD_ASSERT(PEER_DEC_CODE(PEER_SETUP_WORD(PEER_SETUP_SET_PHY, 4)) ==
+	     (PEER_CMD_SETUP >> 14));
+BUILD_ASSERT(PEER_DEC_CONTROL(PEER_SETUP_WORD(PEER_SETUP_SET_PHY, 4)) ==
+	     PEER_SETUP_SET_PHY);
+BUILD_ASSERT(PEER_DEC_PARAM(PEER_SETUP_WORD(PEER_SETUP_SET_PHY, 4)) == 4);
+
+/* Error bit of the Test Status event. */
+#define PEER_EVT_STATUS_ERROR BIT(0)
+
+/* Maximum time for the peer response. */
+#define PEER_RSP_TIMEOUT_MS 50
+
+/* Time for the peer transmitter to settle before the receive window. */
+#define PEER_TX_SETTLE_US 2000
+
+/* Highest DTM channel. */
+#define PER_CHANNEL_MAX 39
+
+/* Number of PHYs, see enum dtm_phy. */
+#define PER_PHY_COUNT 4
+
+/* Flags of the PER thread. */
+enum {
+	PER_RUNNING,
+	PER_STOP,
+};
+
+static const struct device *peer_uart = DEVICE_DT_GET(DTM_PEER_UART);
+
+static K_SEM_DEFINE(per_run_sem, 0, 1);
+static atomic_t per_flags;
+
+static struct dtm_per_config per_cfg;
+static dtm_per_done_cb_t per_done_cb;
+
+static struct dtm_per_result results[DTM_PER_RESULTS_MAX];
+static uint16_t result_count;
+
+static uint16_t setup_cmd(uint8_t control, uint8_t param)
+{
+	return PEER_SETUP_WORD(control, param);
+}
+
+/* Send a Two Wire command to the peer and wait for the event. */
+static int peer_cmd(uint16_t cmd, uint16_t *evt)
+{
+	int64_t deadline = k_uptime_get() + PEER_RSP_TIMEOUT_MS;
+	uint8_t rsp[2];
+	size_t len = 0;
+	uint8_t byte;
+
+	/* Drop stale bytes of an earlier, timed out response. */
+	while (uart_poll_in(peer_uart, &byte) == 0) {
+	}
+
+	uart_poll_out(peer_uart, (cmd >> 8) & 0xFF);
+	uart_poll_out(peer_uart, cmd & 0xFF);
+
+	while (len < sizeof(rsp)) {
+		if (uart_poll_in(peer_uart, &rsp[len]) == 0) {
+			len++;
+			continue;
+		}
+
+		if (k_uptime_get() > deadline) {
+			LOG_ERR("Peer command 0x%04x timed out", cmd);
+			return -ETIMEDOUT;
+		}
+
+		k_sleep(K_MSEC(1));
+	}
+
+	*evt = (rsp[0] << 8) | rsp[1];
+
+	return 0;
+}
+
+static int peer_setup(uint16_t cmd)
+{
+	uint16_t evt;
+	int err;
+
+	err = peer_cmd(cmd, &evt);
+	if (err) {
+		return err;
+	}
+
+	return (evt & PEER_EVT_STATUS_ERROR) ? -EIO : 0;
+}
+
+static int peer_phy_set(enum dtm_phy phy)
+{
+	int err;
+
+	err = peer_setup(setup_cmd(PEER_SETUP_RESET, 0));
+	if (err) {
+		return err;
+	}
+
+	/* The Two Wire PHY parameter starts at 1 for the LE 1M PHY. */
+	return peer_setup(setup_cmd(PEER_SETUP_SET_PHY, phy + 1));
+}
+
+/* Receiver step of the run. */
+struct rx_step {
+	/* Channel of the step. */
+	uint8_t channel;
+
+	/* Receive window, in microseconds. */
+	uint32_t window;
+};
+
+/* Engine commands of the run, executed by the DTM executor. */
+static int rx_start(void *ctx)
+{
+	struct rx_step *rx = ctx;
+
+	/* The receive window spans the requested number of peer packets. The
+	 * packet interval depends on the PHY of the engine, read here.
+	 */
+	rx->window = per_cfg.packets * dtm_packet_interval_get(CONFIG_DTM_PER_PACKET_LENGTH);
+
+	return dtm_test_receive(rx->channel);
+}
+
+static int rx_end(void *ctx)
+{
+	uint16_t cnt;
+
+	(void)dtm_rx_stats_get(ctx);
+
+	return dtm_test_end(&cnt);
+}
+
+static int engine_phy_set(void *ctx)
+{
+	int err;
+
+	err = dtm_setup_reset();
+	if (err) {
+		return err;
+	}
+
+	return dtm_setup_set_phy(*(enum dtm_phy *)ctx);
+}
+
+static int engine_reset(void *ctx)
+{
+	uint16_t cnt;
+
+	ARG_UNUSED(ctx);
+
+	/* End a test started by the transport or at boot. */
+	(void)dtm_test_end(&cnt);
+
+	return dtm_setup_reset();
+}
+
+static int step_run(enum dtm_phy phy, uint8_t channel, struct dtm_per_result *res)
+{
+	struct rx_step rx = {
+		.channel = channel,
+	};
+	struct dtm_rx_stats stats;
+	uint16_t evt;
+	int err;
+
+	/* Transmit PRBS9 packets, packet type 0. */
+	err = peer_setup(PEER_TX_WORD(channel, CONFIG_DTM_PER_PACKET_LENGTH));
+	if (err) {
+		return err;
+	}
+
+	k_sleep(K_USEC(PEER_TX_SETTLE_US));
+
+	err = dtm_exec_call(DTM_EXEC_CLIENT_RUNNER, rx_start, &rx);
+	if (!err) {
+		k_sleep(K_USEC(rx.window));
+		err = dtm_exec_call(DTM_EXEC_CLIENT_RUNNER, rx_end, &stats);
+	}
+
+	(void)peer_cmd(PEER_CMD_END, &evt);
+
+	if (err) {
+		return err;
+	}
+
+	res->phy = phy;
+	res->channel = channel;
+	res->expected = per_cfg.packets;
+	res->received = MIN(stats.packets, per_cfg.packets);
+	res->crc_errors = MIN(stats.crc_errors, UINT16_MAX);
+
+	return 0;
+}
+
+static int phy_run(enum dtm_phy phy)
+{
+	int err;
+
+	err = peer_phy_set(phy);
+	if (err) {
+		LOG_ERR("Peer PHY %d not set: %d", phy, err);
+		return err;
+	}
+
+	err = dtm_exec_call(DTM_EXEC_CLIENT_RUNNER, engine_phy_set, &phy);
+	if (err) {
+		return err;
+	}
+
+	for (uint8_t ch = 0; ch <= PER_CHANNEL_MAX; ch++) {
+		struct dtm_per_result *res = &results[result_count];
+
+		if (!(per_cfg.channels[ch / 8] & BIT(ch % 8))) {
+			continue;
+		}
+
+		if (atomic_test_bit(&per_flags, PER_STOP)) {
+			return -ECANCELED;
+		}
+
+		err = step_run(phy, ch, res);
+		if (err) {
+			LOG_ERR("PER step PHY %d channel %d failed: %d", phy, ch, err);
+			return err;
+		}
+
+		DTM_DIAG("[PER] PHY %d ch %d: %u/%u packets\n",
+			 phy, ch, res->received, res->expected);
+
+		result_count++;
+	}
+
+	return 0;
+}
+
+static void per_execute(void)
+{
+	result_count = 0;
+
+	(void)dtm_exec_call(DTM_EXEC_CLIENT_RUNNER, engine_reset, NULL);
+
+	for (int phy = 0; phy < PER_PHY_COUNT; phy++) {
+		if (!(per_cfg.phys & BIT(phy))) {
+			continue;
+		}
+
+		if (phy_run(phy)) {
+			break;
+		}
+	}
+
+	(void)dtm_exec_call(DTM_EXEC_CLIENT_RUNNER, engine_reset, NULL);
+
+	dtm_exec_release(DTM_EXEC_CLIENT_RUNNER);
+
+	atomic_clear_bit(&per_flags, PER_STOP);
+	atomic_clear_bit(&per_flags, PER_RUNNING);
+
+	if (per_done_cb) {
+		per_done_cb(result_count);
+	}
+}
+
+static void per_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		k_sem_take(&per_run_sem, K_FOREVER);
+		per_execute();
+	}
+}
+
+K_THREAD_DEFINE(dtm_per_thread, CONFIG_DTM_PER_THREAD_STACK_SIZE, per_thread,
+		NULL, NULL, NULL, CONFIG_DTM_PER_THREAD_PRIORITY, 0, 0);
+
+int dtm_per_run(const struct dtm_per_config *cfg, dtm_per_done_cb_t cb)
+{
+	int err;
+
+	if (!cfg || (cfg->packets == 0) || !(cfg->phys & BIT_MASK(PER_PHY_COUNT))) {
+		return -EINVAL;
+	}
+
+	if (!device_is_ready(peer_uart)) {
+		return -ENODEV;
+	}
+
+#if CONFIG_DTM_TEST_PLAN
+	if (dtm_test_plan_running()) {
+		return -EBUSY;
+	}
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+	if (atomic_test_and_set_bit(&per_flags, PER_RUNNING)) {
+		return -EBUSY;
+	}
+
+	/* The run owns the DTM engine until it ends. */
+	err = dtm_exec_claim(DTM_EXEC_CLIENT_RUNNER);
+	if (err) {
+		atomic_clear_bit(&per_flags, PER_RUNNING);
+		return err;
+	}
+
+	per_cfg = *cfg;
+	per_done_cb = cb;
+	k_sem_give(&per_run_sem);
+
+	return 0;
+}
+
+void dtm_per_stop(void)
+{
+	if (atomic_test_bit(&per_flags, PER_RUNNING)) {
+		atomic_set_bit(&per_flags, PER_STOP);
+	}
+}
+
+bool dtm_per_running(void)
+{
+	return atomic_test_bit(&per_flags, PER_RUNNING);
+}
+
+size_t dtm_per_results_get(uint16_t idx, struct dtm_per_result *res, size_t max)
+{
+	size_t count;
+
+	if (dtm_per_running() || (idx >= result_count)) {
+		return 0;
+	}
+
+	count = MIN(max, result_count - idx);
+	memcpy(res, &results[idx], count * sizeof(*res));
+
+	return count;
+}
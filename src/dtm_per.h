@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_PER_H_
+#define DTM_PER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of results of a packet error rate run, all channels on all PHYs. */
+#define DTM_PER_RESULTS_MAX (40 * 4)
+
+/** @brief Packet error rate run configuration.
+ *
+ * The structure is also the wire format of the configuration, little-endian.
+ */
+struct dtm_per_config {
+	/** Number of packets sent by the peer in each step. */
+	uint16_t packets;
+
+	/** PHYs to measure, bit n selects the PHY n of enum dtm_phy. */
+	uint8_t phys;
+
+	/** Channels to measure, bit n selects the DTM channel n. */
+	uint8_t channels[5];
+} __packed;
+
+/** @brief Result of a packet error rate step.
+ *
+ * The structure is also the wire format of the result, little-endian.
+ */
+struct dtm_per_result {
+	/** PHY, see enum dtm_phy. */
+	uint8_t phy;
+
+	/** DTM channel. */
+	uint8_t channel;
+
+	/** Number of packets sent by the peer during the receive window. */
+	uint16_t expected;
+
+	/** Number of packets received. */
+	uint16_t received;
+
+	/** Number of packets received with an invalid CRC. */
+	uint16_t crc_errors;
+} __packed;
+
+/** @brief Callback to report the end of a packet error rate run.
+ *
+ * @param[in] count Number of results.
+ */
+typedef void (*dtm_per_done_cb_t)(uint16_t count);
+
+/** @brief Start a packet error rate run in the PER thread.
+ *
+ * For each selected PHY and channel, the peer DUT transmits over the peer UART
+ * with the DTM Two Wire protocol while this device runs the receiver test.
+ *
+ * @param[in] cfg Run configuration.
+ * @param[in] cb  Callback called when the run ends, can be NULL.
+ *
+ * @retval 0 in case of success.
+ * @retval -EINVAL if the configuration is invalid.
+ * @retval -EBUSY if a run or a test plan is already running.
+ * @retval -ENODEV if the peer UART is not ready.
+ */
+int dtm_per_run(const struct dtm_per_config *cfg, dtm_per_done_cb_t cb);
+
+/** @brief Stop the packet error rate run after the current step. */
+void dtm_per_stop(void);
+
+/** @brief Check if a packet error rate run is active.
+ *
+ * @return True if the run is active.
+ */
+bool dtm_per_running(void);
+
+/** @brief Read the results of the last packet error rate run.
+ *
+ * @param[in]  idx Index of the first result.
+ * @param[out] res Result buffer.
+ * @param[in]  max Number of results that fit the buffer.
+ *
+ * @return Number of results read.
+ */
+size_t dtm_per_results_get(uint16_t idx, struct dtm_per_result *res, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_PER_H_ */
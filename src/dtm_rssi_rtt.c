@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <SEGGER_RTT.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+#include "dtm_rssi_rtt.h"
+
+BUILD_ASSERT(CONFIG_DTM_RSSI_SWEEP_RTT_CHANNEL < CONFIG_SEGGER_RTT_MAX_NUM_UP_BUFFERS,
+	     "The RSSI sweep RTT channel exceeds CONFIG_SEGGER_RTT_MAX_NUM_UP_BUFFERS");
+
+#define FRAME_MAX_SIZE (sizeof(struct dtm_rssi_rtt_hdr) + \
+			(3 * DTM_RSSI_SWEEP_STEPS_MAX) + sizeof(uint16_t))
+
+BUILD_ASSERT(FRAME_MAX_SIZE <= CONFIG_DTM_RSSI_SWEEP_RTT_BUFFER_SIZE,
+	     "The RSSI sweep frame does not fit the RTT buffer");
+
+static uint8_t rtt_buf[CONFIG_DTM_RSSI_SWEEP_RTT_BUFFER_SIZE];
+static uint8_t frame[FRAME_MAX_SIZE];
+static bool rtt_configured;
+
+void dtm_rssi_rtt_send(const struct dtm_rssi_sweep *sweep)
+{
+	struct dtm_rssi_rtt_hdr *hdr = (struct dtm_rssi_rtt_hdr *)frame;
+	uint8_t *data = frame + sizeof(*hdr);
+	size_t len;
+
+	if (!rtt_configured) {
+		/* Skip the whole frame when the host falls behind. */
+		SEGGER_RTT_ConfigUpBuffer(CONFIG_DTM_RSSI_SWEEP_RTT_CHANNEL, "DTM RSSI",
+					  rtt_buf, sizeof(rtt_buf),
+					  SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+		rtt_configured = true;
+	}
+
+	hdr->sync[0] = DTM_RSSI_RTT_SYNC0;
+	hdr->sync[1] = DTM_RSSI_RTT_SYNC1;
+	hdr->version = DTM_RSSI_RTT_VERSION;
+	hdr->count = sweep->count;
+	hdr->start_mhz = sys_cpu_to_le16(sweep->start_mhz);
+	hdr->step_mhz = sweep->step_mhz;
+	hdr->samples = sweep->samples;
+	hdr->seq = sys_cpu_to_le32(sweep->seq);
+	hdr->duration_us = sys_cpu_to_le32(sweep->duration_us);
+
+	for (uint8_t i = 0; i < sweep->count; i++) {
+		*data++ = sweep->min[i];
+		*data++ = sweep->avg[i];
+		*data++ = sweep->max[i];
+	}
+
+	len = data - frame;
+	sys_put_le16(crc16_itu_t(0xFFFF, frame, len), data);
+	len += sizeof(uint16_t);
+
+	(void)SEGGER_RTT_Write(CONFIG_DTM_RSSI_SWEEP_RTT_CHANNEL, frame, len);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_RSSI_RTT_H_
+#define DTM_RSSI_RTT_H_
+
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#include "dtm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** First octet of the RSSI sweep frame. */
+#define DTM_RSSI_RTT_SYNC0 0xA5
+
+/** Second octet of the RSSI sweep frame. */
+#define DTM_RSSI_RTT_SYNC1 0x5A
+
+/** Version of the RSSI sweep frame format. */
+#define DTM_RSSI_RTT_VERSION 1
+
+/** @brief Header of the RSSI sweep frame, little-endian.
+ *
+ * The header is followed by the lowest, average and highest RSSI in dBm
+ * of each frequency, three signed octets per frequency, and by the
+ * CRC-16/CCITT-FALSE of the header and the RSSI values (2 octets).
+ */
+struct dtm_rssi_rtt_hdr {
+	/** DTM_RSSI_RTT_SYNC0 and DTM_RSSI_RTT_SYNC1. */
+	uint8_t sync[2];
+
+	/** DTM_RSSI_RTT_VERSION. */
+	uint8_t version;
+
+	/** Number of frequencies. */
+	uint8_t count;
+
+	/** Frequency of the first step in MHz. */
+	uint16_t start_mhz;
+
+	/** Frequency step in MHz. */
+	uint8_t step_mhz;
+
+	/** Number of RSSI samples per frequency. */
+	uint8_t samples;
+
+	/** Number of the sweep. */
+	uint32_t seq;
+
+	/** Duration of the sweep in microseconds. */
+	uint32_t duration_us;
+} __packed;
+
+/** @brief Write an RSSI sweep frame to the RTT up channel.
+ *
+ * The frame is dropped if it does not fit the free space of the channel.
+ * The function can be used as the RSSI sweep callback.
+ *
+ * @param[in] sweep The sweep result.
+ */
+void dtm_rssi_rtt_send(const struct dtm_rssi_sweep *sweep);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_RSSI_RTT_H_ */
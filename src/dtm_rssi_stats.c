@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm_rssi_stats.h"
+#include "dtm_welford.h"
+
+/* Lowest RSSI kept in the histogram, in dBm. */
+#define RSSI_MIN (-(DTM_RSSI_HIST_BINS - 1))
+
+/* Running statistics of a packet class. */
+struct rssi_acc {
+	/* Number of packets, average and spread of the RSSI in dBm. */
+	struct dtm_welford welford;
+
+	/* RSSI extremes in dBm. */
+	int8_t min;
+	int8_t max;
+
+	/* 1 dB histogram, bin n counts the RSSI of -n dBm. */
+	uint32_t hist[DTM_RSSI_HIST_BINS];
+};
+
+/* Updated from the radio interrupt processing, read by the threads. */
+static struct rssi_acc rssi_acc[DTM_RSSI_CLASS_COUNT];
+
+void dtm_rssi_stats_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	memset(rssi_acc, 0, sizeof(rssi_acc));
+	for (size_t i = 0; i < ARRAY_SIZE(rssi_acc); i++) {
+		dtm_welford_reset(&rssi_acc[i].welford);
+		rssi_acc[i].min = INT8_MAX;
+		rssi_acc[i].max = INT8_MIN;
+	}
+
+	irq_unlock(key);
+}
+
+void dtm_rssi_stats_record(enum dtm_rssi_class cls, int8_t rssi)
+{
+	struct rssi_acc *acc;
+
+	if (cls >= DTM_RSSI_CLASS_COUNT) {
+		return;
+	}
+
+	acc = &rssi_acc[cls];
+	rssi = CLAMP(rssi, RSSI_MIN, 0);
+
+	dtm_welford_add(&acc->welford, rssi);
+
+	acc->min = MIN(acc->min, rssi);
+	acc->max = MAX(acc->max, rssi);
+	acc->hist[-rssi]++;
+}
+
+/* Lowest RSSI at or below which at least pct % of the packets were received. */
+static int8_t percentile(const struct rssi_acc *acc, uint32_t pct)
+{
+	uint64_t target = MAX(1, ((uint64_t)acc->welford.count * pct + 99) / 100);
+	uint64_t sum = 0;
+
+	for (int bin = DTM_RSSI_HIST_BINS - 1; bin >= 0; bin--) {
+		sum += acc->hist[bin];
+		if (sum >= target) {
+			return -bin;
+		}
+	}
+
+	return 0;
+}
+
+int dtm_rssi_stats_get(enum dtm_rssi_class cls, struct dtm_rssi_stat *stat)
+{
+	struct rssi_acc tmp;
+	unsigned int key;
+
+	if ((cls >= DTM_RSSI_CLASS_COUNT) || !stat) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	tmp = rssi_acc[cls];
+	irq_unlock(key);
+
+	memset(stat, 0, sizeof(*stat));
+
+	if (tmp.welford.count == 0) {
+		return 0;
+	}
+
+	stat->count = tmp.welford.count;
+	stat->mean = (int16_t)dtm_welford_mean_get(&tmp.welford, 100);
+	stat->std = (uint16_t)dtm_welford_std_get(&tmp.welford, 100);
+	stat->min = tmp.min;
+	stat->max = tmp.max;
+	stat->p10 = percentile(&tmp, 10);
+	stat->p50 = percentile(&tmp, 50);
+	stat->p90 = percentile(&tmp, 90);
+
+	return 0;
+}
+
+int dtm_rssi_stats_hist_get(enum dtm_rssi_class cls, size_t first, uint32_t *hist,
+			    size_t count)
+{
+	unsigned int key;
+
+	if ((cls >= DTM_RSSI_CLASS_COUNT) || (first > DTM_RSSI_HIST_BINS) || (!hist && count)) {
+		return -EINVAL;
+	}
+
+	count = MIN(count, DTM_RSSI_HIST_BINS - first);
+
+	key = irq_lock();
+	memcpy(hist, &rssi_acc[cls].hist[first], count * sizeof(hist[0]));
+	irq_unlock(key);
+
+	return count;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_RSSI_STATS_H_
+#define DTM_RSSI_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of the 1 dB histogram bins. Bin n counts the packets received
+ *  with an RSSI of -n dBm, the last bin also counts the lower RSSI.
+ */
+#define DTM_RSSI_HIST_BINS 128
+
+/** @brief Classes of the received packets. */
+enum dtm_rssi_class {
+	/** Packets received with a valid CRC and payload. */
+	DTM_RSSI_CLASS_GOOD,
+
+	/** Packets received with an invalid CRC. */
+	DTM_RSSI_CLASS_CRC_ERROR,
+
+	/** Number of the classes. */
+	DTM_RSSI_CLASS_COUNT
+};
+
+/** @brief RSSI statistics of a packet class in the receiver test.
+ *
+ * The percentiles are read from the 1 dB histogram, the percentile p is
+ * the lowest RSSI at or below which at least p % of the packets were received.
+ * The structure is also the wire format of the statistics, little-endian.
+ */
+struct dtm_rssi_stat {
+	/** Number of packets. */
+	uint32_t count;
+
+	/** Average RSSI in 0.01 dBm. */
+	int16_t mean;
+
+	/** Standard deviation of the RSSI in 0.01 dB. */
+	uint16_t std;
+
+	/** Lowest RSSI in dBm. */
+	int8_t min;
+
+	/** Highest RSSI in dBm. */
+	int8_t max;
+
+	/** 10th percentile of the RSSI in dBm. */
+	int8_t p10;
+
+	/** Median RSSI in dBm. */
+	int8_t p50;
+
+	/** 90th percentile of the RSSI in dBm. */
+	int8_t p90;
+} __packed;
+
+#if CONFIG_DTM_RSSI_STATS
+/** @brief Clear the statistics, called when a receiver test starts. */
+void dtm_rssi_stats_reset(void);
+
+/** @brief Record a received packet.
+ *
+ * The statistics are updated in constant time.
+ *
+ * @param[in] cls  Packet class.
+ * @param[in] rssi RSSI of the packet in dBm.
+ */
+void dtm_rssi_stats_record(enum dtm_rssi_class cls, int8_t rssi);
+
+/** @brief Get the RSSI statistics of a packet class.
+ *
+ * The statistics of the last receiver test remain available after the test ends,
+ * until the next receiver test starts.
+ *
+ * @param[in]  cls  Packet class.
+ * @param[out] stat The statistics, all fields are 0 if no packet was received.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_rssi_stats_get(enum dtm_rssi_class cls, struct dtm_rssi_stat *stat);
+
+/** @brief Get the RSSI histogram of a packet class.
+ *
+ * @param[in]  cls   Packet class.
+ * @param[in]  first First bin to read.
+ * @param[out] hist  The packet counts, from the bin first.
+ * @param[in]  count Number of bins that fit the buffer.
+ *
+ * @retval Number of bins read.
+ * @return Negative value in case of error.
+ */
+int dtm_rssi_stats_hist_get(enum dtm_rssi_class cls, size_t first, uint32_t *hist,
+			    size_t count);
+#else
+static inline void dtm_rssi_stats_reset(void)
+{
+}
+
+static inline void dtm_rssi_stats_record(enum dtm_rssi_class cls, int8_t rssi)
+{
+	ARG_UNUSED(cls);
+	ARG_UNUSED(rssi);
+}
+#endif /* CONFIG_DTM_RSSI_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_RSSI_STATS_H_ */
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <SEGGER_RTT.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "dtm_rtt_frame.h"
+#include "dtm_vendor.h"
+#include "transport/dtm_cmd_core.h"
+
+LOG_MODULE_REGISTER(dtm_rtt_frame, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
+
+BUILD_ASSERT(CONFIG_DTM_RTT_FRAME_CHANNEL < CONFIG_SEGGER_RTT_MAX_NUM_UP_BUFFERS,
+	     "The framed protocol RTT channel exceeds CONFIG_SEGGER_RTT_MAX_NUM_UP_BUFFERS");
+BUILD_ASSERT(CONFIG_DTM_RTT_FRAME_CHANNEL < CONFIG_SEGGER_RTT_MAX_NUM_DOWN_BUFFERS,
+	     "The framed protocol RTT channel exceeds CONFIG_SEGGER_RTT_MAX_NUM_DOWN_BUFFERS");
+
+/* Frame header and CRC. */
+#define FRAME_OVERHEAD (sizeof(struct dtm_rtt_frame_hdr) + sizeof(uint16_t))
+
+#define FRAME_MAX_SIZE (CONFIG_DTM_RTT_FRAME_PAYLOAD_MAX + FRAME_OVERHEAD)
+
+/* A response frame holds at least one response of any vendor command. */
+BUILD_ASSERT(CONFIG_DTM_RTT_FRAME_PAYLOAD_MAX >=
+	     (sizeof(struct dtm_rtt_frame_rsp) + DTM_VENDOR_RSP_MAX_SIZE),
+	     "The frame payload does not fit a vendor command response");
+
+BUILD_ASSERT(FRAME_MAX_SIZE <= CONFIG_DTM_RTT_FRAME_BUFFER_SIZE,
+	     "The frame does not fit the RTT buffers");
+
+/* A part of the frame payload. */
+struct frame_part {
+	const void *data;
+	size_t len;
+};
+
+static uint8_t rtt_up_buf[CONFIG_DTM_RTT_FRAME_BUFFER_SIZE];
+static uint8_t rtt_down_buf[CONFIG_DTM_RTT_FRAME_BUFFER_SIZE];
+
+/* Complete frames waiting for the RTT up buffer. The frame thread is the
+ * only writer of the RTT channel, so the frames are never interleaved.
+ */
+RING_BUF_DECLARE(tx_ring, CONFIG_DTM_RTT_FRAME_BUFFER_SIZE);
+static struct k_spinlock tx_lock;
+
+static uint8_t rx_buf[FRAME_MAX_SIZE];
+static size_t rx_len;
+
+static uint8_t rsp_buf[CONFIG_DTM_RTT_FRAME_PAYLOAD_MAX];
+
+static K_SEM_DEFINE(start_sem, 0, 1);
+static K_SEM_DEFINE(tx_sem, 0, 1);
+
+static atomic_t records_dropped;
+
+/* Queue a frame, all or nothing. */
+static int frame_put(uint8_t type, uint8_t flags, uint16_t seq,
+		     const struct frame_part *parts, size_t count)
+{
+	struct dtm_rtt_frame_hdr hdr = {
+		.sync = { DTM_RTT_FRAME_SYNC0, DTM_RTT_FRAME_SYNC1 },
+		.type = type,
+		.flags = flags,
+		.seq = sys_cpu_to_le16(seq),
+	};
+	uint8_t crc[sizeof(uint16_t)];
+	k_spinlock_key_t key;
+	size_t len = 0;
+	uint16_t crc16;
+	int err = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		len += parts[i].len;
+	}
+
+	if (len > CONFIG_DTM_RTT_FRAME_PAYLOAD_MAX) {
+		return -EMSGSIZE;
+	}
+
+	hdr.len = sys_cpu_to_le16(len);
+
+	crc16 = crc16_itu_t(0xFFFF, (const uint8_t *)&hdr, sizeof(hdr));
+	for (size_t i = 0; i < count; i++) {
+		crc16 = crc16_itu_t(crc16, parts[i].data, parts[i].len);
+	}
+	sys_put_le16(crc16, crc);
+
+	key = k_spin_lock(&tx_lock);
+
+	if (ring_buf_space_get(&tx_ring) < (len + FRAME_OVERHEAD)) {
+		err = -ENOBUFS;
+	} else {
+		(void)ring_buf_put(&tx_ring, (const uint8_t *)&hdr, sizeof(hdr));
+		for (size_t i = 0; i < count; i++) {
+			(void)ring_buf_put(&tx_ring, parts[i].data, parts[i].len);
+		}
+		(void)ring_buf_put(&tx_ring, crc, sizeof(crc));
+	}
+
+	k_spin_unlock(&tx_lock, key);
+
+	return err;
+}
+
+/* Move the queued frames to the RTT up buffer, as far as they fit.
+ * Returns true if frames are left in the queue.
+ */
+static bool tx_drain(void)
+{
+	uint8_t *data;
+	uint32_t len;
+	unsigned int written;
+
+	while ((len = ring_buf_get_claim(&tx_ring, &data, UINT32_MAX)) > 0) {
+		written = SEGGER_RTT_Write(CONFIG_DTM_RTT_FRAME_CHANNEL, data, len);
+		(void)ring_buf_get_finish(&tx_ring, written);
+
+		if (written < len) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Queue a response frame, waiting for the host to make room. */
+static void rsp_send(uint16_t seq, uint8_t flags, size_t len)
+{
+	const struct frame_part part = { .data = rsp_buf, .len = len };
+
+	while (frame_put(DTM_RTT_FRAME_RSP, flags, seq, &part, 1) == -ENOBUFS) {
+		if (tx_drain()) {
+			k_sleep(K_MSEC(CONFIG_DTM_RTT_FRAME_POLL_PERIOD_MS));
+		}
+	}
+}
+
+static int cmd_exec(uint16_t opcode, const uint8_t *in, size_t in_len,
+		    uint8_t *out, size_t *out_len)
+{
+	if (opcode == DTM_RTT_FRAME_OP_TWOWIRE) {
+		if (in_len != sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+
+		sys_put_le16(dtm_cmd_put(DTM_EXEC_CLIENT_TESTER, sys_get_le16(in)), out);
+		*out_len = sizeof(uint16_t);
+		return 0;
+	}
+
+	return dtm_vendor_cmd_exec(DTM_EXEC_CLIENT_TESTER, opcode, in, in_len, out, out_len);
+}
+
+/* Execute a batch of commands, the responses are sent in the same order. */
+static void cmd_batch(uint16_t seq, const uint8_t *data, size_t len)
+{
+	const struct dtm_rtt_frame_cmd *cmd;
+	struct dtm_rtt_frame_rsp *rsp;
+	size_t rsp_len = 0;
+	size_t out_len;
+	uint16_t in_len;
+	int err;
+
+	while (len >= sizeof(*cmd)) {
+		cmd = (const struct dtm_rtt_frame_cmd *)data;
+		in_len = sys_le16_to_cpu(cmd->len);
+		data += sizeof(*cmd);
+		len -= sizeof(*cmd);
+
+		/* Make room for the largest response. */
+		if ((rsp_len + sizeof(*rsp) + DTM_VENDOR_RSP_MAX_SIZE) > sizeof(rsp_buf)) {
+			rsp_send(seq, DTM_RTT_FRAME_FLAG_MORE, rsp_len);
+			rsp_len = 0;
+		}
+
+		rsp = (struct dtm_rtt_frame_rsp *)&rsp_buf[rsp_len];
+		out_len = 0;
+
+		if (in_len > len) {
+			err = -EINVAL;
+			len = 0;
+		} else {
+			err = cmd_exec(sys_le16_to_cpu(cmd->opcode), data, in_len,
+				       (uint8_t *)(rsp + 1), &out_len);
+			data += in_len;
+			len -= in_len;
+		}
+
+		rsp->opcode = cmd->opcode;
+		rsp->status = sys_cpu_to_le16(err);
+		rsp->len = sys_cpu_to_le16(out_len);
+		rsp_len += sizeof(*rsp) + out_len;
+	}
+
+	rsp_send(seq, 0, rsp_len);
+}
+
+/* Read the command frames from the RTT down buffer and execute them.
+ * Returns true if any data was received.
+ */
+static bool rx_process(void)
+{
+	const struct dtm_rtt_frame_hdr *hdr = (const struct dtm_rtt_frame_hdr *)rx_buf;
+	unsigned int read;
+	size_t frame_len;
+	size_t drop;
+	uint16_t len;
+
+	read = SEGGER_RTT_Read(CONFIG_DTM_RTT_FRAME_CHANNEL, &rx_buf[rx_len],
+			       sizeof(rx_buf) - rx_len);
+	if (read == 0) {
+		return false;
+	}
+
+	rx_len += read;
+
+	while (rx_len > 0) {
+		/* Skip to the next sync, a partial sync is kept. */
+		for (drop = 0; drop < rx_len; drop++) {
+			if ((rx_buf[drop] == DTM_RTT_FRAME_SYNC0) &&
+			    (((drop + 1) == rx_len) || (rx_buf[drop + 1] == DTM_RTT_FRAME_SYNC1))) {
+				break;
+			}
+		}
+
+		if (drop == 0) {
+			if (rx_len < sizeof(*hdr)) {
+				break;
+			}
+
+			len = sys_le16_to_cpu(hdr->len);
+			frame_len = sizeof(*hdr) + len + sizeof(uint16_t);
+
+			if ((hdr->type != DTM_RTT_FRAME_CMD) ||
+			    (len > CONFIG_DTM_RTT_FRAME_PAYLOAD_MAX)) {
+				/* Not a frame start, resynchronize. */
+				drop = 1;
+			} else if (rx_len < frame_len) {
+				break;
+			} else if (crc16_itu_t(0xFFFF, rx_buf, frame_len - sizeof(uint16_t)) !=
+				   sys_get_le16(&rx_buf[frame_len - sizeof(uint16_t)])) {
+				LOG_WRN("Frame %u CRC error", sys_le16_to_cpu(hdr->seq));
+				drop = 1;
+			} else {
+				cmd_batch(sys_le16_to_cpu(hdr->seq), &rx_buf[sizeof(*hdr)], len);
+				drop = frame_len;
+			}
+		}
+
+		rx_len -= drop;
+		memmove(rx_buf, &rx_buf[drop], rx_len);
+	}
+
+	return true;
+}
+
+static void frame_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint32_t poll_ms = CONFIG_DTM_RTT_FRAME_IDLE_POLL_PERIOD_MS;
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (;;) {
+		bool busy = rx_process();
+		atomic_val_t dropped;
+
+		/* Poll fast after a command, back off while the host is idle. */
+		if (busy) {
+			poll_ms = CONFIG_DTM_RTT_FRAME_POLL_PERIOD_MS;
+		} else {
+			poll_ms = MIN(poll_ms * 2, CONFIG_DTM_RTT_FRAME_IDLE_POLL_PERIOD_MS);
+		}
+
+		busy |= tx_drain();
+
+		dropped = atomic_set(&records_dropped, 0);
+		if (dropped) {
+			LOG_WRN("%ld records dropped", (long)dropped);
+		}
+
+		/* RTT has no receive interrupt. Poll while idle, the records
+		 * wake the thread up.
+		 */
+		if (!busy) {
+			(void)k_sem_take(&tx_sem, K_MSEC(poll_ms));
+		}
+	}
+}
+
+K_THREAD_DEFINE(dtm_rtt_frame_thread, CONFIG_DTM_RTT_FRAME_THREAD_STACK_SIZE, frame_thread,
+		NULL, NULL, NULL, CONFIG_DTM_RTT_FRAME_THREAD_PRIORITY, 0, 0);
+
+/* Queue a record of up to two data parts. */
+static int record_put(uint16_t id, const void *data, size_t len,
+		      const void *ext, size_t ext_len)
+{
+	struct dtm_rtt_frame_rec rec = {
+		.id = sys_cpu_to_le16(id),
+		.len = sys_cpu_to_le16(len + ext_len),
+	};
+	const struct frame_part parts[] = {
+		{ .data = &rec, .len = sizeof(rec) },
+		{ .data = data, .len = len },
+		{ .data = ext, .len = ext_len },
+	};
+	int err;
+
+	err = frame_put(DTM_RTT_FRAME_RECORD, 0, 0, parts, ARRAY_SIZE(parts));
+	if (err == -ENOBUFS) {
+		atomic_inc(&records_dropped);
+	} else if (!err) {
+		k_sem_give(&tx_sem);
+	}
+
+	return err;
+}
+
+int dtm_rtt_frame_record_send(uint16_t id, const void *data, size_t len)
+{
+	return record_put(id, data, len, NULL, 0);
+}
+
+static void vendor_evt(uint16_t event, const uint8_t *data, size_t len)
+{
+	(void)dtm_rtt_frame_record_send(event, data, len);
+}
+
+void dtm_rtt_frame_iq_report(struct dtm_iq_data *data)
+{
+	struct dtm_rtt_frame_iq iq = {
+		.channel = data->channel,
+		.rssi = sys_cpu_to_le16(data->rssi),
+		.rssi_ant = data->rssi_ant,
+		.type = data->type,
+		.slot = data->slot,
+		.status = data->status,
+		.sample_cnt = data->sample_cnt,
+	};
+
+	/* The samples are sent as they are, the SoC is little-endian. */
+	(void)record_put(DTM_RTT_FRAME_REC_IQ, &iq, sizeof(iq), data->samples,
+			 data->sample_cnt * sizeof(data->samples[0]));
+}
+
+int dtm_rtt_frame_init(void)
+{
+	int err;
+
+	err = SEGGER_RTT_ConfigUpBuffer(CONFIG_DTM_RTT_FRAME_CHANNEL, "DTM frame",
+					rtt_up_buf, sizeof(rtt_up_buf),
+					SEGGER_RTT_MODE_NO_BLOCK_TRIM);
+	if (err < 0) {
+		return -EIO;
+	}
+
+	err = SEGGER_RTT_ConfigDownBuffer(CONFIG_DTM_RTT_FRAME_CHANNEL, "DTM frame",
+					  rtt_down_buf, sizeof(rtt_down_buf),
+					  SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	if (err < 0) {
+		return -EIO;
+	}
+
+	dtm_vendor_evt_cb_set(vendor_evt);
+	k_sem_give(&start_sem);
+
+	LOG_INF("DTM framed protocol on RTT channel %d", CONFIG_DTM_RTT_FRAME_CHANNEL);
+
+	return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_RTT_FRAME_H_
+#define DTM_RTT_FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#include "dtm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** First sync octet of a frame. */
+#define DTM_RTT_FRAME_SYNC0 0xA5
+
+/** Second sync octet of a frame. */
+#define DTM_RTT_FRAME_SYNC1 0xC3
+
+/** More frames with the same sequence number follow. */
+#define DTM_RTT_FRAME_FLAG_MORE BIT(0)
+
+/** Opcode of a DTM Two Wire command carried in a command frame.
+ *  Parameters: Two Wire command (2 octets).
+ *  Response: Two Wire event (2 octets).
+ *  The other opcodes are the vendor commands, see enum dtm_vendor_opcode.
+ */
+#define DTM_RTT_FRAME_OP_TWOWIRE 0x0000
+
+/** @brief Frame types. */
+enum dtm_rtt_frame_type {
+	/** Batch of commands, from the host. */
+	DTM_RTT_FRAME_CMD = 0x01,
+
+	/** Batch of responses, with the sequence number of the command frame. */
+	DTM_RTT_FRAME_RSP = 0x02,
+
+	/** Asynchronous record, to the host. */
+	DTM_RTT_FRAME_RECORD = 0x03,
+};
+
+/** @brief Record identifiers.
+ *
+ * The vendor events are reported with their event code as the identifier,
+ * see enum dtm_vendor_event.
+ */
+enum dtm_rtt_frame_record {
+	/** IQ samples of a received packet.
+	 *  Data: struct dtm_rtt_frame_iq followed by the I and Q of each sample
+	 *  (2 signed octets each).
+	 */
+	DTM_RTT_FRAME_REC_IQ = 0x0100,
+};
+
+/** @brief Frame header.
+ *
+ * The header is followed by the payload and the CRC-16/CCITT-FALSE of the
+ * header and the payload. All multi-octet fields are little-endian.
+ */
+struct dtm_rtt_frame_hdr {
+	/** Sync octets, DTM_RTT_FRAME_SYNC0 and DTM_RTT_FRAME_SYNC1. */
+	uint8_t sync[2];
+
+	/** Frame type, see enum dtm_rtt_frame_type. */
+	uint8_t type;
+
+	/** Frame flags. */
+	uint8_t flags;
+
+	/** Sequence number, chosen by the host for the command frames. */
+	uint16_t seq;
+
+	/** Length of the payload. */
+	uint16_t len;
+} __packed;
+
+/** @brief Command entry of a command frame, followed by the parameters. */
+struct dtm_rtt_frame_cmd {
+	/** Command opcode. */
+	uint16_t opcode;
+
+	/** Length of the parameters. */
+	uint16_t len;
+} __packed;
+
+/** @brief Response entry of a response frame, followed by the response data. */
+struct dtm_rtt_frame_rsp {
+	/** Command opcode. */
+	uint16_t opcode;
+
+	/** 0 or a negative error code. */
+	int16_t status;
+
+	/** Length of the response data. */
+	uint16_t len;
+} __packed;
+
+/** @brief Record entry of a record frame, followed by the record data. */
+struct dtm_rtt_frame_rec {
+	/** Record identifier. */
+	uint16_t id;
+
+	/** Length of the record data. */
+	uint16_t len;
+} __packed;
+
+/** @brief IQ record header. */
+struct dtm_rtt_frame_iq {
+	/** DTM channel. */
+	uint8_t channel;
+
+	/** RSSI of the packet, in 0.1 dBm. */
+	int16_t rssi;
+
+	/** Antenna used to measure the RSSI. */
+	uint8_t rssi_ant;
+
+	/** CTE type, see enum dtm_cte_type. */
+	uint8_t type;
+
+	/** CTE slot duration, see enum dtm_cte_slot_duration. */
+	uint8_t slot;
+
+	/** Packet status, see enum dtm_packet_status. */
+	uint8_t status;
+
+	/** Number of samples. */
+	uint8_t sample_cnt;
+} __packed;
+
+/** @brief Start the framed protocol on its RTT channel.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_rtt_frame_init(void);
+
+/** @brief Send a record frame.
+ *
+ * The frame is dropped when the RTT up buffer has no room for it.
+ *
+ * @note The function can be called from the interrupt context.
+ *
+ * @param[in] id   Record identifier.
+ * @param[in] data Record data.
+ * @param[in] len  Length of the record data.
+ *
+ * @retval 0 in case of success.
+ * @retval -EMSGSIZE if the record exceeds the frame payload.
+ * @retval -ENOBUFS if the frame was dropped.
+ */
+int dtm_rtt_frame_record_send(uint16_t id, const void *data, size_t len);
+
+/** @brief Report received IQ samples as a record, see dtm_iq_report_callback_t.
+ *
+ * @param[in] data IQ sampling data.
+ */
+void dtm_rtt_frame_iq_report(struct dtm_iq_data *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_RTT_FRAME_H_ */
@@ -1,159 +1,1651 @@
 /*
  * DTM Shell Commands for easy testing via RTT
- * Provides text-based commands that translate to DTM 2-byte protocol
+ * Provides text-based commands over the DTM interface, with an optional
+ * CSV or JSON lines output for host scripts
  */
 
 #include <zephyr/kernel.h>
 #include <zephyr/shell/shell.h>
+#include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
+#include "transport/dtm_cmd_core.h"
 #include "transport/dtm_transport.h"
+#include "dtm.h"
+#include "dtm_config.h"
+#include "dtm_exec.h"
+#include "dtm_vendor.h"
 
-/* External function from dtm_cmd_core */
-extern uint16_t dtm_cmd_put(uint16_t cmd);
+#if CONFIG_DTM_TEST_PLAN
+#include "dtm_test_plan.h"
+#endif /* CONFIG_DTM_TEST_PLAN */
 
-static int cmd_dtm_reset(const struct shell *sh, size_t argc, char **argv)
+#if CONFIG_DTM_ISR_STATS
+#include "dtm_isr_stats.h"
+#endif /* CONFIG_DTM_ISR_STATS */
+
+#if CONFIG_DTM_PER
+#include "dtm_per.h"
+#endif /* CONFIG_DTM_PER */
+
+#if CONFIG_DTM_RSSI_STATS
+#include "dtm_rssi_stats.h"
+#endif /* CONFIG_DTM_RSSI_STATS */
+
+#if CONFIG_DTM_CTE_CFO
+#include "dtm_cte_cfo.h"
+#endif /* CONFIG_DTM_CTE_CFO */
+
+#if CONFIG_DTM_AOA
+#include "dtm_aoa.h"
+#endif /* CONFIG_DTM_AOA */
+
+#if CONFIG_DTM_RSSI_SWEEP_RTT
+#include "dtm_rssi_rtt.h"
+#endif /* CONFIG_DTM_RSSI_SWEEP_RTT */
+
+/* Highest DTM channel. */
+#define CHANNEL_MAX 39
+
+/* Longest line of a formatted record. */
+#define OUT_LINE_MAX 160
+
+/* Longest antenna switching pattern set from the shell. */
+#define ANTENNA_PATTERN_MAX 16
+
+/* Output format of the command results. */
+enum out_format {
+	OUT_TEXT,
+	OUT_CSV,
+	OUT_JSON,
+};
+
+/* A named integer field of a result record. */
+struct out_field {
+	const char *name;
+	int32_t value;
+};
+
+#define OUT_FIELD(_name, _value) { .name = (_name), .value = (_value) }
+
+static const char *const out_formats[] = {
+	[OUT_TEXT] = "text",
+	[OUT_CSV] = "csv",
+	[OUT_JSON] = "json",
+};
+
+static enum out_format out_format;
+
+static int name_lookup(const char *const *names, size_t count, const char *name)
 {
-	uint16_t response = dtm_cmd_put(0x0000);
-	shell_print(sh, "DTM Reset - Response: 0x%04X", response);
-	return 0;
+	for (size_t i = 0; i < count; i++) {
+		if (names[i] && !strcmp(names[i], name)) {
+			return i;
+		}
+	}
+
+	return -EINVAL;
 }
 
-static int cmd_dtm_rx_test(const struct shell *sh, size_t argc, char **argv)
+static void out_append(char *buf, size_t *len, const char *fmt, ...)
+{
+	va_list args;
+	int ret;
+
+	if (*len >= OUT_LINE_MAX) {
+		return;
+	}
+
+	va_start(args, fmt);
+	ret = vsnprintk(buf + *len, OUT_LINE_MAX - *len, fmt, args);
+	va_end(args);
+
+	if (ret > 0) {
+		*len = MIN(*len + ret, OUT_LINE_MAX);
+	}
+}
+
+/* Print the CSV header of a record type, "#<type>,<name>,...".
+ * The other formats name each value in the record itself.
+ */
+static void out_header(const struct shell *sh, const char *type,
+		       const struct out_field *fields, size_t count)
+{
+	char buf[OUT_LINE_MAX];
+	size_t len = 0;
+
+	if (out_format != OUT_CSV) {
+		return;
+	}
+
+	out_append(buf, &len, "#%s", type);
+	for (size_t i = 0; i < count; i++) {
+		out_append(buf, &len, ",%s", fields[i].name);
+	}
+
+	shell_print(sh, "%s", buf);
+}
+
+/* Print a record as "<type>: <name>=<value> ...", as "<type>,<value>,..."
+ * or as a JSON object on a single line.
+ */
+static void out_record(const struct shell *sh, const char *type,
+		       const struct out_field *fields, size_t count)
+{
+	char buf[OUT_LINE_MAX];
+	size_t len = 0;
+
+	switch (out_format) {
+	case OUT_CSV:
+		out_append(buf, &len, "%s", type);
+		for (size_t i = 0; i < count; i++) {
+			out_append(buf, &len, ",%d", fields[i].value);
+		}
+		break;
+
+	case OUT_JSON:
+		out_append(buf, &len, "{\"type\":\"%s\"", type);
+		for (size_t i = 0; i < count; i++) {
+			out_append(buf, &len, ",\"%s\":%d", fields[i].name, fields[i].value);
+		}
+		out_append(buf, &len, "}");
+		break;
+
+	default:
+		out_append(buf, &len, "%s:", type);
+		for (size_t i = 0; i < count; i++) {
+			out_append(buf, &len, " %s=%d", fields[i].name, fields[i].value);
+		}
+		break;
+	}
+
+	shell_print(sh, "%s", buf);
+}
+
+/* Print a single result, with its CSV header. */
+static void out_result(const struct shell *sh, const char *type,
+		       const struct out_field *fields, size_t count)
+{
+	out_header(sh, type, fields, count);
+	out_record(sh, type, fields, count);
+}
+
+/* Print the status of a command without further results. */
+static int out_status(const struct shell *sh, const char *type, int err)
 {
-	if (argc != 2) {
-		shell_print(sh, "Usage: rx_test <channel>");
-		shell_print(sh, "  channel: 0-39 (2404-2482 MHz)");
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+	};
+
+	out_result(sh, type, fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+static int channel_parse(const struct shell *sh, const char *arg)
+{
+	char *end;
+	unsigned long channel = strtoul(arg, &end, 0);
+
+	if ((*end != '\0') || (channel > CHANNEL_MAX)) {
+		shell_print(sh, "Error: Channel must be 0-%d", CHANNEL_MAX);
 		return -EINVAL;
 	}
-	
-	uint8_t channel = atoi(argv[1]);
-	if (channel > 39) {
-		shell_print(sh, "Error: Channel must be 0-39");
+
+	return channel;
+}
+
+/* Parse an integer argument in the range min to max. */
+static int int_parse(const struct shell *sh, const char *arg, const char *name,
+		     long min, long max, long *val)
+{
+	char *end;
+	long res = strtol(arg, &end, 0);
+
+	if ((end == arg) || (*end != '\0') || (res < min) || (res > max)) {
+		shell_print(sh, "Error: %s must be %ld-%ld", name, min, max);
 		return -EINVAL;
 	}
-	
-	/* RX Test command: bits 15-14 = 0x1 (RECEIVER_TEST)
-	 * bits 7-2 = channel, other bits = 0
-	 */
-	uint16_t cmd = 0x4000 | (channel << 2);  /* 0x4000 = LE_RECEIVER_TEST */
-	uint16_t response = dtm_cmd_put(cmd);
-	shell_print(sh, "RX Test on channel %d (%.0f MHz) - Response: 0x%04X", 
-	            channel, 2404.0 + channel * 2, response);
+
+	*val = res;
 	return 0;
 }
 
-static int cmd_dtm_tx_carrier(const struct shell *sh, size_t argc, char **argv)
+/* Arguments of a shell command executed by the DTM executor. */
+struct shell_exec_args {
+	shell_cmd_handler handler;
+	const struct shell *sh;
+	size_t argc;
+	char **argv;
+};
+
+static int shell_exec_handler(void *ctx)
 {
-	if (argc != 2) {
-		shell_print(sh, "Usage: tx_carrier <channel>");
-		shell_print(sh, "  channel: 0-39 (2404-2482 MHz)");
-		return -EINVAL;
+	struct shell_exec_args *args = ctx;
+
+	return args->handler(args->sh, args->argc, args->argv);
+}
+
+/* Define <handler>_exec, running a shell command driving the DTM engine
+ * in the DTM executor.
+ */
+#define SHELL_EXEC_HANDLER(_handler)							\
+	static int _handler##_exec(const struct shell *sh, size_t argc, char **argv)	\
+	{										\
+		struct shell_exec_args args = {						\
+			.handler = _handler,						\
+			.sh = sh,							\
+			.argc = argc,							\
+			.argv = argv,							\
+		};									\
+											\
+		return dtm_exec_call(DTM_EXEC_CLIENT_SHELL, shell_exec_handler, &args);	\
+	}
+
+static int cmd_dtm_format(const struct shell *sh, size_t argc, char **argv)
+{
+	int fmt;
+
+	if (argc == 1) {
+		shell_print(sh, "Output format: %s", out_formats[out_format]);
+		return 0;
 	}
-	
-	uint8_t channel = atoi(argv[1]);
-	if (channel > 39) {
-		shell_print(sh, "Error: Channel must be 0-39");
+
+	fmt = name_lookup(out_formats, ARRAY_SIZE(out_formats), argv[1]);
+	if (fmt < 0) {
+		shell_print(sh, "Usage: format [text|csv|json]");
 		return -EINVAL;
 	}
-	
-	/* TX Test command: bits 15-14 = 0x2 (TRANSMITTER_TEST)
-	 * For carrier test, length = 0 (vendor specific for continuous carrier)
-	 * bits 13-8 = length (0), bits 7-2 = channel, bits 1-0 = packet type (0)
-	 */
-	uint16_t cmd = 0x8000 | (channel << 2);  /* 0x8000 = LE_TRANSMITTER_TEST */
-	uint16_t response = dtm_cmd_put(cmd);
-	shell_print(sh, "TX Carrier on channel %d (%.0f MHz) - Response: 0x%04X", 
-	            channel, 2404.0 + channel * 2, response);
+
+	out_format = fmt;
 	return 0;
 }
 
-static int cmd_dtm_tx_test(const struct shell *sh, size_t argc, char **argv)
+static int cmd_dtm_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	/* Through the transport, to also clear its upper length bits.
+	 * Bit 0 of the status event is set on success.
+	 */
+	uint16_t response = dtm_cmd_put(DTM_EXEC_CLIENT_SHELL, 0x0000);
+
+	return out_status(sh, "reset", (response & BIT(0)) ? 0 : -EIO);
+}
+
+static const char *const phy_names[] = {
+	[DTM_PHY_1M] = "1m",
+	[DTM_PHY_2M] = "2m",
+	[DTM_PHY_CODED_S8] = "s8",
+	[DTM_PHY_CODED_S2] = "s2",
+};
+
+static int cmd_dtm_phy(const struct shell *sh, size_t argc, char **argv)
+{
+	int phy = name_lookup(phy_names, ARRAY_SIZE(phy_names), argv[1]);
+	int err;
+
+	if (phy < 0) {
+		shell_print(sh, "Usage: phy <1m|2m|s8|s2>");
+		return -EINVAL;
+	}
+
+	dtm_setup_prepare();
+	err = dtm_setup_set_phy(phy);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("phy", phy),
+	};
+
+	out_result(sh, "phy", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_phy)
+
+static const char *const modulation_names[] = {
+	[DTM_MODULATION_STANDARD] = "standard",
+	[DTM_MODULATION_STABLE] = "stable",
+};
+
+static int cmd_dtm_modulation(const struct shell *sh, size_t argc, char **argv)
+{
+	int mod = name_lookup(modulation_names, ARRAY_SIZE(modulation_names), argv[1]);
+	int err;
+
+	if (mod < 0) {
+		shell_print(sh, "Usage: modulation <standard|stable>");
+		return -EINVAL;
+	}
+
+	dtm_setup_prepare();
+	err = dtm_setup_set_modulation(mod);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("modulation", mod),
+	};
+
+	out_result(sh, "modulation", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_modulation)
+
+static const char *const cte_names[] = {
+	[DTM_CTE_TYPE_NONE] = "none",
+	[DTM_CTE_TYPE_AOA] = "aoa",
+	[DTM_CTE_TYPE_AOD_1US] = "aod1",
+	[DTM_CTE_TYPE_AOD_2US] = "aod2",
+};
+
+static int cmd_dtm_cte(const struct shell *sh, size_t argc, char **argv)
 {
-	if (argc != 2 && argc != 3) {
-		shell_print(sh, "Usage: tx_test <channel> [length]");
-		shell_print(sh, "  channel: 0-39 (2404-2482 MHz)");
-		shell_print(sh, "  length: packet length 0-37 (default 37)");
+	int type = name_lookup(cte_names, ARRAY_SIZE(cte_names), argv[1]);
+	long time = 0;
+	long slot = 2;
+	int err;
+
+	if ((argc > 2) && int_parse(sh, argv[2], "CTE time", 0, UINT8_MAX, &time)) {
 		return -EINVAL;
 	}
-	
-	uint8_t channel = atoi(argv[1]);
-	uint8_t length = (argc == 3) ? atoi(argv[2]) : 37;
-	
-	if (channel > 39) {
-		shell_print(sh, "Error: Channel must be 0-39");
+
+	if ((argc > 3) && int_parse(sh, argv[3], "Slot", 1, 2, &slot)) {
 		return -EINVAL;
 	}
-	if (length > 37) {
-		shell_print(sh, "Error: Length must be 0-37");
+
+	if ((type < 0) || ((type != DTM_CTE_TYPE_NONE) && (argc < 3)) ||
+	    ((slot != 1) && (slot != 2))) {
+		shell_print(sh, "Usage: cte <none|aoa|aod1|aod2> <time_8us> [slot_us 1|2]");
 		return -EINVAL;
 	}
-	
-	/* TX Test command: bits 15-14 = 0x2 (TRANSMITTER_TEST)
-	 * bits 13-8 = length, bits 7-2 = channel, bits 1-0 = packet type (PRBS9)
-	 */
-	uint16_t cmd = 0x8000 | (length << 8) | (channel << 2) | 0x00;  /* 0x00 = PRBS9 */
-	uint16_t response = dtm_cmd_put(cmd);
-	shell_print(sh, "TX Test on channel %d, length %d - Response: 0x%04X", 
-	            channel, length, response);
-	return 0;
+
+	dtm_setup_prepare();
+	err = dtm_setup_set_cte_mode(type, time);
+
+	/* The AoD types select the slot duration, AoA takes it separately. */
+	if (!err && (type == DTM_CTE_TYPE_AOA)) {
+		err = dtm_setup_set_cte_slot((slot == 1) ? DTM_CTE_SLOT_DURATION_1US :
+							   DTM_CTE_SLOT_DURATION_2US);
+	}
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("cte", type),
+		OUT_FIELD("time_8us", time),
+		OUT_FIELD("slot_us", slot),
+	};
+
+	out_result(sh, "cte", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_cte)
+
+static int cmd_dtm_antenna(const struct shell *sh, size_t argc, char **argv)
+{
+	/* The DTM keeps a reference to the pattern. */
+	static uint8_t pattern[ANTENNA_PATTERN_MAX];
+	size_t len = argc - 2;
+	long count;
+	long val;
+	int err;
+
+	if (len > ARRAY_SIZE(pattern)) {
+		shell_print(sh, "Error: At most %d pattern entries", ANTENNA_PATTERN_MAX);
+		return -EINVAL;
+	}
+
+	if (int_parse(sh, argv[1], "Antenna count", 0, UINT8_MAX, &count)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		if (int_parse(sh, argv[i + 2], "Antenna", 0, UINT8_MAX, &val)) {
+			return -EINVAL;
+		}
+
+		pattern[i] = val;
+	}
+
+	dtm_setup_prepare();
+	err = dtm_setup_set_antenna_params(count, pattern, len);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("antennas", count),
+		OUT_FIELD("pattern_len", len),
+	};
+
+	out_result(sh, "antenna", fields, ARRAY_SIZE(fields));
+	return err;
 }
 
+SHELL_EXEC_HANDLER(cmd_dtm_antenna)
+
 static int cmd_dtm_tx_power(const struct shell *sh, size_t argc, char **argv)
 {
-	if (argc != 2) {
-		shell_print(sh, "Usage: tx_power <power_dbm>");
-		shell_print(sh, "  power_dbm: TX power in dBm (e.g., 0, 4, 8)");
+	enum dtm_tx_power_request req = DTM_TX_POWER_REQUEST_VAL;
+	long val = 0;
+	int channel = 0;
+	struct dtm_tx_power power;
+
+	if (!strcmp(argv[1], "min")) {
+		req = DTM_TX_POWER_REQUEST_MIN;
+	} else if (!strcmp(argv[1], "max")) {
+		req = DTM_TX_POWER_REQUEST_MAX;
+	} else if (int_parse(sh, argv[1], "Power", INT8_MIN, INT8_MAX, &val)) {
 		return -EINVAL;
 	}
-	
-	int8_t power = atoi(argv[1]);
-	
-	/* Test Setup command with Set TX Power parameter
-	 * bits 15-14 = 0x0 (TEST_SETUP), bits 13-8 = 0x02 (TX_POWER)
-	 * bits 7-2 = power level
+
+	/* The resolved power depends on the channel with a front-end module. */
+	if (argc > 2) {
+		channel = channel_parse(sh, argv[2]);
+		if (channel < 0) {
+			return channel;
+		}
+	}
+
+	dtm_setup_prepare();
+	power = dtm_setup_set_transmit_power(req, val, channel);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", 0),
+		OUT_FIELD("power_dbm", power.power),
+		OUT_FIELD("min", power.min),
+		OUT_FIELD("max", power.max),
+	};
+
+	out_result(sh, "power", fields, ARRAY_SIZE(fields));
+	return 0;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_tx_power)
+
+static int cmd_dtm_rx_test(const struct shell *sh, size_t argc, char **argv)
+{
+	int channel = channel_parse(sh, argv[1]);
+	int err;
+
+	if (channel < 0) {
+		return channel;
+	}
+
+	err = dtm_test_receive(channel);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("channel", channel),
+		OUT_FIELD("mhz", 2402 + channel * 2),
+	};
+
+	out_result(sh, "rx", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_rx_test)
+
+static int cmd_dtm_tx_carrier(const struct shell *sh, size_t argc, char **argv)
+{
+	int channel = channel_parse(sh, argv[1]);
+	int err;
+
+	if (channel < 0) {
+		return channel;
+	}
+
+	/* Zero length vendor specific packet is the carrier test,
+	 * on the uncoded PHYs only.
 	 */
-	uint16_t cmd = 0x0200 | ((power & 0x3F) << 2);
-	uint16_t response = dtm_cmd_put(cmd);
-	shell_print(sh, "Set TX Power to %d dBm - Response: 0x%04X", power, response);
+	err = dtm_test_transmit(channel, 0, DTM_PACKET_FF_OR_VENDOR);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("channel", channel),
+		OUT_FIELD("mhz", 2402 + channel * 2),
+	};
+
+	out_result(sh, "carrier", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_tx_carrier)
+
+static const char *const packet_names[] = {
+	[DTM_PACKET_PRBS9] = "prbs9",
+	[DTM_PACKET_0F] = "0f",
+	[DTM_PACKET_55] = "55",
+	[DTM_PACKET_PRBS15] = "prbs15",
+	[DTM_PACKET_FF] = "ff",
+	[DTM_PACKET_00] = "00",
+	[DTM_PACKET_F0] = "f0",
+	[DTM_PACKET_AA] = "aa",
+};
+
+static int cmd_dtm_tx_test(const struct shell *sh, size_t argc, char **argv)
+{
+	int channel = channel_parse(sh, argv[1]);
+	long length = 37;
+	int pkt = DTM_PACKET_PRBS9;
+	int err;
+
+	if (channel < 0) {
+		return channel;
+	}
+
+	if ((argc > 2) && int_parse(sh, argv[2], "Length", 0, UINT8_MAX, &length)) {
+		return -EINVAL;
+	}
+
+	if (argc > 3) {
+		pkt = name_lookup(packet_names, ARRAY_SIZE(packet_names), argv[3]);
+	}
+
+	if (pkt < 0) {
+		shell_print(sh, "Usage: tx_test <channel> [length 0-255] "
+				"[prbs9|0f|55|prbs15|ff|00|f0|aa]");
+		return -EINVAL;
+	}
+
+	err = dtm_test_transmit(channel, length, pkt);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("channel", channel),
+		OUT_FIELD("length", length),
+		OUT_FIELD("packet", pkt),
+	};
+
+	out_result(sh, "tx", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_tx_test)
+
+#if CONFIG_DTM_TX_BURST
+static void burst_done(uint32_t packets)
+{
+	DTM_DIAG("TX burst done: %u packets\n", packets);
+}
+
+static int cmd_dtm_burst(const struct shell *sh, size_t argc, char **argv)
+{
+	int channel = channel_parse(sh, argv[1]);
+	long count;
+	long length = 37;
+	int pkt = DTM_PACKET_PRBS9;
+	int err;
+
+	if (channel < 0) {
+		return channel;
+	}
+
+	if (int_parse(sh, argv[2], "Count", 1, INT32_MAX, &count) ||
+	    ((argc > 3) && int_parse(sh, argv[3], "Length", 0, UINT8_MAX, &length))) {
+		return -EINVAL;
+	}
+
+	if (argc > 4) {
+		pkt = name_lookup(packet_names, ARRAY_SIZE(packet_names), argv[4]);
+	}
+
+	if (pkt < 0) {
+		shell_print(sh, "Usage: burst <channel> <count> [length 0-255] "
+				"[prbs9|0f|55|prbs15|ff|00|f0|aa]");
+		return -EINVAL;
+	}
+
+	err = dtm_test_transmit_burst(channel, length, pkt, count, burst_done);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("channel", channel),
+		OUT_FIELD("length", length),
+		OUT_FIELD("packet", pkt),
+		OUT_FIELD("count", count),
+	};
+
+	out_result(sh, "burst", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_burst)
+#endif /* CONFIG_DTM_TX_BURST */
+
+#if CONFIG_DTM_RX_SCAN
+static int cmd_dtm_scan(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_rx_scan_config cfg = {
+		.hop_per_packet = (argc > 2) && !strcmp(argv[2], "packet"),
+	};
+	long dwell_ms;
+	int err;
+
+	if (int_parse(sh, argv[1], "Dwell time", 1, UINT16_MAX, &dwell_ms)) {
+		return -EINVAL;
+	}
+
+	cfg.dwell_ms = dwell_ms;
+
+	if ((argc > 2) && !cfg.hop_per_packet) {
+		shell_print(sh, "Usage: scan <dwell_ms> [packet]");
+		return -EINVAL;
+	}
+
+	/* All 40 channels. */
+	memset(cfg.channels, 0xFF, sizeof(cfg.channels));
+
+	err = dtm_test_receive_scan(&cfg);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("dwell_ms", cfg.dwell_ms),
+		OUT_FIELD("hop_per_packet", cfg.hop_per_packet),
+	};
+
+	out_result(sh, "scan", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_scan)
+#endif /* CONFIG_DTM_RX_SCAN */
+
+static int cmd_dtm_txcal(const struct shell *sh, size_t argc, char **argv)
+{
+	int8_t offsets[DTM_TX_POWER_CAL_MAX];
+	struct out_field fields[] = {
+		OUT_FIELD("level", 0),
+		OUT_FIELD("offset_qdb", 0),
+	};
+	long val;
+	int count;
+
+	if (argc > 1) {
+		if ((argc - 1) > ARRAY_SIZE(offsets)) {
+			shell_print(sh, "Error: At most %d offsets", DTM_TX_POWER_CAL_MAX);
+			return -EINVAL;
+		}
+
+		for (size_t i = 1; i < argc; i++) {
+			if (int_parse(sh, argv[i], "Offset", INT8_MIN, INT8_MAX, &val)) {
+				return -EINVAL;
+			}
+
+			offsets[i - 1] = val;
+		}
+
+		return out_status(sh, "txcal", dtm_config_tx_power_cal_set(offsets, argc - 1));
+	}
+
+	count = dtm_tx_power_cal_get(offsets, ARRAY_SIZE(offsets));
+	if (count < 0) {
+		return out_status(sh, "txcal", count);
+	}
+
+	out_header(sh, "txcal", fields, ARRAY_SIZE(fields));
+
+	for (int i = 0; i < count; i++) {
+		fields[0].value = i;
+		fields[1].value = offsets[i];
+		out_record(sh, "txcal", fields, ARRAY_SIZE(fields));
+	}
+
 	return 0;
 }
 
-static int cmd_dtm_end_test(const struct shell *sh, size_t argc, char **argv)
+SHELL_EXEC_HANDLER(cmd_dtm_txcal)
+
+static int cmd_dtm_txcomp(const struct shell *sh, size_t argc, char **argv)
 {
-	uint16_t response = dtm_cmd_put(0xC000);
-	shell_print(sh, "End Test - Response: 0x%04X", response);
-	
-	/* Extract packet count from response if it's a packet reporting event */
-	if (response & 0x8000) {
-		uint16_t packet_count = response & 0x7FFF;
-		shell_print(sh, "  Packets received: %d", packet_count);
+	int8_t comp[DTM_CHANNEL_COUNT];
+	struct out_field fields[] = {
+		OUT_FIELD("channel", 0),
+		OUT_FIELD("offset_qdb", 0),
+	};
+	int channel;
+	long val;
+	int count;
+
+	count = dtm_tx_power_comp_get(comp, ARRAY_SIZE(comp));
+	if (count < 0) {
+		return out_status(sh, "txcomp", count);
+	}
+
+	if (argc == 2) {
+		shell_print(sh, "Error: Offset required");
+		return -EINVAL;
+	}
+
+	if (argc > 2) {
+		channel = channel_parse(sh, argv[1]);
+		if (channel < 0) {
+			return channel;
+		}
+
+		if (int_parse(sh, argv[2], "Offset", INT8_MIN, INT8_MAX, &val)) {
+			return -EINVAL;
+		}
+
+		comp[channel] = val;
+
+		return out_status(sh, "txcomp",
+				  dtm_config_tx_power_comp_set(comp, ARRAY_SIZE(comp)));
+	}
+
+	out_header(sh, "txcomp", fields, ARRAY_SIZE(fields));
+
+	for (int i = 0; i < count; i++) {
+		fields[0].value = i;
+		fields[1].value = comp[i];
+		out_record(sh, "txcomp", fields, ARRAY_SIZE(fields));
 	}
-	
+
 	return 0;
 }
 
+SHELL_EXEC_HANDLER(cmd_dtm_txcomp)
+
+static int cmd_dtm_end_test(const struct shell *sh, size_t argc, char **argv)
+{
+	uint16_t packets = 0;
+	int err;
+
+	err = dtm_test_end(&packets);
+
+	const struct out_field fields[] = {
+		OUT_FIELD("status", err),
+		OUT_FIELD("packets", packets),
+	};
+
+	out_result(sh, "end", fields, ARRAY_SIZE(fields));
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_dtm_end_test)
+
 static int cmd_dtm_raw(const struct shell *sh, size_t argc, char **argv)
 {
-	if (argc != 2) {
+	char *end = NULL;
+	unsigned long cmd = (argc == 2) ? strtoul(argv[1], &end, 16) : 0;
+	uint16_t response;
+
+	if ((argc != 2) || (end == argv[1]) || (*end != '\0') || (cmd > UINT16_MAX)) {
 		shell_print(sh, "Usage: dtm_raw <hex_value>");
 		shell_print(sh, "  hex_value: 4-digit hex (e.g., 8014 for RX ch 20)");
 		return -EINVAL;
 	}
-	
-	uint16_t cmd = strtol(argv[1], NULL, 16);
-	uint16_t response = dtm_cmd_put(cmd);
-	shell_print(sh, "Sent 0x%04X - Response: 0x%04X", cmd, response);
+
+	response = dtm_cmd_put(DTM_EXEC_CLIENT_SHELL, cmd);
+	shell_print(sh, "Sent 0x%04lX - Response: 0x%04X", cmd, response);
 	return 0;
 }
 
+static int cmd_dtm_quiet(const struct shell *sh, size_t argc, char **argv)
+{
+	bool quiet;
+	int err;
+
+	if (argc == 1) {
+		shell_print(sh, "Quiet mode: %s", dtm_config_quiet_get() ? "on" : "off");
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "on")) {
+		quiet = true;
+	} else if (!strcmp(argv[1], "off")) {
+		quiet = false;
+	} else {
+		shell_print(sh, "Usage: quiet [on|off]");
+		return -EINVAL;
+	}
+
+	/* The shell itself stays available, only the diagnostics and the
+	 * log output are suppressed.
+	 */
+	err = dtm_config_quiet_set(quiet, true);
+	if (err) {
+		shell_print(sh, "Quiet mode %s, not stored: %d", argv[1], err);
+	}
+
+	return 0;
+}
+
+static const char *const autostart_modes[] = {
+	[DTM_AUTOSTART_NONE] = "none",
+	[DTM_AUTOSTART_RX] = "rx",
+	[DTM_AUTOSTART_TX] = "tx",
+	[DTM_AUTOSTART_CARRIER] = "carrier",
+};
+
+static int cmd_dtm_autostart(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_autostart autostart;
+	int mode;
+	int phy = DTM_PHY_1M;
+	int channel;
+	int err;
+
+	dtm_config_autostart_get(&autostart);
+
+	if (argc == 1) {
+		shell_print(sh, "Auto-start: %s, channel %d, PHY %s",
+			    autostart_modes[autostart.mode], autostart.channel,
+			    phy_names[autostart.phy]);
+		return 0;
+	}
+
+	mode = name_lookup(autostart_modes, ARRAY_SIZE(autostart_modes), argv[1]);
+	if (argc > 3) {
+		phy = name_lookup(phy_names, ARRAY_SIZE(phy_names), argv[3]);
+	}
+
+	if ((mode < 0) || (phy < 0) ||
+	    ((mode != DTM_AUTOSTART_NONE) && (argc < 3))) {
+		shell_print(sh, "Usage: autostart <none|rx|tx|carrier> <channel> [1m|2m|s8|s2]");
+		return -EINVAL;
+	}
+
+	if (argc > 2) {
+		channel = channel_parse(sh, argv[2]);
+		if (channel < 0) {
+			return channel;
+		}
+
+		autostart.channel = channel;
+	}
+
+	autostart.mode = mode;
+	autostart.phy = phy;
+
+	err = dtm_config_autostart_set(&autostart);
+	if (err) {
+		shell_print(sh, "Error: Auto-start not stored: %d", err);
+		return err;
+	}
+
+	shell_print(sh, "Auto-start stored, applied after reset");
+	return 0;
+}
+
+static int cmd_dtm_vendor(const struct shell *sh, size_t argc, char **argv)
+{
+	uint8_t in[DTM_VENDOR_RSP_MAX_SIZE];
+	uint8_t out[DTM_VENDOR_RSP_MAX_SIZE];
+	size_t out_len;
+	size_t in_len = 0;
+	char *end;
+	unsigned long opcode = strtoul(argv[1], &end, 16);
+	int err;
+
+	if ((*end != '\0') || (opcode > UINT16_MAX)) {
+		shell_print(sh, "Error: Invalid hex opcode");
+		return -EINVAL;
+	}
+
+	if (argc > 2) {
+		in_len = hex2bin(argv[2], strlen(argv[2]), in, sizeof(in));
+		if (in_len == 0) {
+			shell_print(sh, "Error: Invalid hex payload");
+			return -EINVAL;
+		}
+	}
+
+	err = dtm_vendor_cmd_exec(DTM_EXEC_CLIENT_SHELL, opcode, in, in_len, out, &out_len);
+	shell_print(sh, "Vendor 0x%03lX - Status: %d", opcode, err);
+	if (!err && out_len) {
+		shell_hexdump(sh, out, out_len);
+	}
+
+	return err;
+}
+
+#if CONFIG_DTM_TEST_PLAN
+static const char *const plan_modes[] = {
+	[DTM_PLAN_MODE_RX] = "rx",
+	[DTM_PLAN_MODE_TX] = "tx",
+	[DTM_PLAN_MODE_CARRIER] = "carrier",
+};
+
+static int cmd_plan_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	dtm_test_plan_clear();
+	shell_print(sh, "Test plan cleared, use 'dtm plan save' to store it");
+	return 0;
+}
+
+static int cmd_plan_add(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_plan_step step = {
+		.phy = DTM_PHY_1M,
+		.length = 37,
+		.packet = DTM_PACKET_PRBS9,
+	};
+	int mode = name_lookup(plan_modes, ARRAY_SIZE(plan_modes), argv[1]);
+	int phy = DTM_PHY_1M;
+	int channel;
+	long duration;
+	long power = 0;
+	long length = step.length;
+	int err;
+
+	if (argc > 4) {
+		phy = name_lookup(phy_names, ARRAY_SIZE(phy_names), argv[4]);
+	}
+
+	if ((mode < 0) || (phy < 0)) {
+		shell_print(sh, "Usage: add <rx|tx|carrier> <channel> <duration_s> "
+				"[1m|2m|s8|s2] [power_dbm] [length]");
+		return -EINVAL;
+	}
+
+	channel = channel_parse(sh, argv[2]);
+	if (channel < 0) {
+		return channel;
+	}
+
+	if (int_parse(sh, argv[3], "Duration", 0, UINT16_MAX, &duration) ||
+	    ((argc > 5) && int_parse(sh, argv[5], "Power", INT8_MIN, INT8_MAX, &power)) ||
+	    ((argc > 6) && int_parse(sh, argv[6], "Length", 0, UINT8_MAX, &length))) {
+		return -EINVAL;
+	}
+
+	step.mode = mode;
+	step.channel = channel;
+	step.duration = duration;
+	step.phy = phy;
+	step.power = power;
+	step.length = length;
+
+	err = dtm_test_plan_step_add(&step);
+	if (err) {
+		shell_print(sh, "Error: Step not added: %d", err);
+		return err;
+	}
+
+	shell_print(sh, "Step %d added", dtm_test_plan_count_get(NULL) - 1);
+	return 0;
+}
+
+static int cmd_plan_repeat(const struct shell *sh, size_t argc, char **argv)
+{
+	long repeat;
+
+	if (int_parse(sh, argv[1], "Repeat", 0, UINT8_MAX, &repeat)) {
+		return -EINVAL;
+	}
+
+	dtm_test_plan_repeat_set(repeat);
+	return 0;
+}
+
+static int cmd_plan_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_plan_step step;
+	uint8_t repeat;
+	uint8_t count = dtm_test_plan_count_get(&repeat);
+
+	shell_print(sh, "Steps: %d, repeat: %d%s, %s", count, repeat,
+		    repeat ? "" : " (forever)",
+		    dtm_test_plan_running() ? "running" : "idle");
+
+	for (uint8_t i = 0; i < count; i++) {
+		if (dtm_test_plan_step_get(i, &step)) {
+			break;
+		}
+
+		shell_print(sh, "  %2d: %-7s ch %2d phy %s power %3d dBm len %3d, %d s",
+			    i, plan_modes[step.mode], step.channel, phy_names[step.phy],
+			    step.power, step.length, step.duration);
+	}
+
+	return 0;
+}
+
+static int cmd_plan_save(const struct shell *sh, size_t argc, char **argv)
+{
+	int err = dtm_test_plan_save();
+
+	shell_print(sh, "Test plan save - Status: %d", err);
+	return err;
+}
+
+static int cmd_plan_run(const struct shell *sh, size_t argc, char **argv)
+{
+	int err = dtm_test_plan_run();
+
+	shell_print(sh, "Test plan run - Status: %d", err);
+	return err;
+}
+
+static int cmd_plan_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	dtm_test_plan_stop();
+	return 0;
+}
+
+static int cmd_plan_log(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_plan_result res[CONFIG_DTM_TEST_PLAN_LOG_BATCH];
+	struct out_field fields[] = {
+		OUT_FIELD("seq", 0),
+		OUT_FIELD("uptime_s", 0),
+		OUT_FIELD("run", 0),
+		OUT_FIELD("step", 0),
+		OUT_FIELD("mode", 0),
+		OUT_FIELD("channel", 0),
+		OUT_FIELD("power", 0),
+		OUT_FIELD("status", 0),
+		OUT_FIELD("packets", 0),
+		OUT_FIELD("crc_errors", 0),
+	};
+	int count;
+
+	out_header(sh, "plan_log", fields, ARRAY_SIZE(fields));
+
+	for (uint16_t batch = 0; ; batch++) {
+		count = dtm_test_plan_log_read(batch, res, ARRAY_SIZE(res));
+		if (count == -ENOENT) {
+			break;
+		} else if (count < 0) {
+			return out_status(sh, "plan_log", count);
+		}
+
+		for (int i = 0; i < count; i++) {
+			fields[0].value = res[i].seq;
+			fields[1].value = res[i].uptime;
+			fields[2].value = res[i].run;
+			fields[3].value = res[i].step;
+			fields[4].value = res[i].mode;
+			fields[5].value = res[i].channel;
+			fields[6].value = res[i].power;
+			fields[7].value = res[i].status;
+			fields[8].value = res[i].packets;
+			fields[9].value = res[i].crc_errors;
+			out_record(sh, "plan_log", fields, ARRAY_SIZE(fields));
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_plan_log_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	int err = dtm_test_plan_log_clear();
+
+	shell_print(sh, "Result log clear - Status: %d", err);
+	return err;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(dtm_plan_cmds,
+	SHELL_CMD(clear, NULL, "Clear the test plan in RAM", cmd_plan_clear),
+	SHELL_CMD_ARG(add, NULL,
+		      "Add a step <rx|tx|carrier> <channel> <duration_s> "
+		      "[1m|2m|s8|s2] [power_dbm] [length]",
+		      cmd_plan_add, 4, 3),
+	SHELL_CMD_ARG(repeat, NULL, "Number of repetitions, 0 forever", cmd_plan_repeat, 2, 0),
+	SHELL_CMD(show, NULL, "Show the test plan", cmd_plan_show),
+	SHELL_CMD(save, NULL, "Store the test plan in flash", cmd_plan_save),
+	SHELL_CMD(run, NULL, "Run the test plan", cmd_plan_run),
+	SHELL_CMD(stop, NULL, "Stop the test plan", cmd_plan_stop),
+	SHELL_CMD(log, NULL, "Print the result log", cmd_plan_log),
+	SHELL_CMD(log_clear, NULL, "Erase the result log", cmd_plan_log_clear),
+	SHELL_SUBCMD_SET_END
+);
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+#if CONFIG_DTM_PER
+static void per_done(uint16_t count)
+{
+	DTM_DIAG("PER run done: %u results\n", count);
+}
+
+static int cmd_per_run(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_per_config cfg;
+	long packets = 1000;
+	long phys = BIT(DTM_PHY_1M);
+	int err;
+
+	if (((argc > 1) && int_parse(sh, argv[1], "Packets", 1, UINT16_MAX, &packets)) ||
+	    ((argc > 2) && int_parse(sh, argv[2], "PHY mask", 1, UINT8_MAX, &phys))) {
+		return -EINVAL;
+	}
+
+	cfg.packets = packets;
+	cfg.phys = phys;
+
+	/* All 40 channels. */
+	memset(cfg.channels, 0xFF, sizeof(cfg.channels));
+
+	err = dtm_per_run(&cfg, per_done);
+	shell_print(sh, "PER run of %u packets per step, PHY mask 0x%x - Status: %d",
+		    cfg.packets, cfg.phys, err);
+	return err;
+}
+
+static int cmd_per_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	dtm_per_stop();
+	return 0;
+}
+
+static int cmd_per_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_per_result res[8];
+	struct out_field fields[] = {
+		OUT_FIELD("phy", 0),
+		OUT_FIELD("channel", 0),
+		OUT_FIELD("expected", 0),
+		OUT_FIELD("received", 0),
+		OUT_FIELD("crc_errors", 0),
+		OUT_FIELD("per_permille", 0),
+	};
+	uint16_t idx = 0;
+	size_t count;
+
+	if (dtm_per_running()) {
+		return out_status(sh, "per", -EBUSY);
+	}
+
+	out_header(sh, "per", fields, ARRAY_SIZE(fields));
+
+	while ((count = dtm_per_results_get(idx, res, ARRAY_SIZE(res))) > 0) {
+		for (size_t i = 0; i < count; i++) {
+			fields[0].value = res[i].phy;
+			fields[1].value = res[i].channel;
+			fields[2].value = res[i].expected;
+			fields[3].value = res[i].received;
+			fields[4].value = res[i].crc_errors;
+			fields[5].value = ((res[i].expected - res[i].received) * 1000U) /
+					  res[i].expected;
+			out_record(sh, "per", fields, ARRAY_SIZE(fields));
+		}
+
+		idx += count;
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(dtm_per_cmds,
+	SHELL_CMD_ARG(run, NULL,
+		      "Measure all channels against the peer DUT [packets] [phy_mask]",
+		      cmd_per_run, 1, 2),
+	SHELL_CMD(stop, NULL, "Stop the PER run", cmd_per_stop),
+	SHELL_CMD(show, NULL, "Print the PER table", cmd_per_show),
+	SHELL_SUBCMD_SET_END
+);
+#endif /* CONFIG_DTM_PER */
+
+#if CONFIG_DTM_RSSI_SWEEP
+static void sweep_done(const struct dtm_rssi_sweep *sweep)
+{
+#if CONFIG_DTM_RSSI_SWEEP_RTT
+	dtm_rssi_rtt_send(sweep);
+#endif /* CONFIG_DTM_RSSI_SWEEP_RTT */
+
+	DTM_DIAG("RSSI sweep %u done in %u us\n", sweep->seq, sweep->duration_us);
+}
+
+static int cmd_sweep_run(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_rssi_sweep_config cfg = {
+		.repeat = (argc > 3) && !strcmp(argv[3], "repeat"),
+	};
+	long step_mhz = 2;
+	long samples = 8;
+	int err;
+
+	if (((argc > 1) && int_parse(sh, argv[1], "Step", 1, 2, &step_mhz)) ||
+	    ((argc > 2) && int_parse(sh, argv[2], "Samples", 1, UINT8_MAX, &samples))) {
+		return -EINVAL;
+	}
+
+	if ((argc > 3) && !cfg.repeat) {
+		shell_print(sh, "Usage: run [step_mhz 1|2] [samples] [repeat]");
+		return -EINVAL;
+	}
+
+	cfg.step_mhz = step_mhz;
+	cfg.samples = samples;
+
+	err = dtm_rssi_sweep_start(&cfg, sweep_done);
+	shell_print(sh, "RSSI sweep, step %u MHz, %u samples%s - Status: %d",
+		    cfg.step_mhz, cfg.samples, cfg.repeat ? ", repeated" : "", err);
+	return err;
+}
+
+SHELL_EXEC_HANDLER(cmd_sweep_run)
+
+static int cmd_sweep_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	dtm_rssi_sweep_stop();
+	return 0;
+}
+
+SHELL_EXEC_HANDLER(cmd_sweep_stop)
+
+static int cmd_sweep_show(const struct shell *sh, size_t argc, char **argv)
+{
+	static struct dtm_rssi_sweep sweep;
+	struct out_field fields[] = {
+		OUT_FIELD("mhz", 0),
+		OUT_FIELD("rssi_min", 0),
+		OUT_FIELD("rssi_avg", 0),
+		OUT_FIELD("rssi_max", 0),
+	};
+	int err;
+
+	err = dtm_rssi_sweep_get(&sweep);
+	if (err) {
+		return out_status(sh, "sweep", err);
+	}
+
+	out_header(sh, "sweep", fields, ARRAY_SIZE(fields));
+
+	for (uint8_t i = 0; i < sweep.count; i++) {
+		fields[0].value = sweep.start_mhz + i * sweep.step_mhz;
+		fields[1].value = sweep.min[i];
+		fields[2].value = sweep.avg[i];
+		fields[3].value = sweep.max[i];
+		out_record(sh, "sweep", fields, ARRAY_SIZE(fields));
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(dtm_sweep_cmds,
+	SHELL_CMD_ARG(run, NULL, "Sweep the band [step_mhz 1|2] [samples] [repeat]",
+		      cmd_sweep_run_exec, 1, 3),
+	SHELL_CMD(stop, NULL, "Stop the repeated sweep", cmd_sweep_stop_exec),
+	SHELL_CMD(show, NULL, "Print the last sweep", cmd_sweep_show),
+	SHELL_SUBCMD_SET_END
+);
+#endif /* CONFIG_DTM_RSSI_SWEEP */
+
+#if CONFIG_DTM_ISR_STATS
+static int cmd_stats_isr(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_isr_stat stat;
+	uint32_t cycles_per_us = SystemCoreClock / USEC_PER_SEC;
+
+	if ((argc > 1) && !strcmp(argv[1], "reset")) {
+		dtm_isr_stats_reset();
+		return 0;
+	}
+
+	shell_print(sh, "%-22s %8s %8s %8s %8s  (cycles, %u per us)",
+		    "handler", "count", "min", "avg", "max", cycles_per_us);
+
+	for (int id = 0; id < DTM_ISR_COUNT; id++) {
+		if (dtm_isr_stats_get(id, &stat)) {
+			continue;
+		}
+
+		shell_print(sh, "%-22s %8u %8u %8u %8u", dtm_isr_stats_name(id),
+			    stat.count, stat.min, stat.avg, stat.max);
+
+		if (stat.count == 0) {
+			continue;
+		}
+
+		for (int bin = 0; bin < DTM_ISR_STATS_HIST_BINS; bin++) {
+			if (stat.hist[bin]) {
+				shell_print(sh, "  < %7u: %u",
+					    DTM_ISR_STATS_HIST_BASE << (bin + 1),
+					    stat.hist[bin]);
+			}
+		}
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_DTM_ISR_STATS */
+
+#if CONFIG_DTM_EXEC
+static int cmd_stats_exec(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_exec_stat stat;
+
+	if ((argc > 1) && !strcmp(argv[1], "reset")) {
+		dtm_exec_stats_reset();
+		return 0;
+	}
+
+	shell_print(sh, "%-8s %8s %9s %8s %8s %8s %8s  (us)",
+		    "client", "count", "contended", "wait_avg", "wait_max", "run_avg", "run_max");
+
+	for (int client = 0; client < DTM_EXEC_CLIENT_COUNT; client++) {
+		if (dtm_exec_stats_get(client, &stat)) {
+			continue;
+		}
+
+		shell_print(sh, "%-8s %8u %9u %8u %8u %8u %8u", dtm_exec_client_name(client),
+			    stat.count, stat.contended, stat.wait_avg, stat.wait_max,
+			    stat.run_avg, stat.run_max);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_DTM_EXEC */
+
+static int cmd_stats_rx(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_rx_stats stats;
+	struct dtm_rx_timing timing;
+
+	dtm_rx_stats_get(&stats);
+
+	const struct out_field rx_fields[] = {
+		OUT_FIELD("packets", stats.packets),
+		OUT_FIELD("crc_errors", stats.crc_errors),
+	};
+
+	out_result(sh, "rx_stats", rx_fields, ARRAY_SIZE(rx_fields));
+
+	if (dtm_rx_timing_get(&timing)) {
+		return 0;
+	}
+
+	const struct out_field timing_fields[] = {
+		OUT_FIELD("intervals", timing.intervals),
+		OUT_FIELD("nominal_ns", timing.nominal_ns),
+		OUT_FIELD("missed", timing.missed),
+		OUT_FIELD("jitter_avg_ns", timing.jitter_avg_ns),
+		OUT_FIELD("jitter_std_ns", timing.jitter_std_ns),
+		OUT_FIELD("jitter_min_ns", timing.jitter_min_ns),
+		OUT_FIELD("jitter_max_ns", timing.jitter_max_ns),
+		OUT_FIELD("drift_ppm", timing.drift_ppm),
+		OUT_FIELD("airtime_max_ns", timing.airtime_max_ns),
+	};
+
+	out_result(sh, "rx_timing", timing_fields, ARRAY_SIZE(timing_fields));
+
+#if CONFIG_DTM_RX_TIMING
+	struct out_field bin_fields[] = {
+		OUT_FIELD("from_ns", 0),
+		OUT_FIELD("count", 0),
+	};
+
+	out_header(sh, "rx_hist", bin_fields, ARRAY_SIZE(bin_fields));
+
+	for (int bin = 0; bin < DTM_RX_TIMING_HIST_BINS; bin++) {
+		if (timing.hist[bin]) {
+			bin_fields[0].value = (bin - (DTM_RX_TIMING_HIST_BINS / 2)) *
+					      CONFIG_DTM_RX_TIMING_HIST_BIN_NS;
+			bin_fields[1].value = timing.hist[bin];
+			out_record(sh, "rx_hist", bin_fields, ARRAY_SIZE(bin_fields));
+		}
+	}
+#endif /* CONFIG_DTM_RX_TIMING */
+
+	return 0;
+}
+
+static int cmd_stats_tx(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_tx_stats stats;
+	int err;
+
+	err = dtm_tx_stats_get(&stats);
+	if (err) {
+		return out_status(sh, "tx_stats", err);
+	}
+
+	const struct out_field fields[] = {
+		OUT_FIELD("packets", stats.packets),
+		OUT_FIELD("interval_ns", stats.interval_ns),
+		OUT_FIELD("nominal_us", stats.nominal_us),
+		OUT_FIELD("airtime_ns", stats.airtime_ns),
+	};
+
+	out_result(sh, "tx_stats", fields, ARRAY_SIZE(fields));
+	return 0;
+}
+
+#if CONFIG_DTM_RX_SCAN
+static int cmd_stats_scan(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_rx_scan_stat stats[DTM_CHANNEL_COUNT];
+	struct out_field fields[] = {
+		OUT_FIELD("channel", 0),
+		OUT_FIELD("mhz", 0),
+		OUT_FIELD("packets", 0),
+		OUT_FIELD("crc_errors", 0),
+		OUT_FIELD("rssi_avg", 0),
+		OUT_FIELD("rssi_max", 0),
+	};
+	int err;
+
+	err = dtm_rx_scan_stats_get(stats, ARRAY_SIZE(stats));
+	if (err) {
+		return out_status(sh, "scan_stats", err);
+	}
+
+	out_header(sh, "scan_stats", fields, ARRAY_SIZE(fields));
+
+	for (int ch = 0; ch < DTM_CHANNEL_COUNT; ch++) {
+		fields[0].value = ch;
+		fields[1].value = 2402 + ch * 2;
+		fields[2].value = stats[ch].packets;
+		fields[3].value = stats[ch].crc_errors;
+		fields[4].value = stats[ch].rssi_avg;
+		fields[5].value = stats[ch].rssi_max;
+		out_record(sh, "scan_stats", fields, ARRAY_SIZE(fields));
+	}
+
+	return 0;
+}
+#endif /* CONFIG_DTM_RX_SCAN */
+
+#if CONFIG_DTM_RSSI_STATS
+static int cmd_stats_rssi(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_rssi_stat stat;
+	uint32_t hist[32];
+	struct out_field fields[] = {
+		OUT_FIELD("class", 0),
+		OUT_FIELD("count", 0),
+		OUT_FIELD("mean_cdbm", 0),
+		OUT_FIELD("std_cdb", 0),
+		OUT_FIELD("min", 0),
+		OUT_FIELD("max", 0),
+		OUT_FIELD("p10", 0),
+		OUT_FIELD("p50", 0),
+		OUT_FIELD("p90", 0),
+	};
+	struct out_field bin_fields[] = {
+		OUT_FIELD("class", 0),
+		OUT_FIELD("rssi", 0),
+		OUT_FIELD("count", 0),
+	};
+	int count;
+
+	out_header(sh, "rssi_stats", fields, ARRAY_SIZE(fields));
+
+	for (int cls = 0; cls < DTM_RSSI_CLASS_COUNT; cls++) {
+		if (dtm_rssi_stats_get(cls, &stat)) {
+			continue;
+		}
+
+		fields[0].value = cls;
+		fields[1].value = stat.count;
+		fields[2].value = stat.mean;
+		fields[3].value = stat.std;
+		fields[4].value = stat.min;
+		fields[5].value = stat.max;
+		fields[6].value = stat.p10;
+		fields[7].value = stat.p50;
+		fields[8].value = stat.p90;
+		out_record(sh, "rssi_stats", fields, ARRAY_SIZE(fields));
+	}
+
+	if ((argc < 2) || strcmp(argv[1], "hist")) {
+		return 0;
+	}
+
+	out_header(sh, "rssi_hist", bin_fields, ARRAY_SIZE(bin_fields));
+
+	/* The histogram is read in chunks, the stack of the shell is small. */
+	for (int cls = 0; cls < DTM_RSSI_CLASS_COUNT; cls++) {
+		for (int first = 0; first < DTM_RSSI_HIST_BINS; first += count) {
+			count = dtm_rssi_stats_hist_get(cls, first, hist, ARRAY_SIZE(hist));
+			if (count <= 0) {
+				break;
+			}
+
+			for (int i = 0; i < count; i++) {
+				if (hist[i]) {
+					bin_fields[0].value = cls;
+					bin_fields[1].value = -(first + i);
+					bin_fields[2].value = hist[i];
+					out_record(sh, "rssi_hist", bin_fields,
+						   ARRAY_SIZE(bin_fields));
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_DTM_RSSI_STATS */
+
+#if CONFIG_DTM_CTE_CFO
+static int cmd_stats_cfo(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_cte_cfo_stats stats;
+	int err;
+
+	err = dtm_cte_cfo_stats_get(&stats);
+	if (err) {
+		return out_status(sh, "cfo_stats", err);
+	}
+
+	const struct out_field fields[] = {
+		OUT_FIELD("packets", stats.packets),
+		OUT_FIELD("offset_avg_hz", stats.offset_avg_hz),
+		OUT_FIELD("offset_std_hz", stats.offset_std_hz),
+		OUT_FIELD("offset_min_hz", stats.offset_min_hz),
+		OUT_FIELD("offset_max_hz", stats.offset_max_hz),
+		OUT_FIELD("offset_first_hz", stats.offset_first_hz),
+		OUT_FIELD("offset_last_hz", stats.offset_last_hz),
+		OUT_FIELD("drift_avg_hz", stats.drift_avg_hz),
+		OUT_FIELD("drift_min_hz", stats.drift_min_hz),
+		OUT_FIELD("drift_max_hz", stats.drift_max_hz),
+	};
+
+	out_result(sh, "cfo_stats", fields, ARRAY_SIZE(fields));
+	return 0;
+}
+#endif /* CONFIG_DTM_CTE_CFO */
+
+#if CONFIG_DTM_AOA
+static int cmd_stats_aoa(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dtm_aoa_stats stats;
+	int err;
+
+	err = dtm_aoa_stats_get(&stats);
+	if (err) {
+		return out_status(sh, "aoa_stats", err);
+	}
+
+	const struct out_field fields[] = {
+		OUT_FIELD("packets", stats.packets),
+		OUT_FIELD("angle_avg", stats.angle_avg),
+		OUT_FIELD("angle_std", stats.angle_std),
+		OUT_FIELD("angle_min", stats.angle_min),
+		OUT_FIELD("angle_max", stats.angle_max),
+		OUT_FIELD("quality_avg", stats.quality_avg),
+		OUT_FIELD("angle_last", stats.angle_last),
+		OUT_FIELD("quality_last", stats.quality_last),
+	};
+
+	out_result(sh, "aoa_stats", fields, ARRAY_SIZE(fields));
+	return 0;
+}
+#endif /* CONFIG_DTM_AOA */
+
+SHELL_STATIC_SUBCMD_SET_CREATE(dtm_stats_cmds,
+	SHELL_CMD(rx, NULL, "Receiver packet counts and timing", cmd_stats_rx),
+	SHELL_CMD(tx, NULL, "Last transmitter test packet count and interval", cmd_stats_tx),
+#if CONFIG_DTM_RX_SCAN
+	SHELL_CMD(scan, NULL, "Receiver scan statistics per channel", cmd_stats_scan),
+#endif /* CONFIG_DTM_RX_SCAN */
+#if CONFIG_DTM_RSSI_STATS
+	SHELL_CMD_ARG(rssi, NULL, "Receiver RSSI statistics per packet class [hist]",
+		      cmd_stats_rssi, 1, 1),
+#endif /* CONFIG_DTM_RSSI_STATS */
+#if CONFIG_DTM_CTE_CFO
+	SHELL_CMD(cfo, NULL, "Carrier frequency offset from the CTE", cmd_stats_cfo),
+#endif /* CONFIG_DTM_CTE_CFO */
+#if CONFIG_DTM_AOA
+	SHELL_CMD(aoa, NULL, "Angle of arrival from the CTE", cmd_stats_aoa),
+#endif /* CONFIG_DTM_AOA */
+#if CONFIG_DTM_ISR_STATS
+	SHELL_CMD_ARG(isr, NULL, "Interrupt handler execution times [reset]",
+		      cmd_stats_isr, 1, 1),
+#endif /* CONFIG_DTM_ISR_STATS */
+#if CONFIG_DTM_EXEC
+	SHELL_CMD_ARG(exec, NULL, "Command latency per DTM executor client [reset]",
+		      cmd_stats_exec, 1, 1),
+#endif /* CONFIG_DTM_EXEC */
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(dtm_cmds,
+	SHELL_CMD_ARG(format, NULL, "Output format [text|csv|json]", cmd_dtm_format, 1, 1),
 	SHELL_CMD(reset, NULL, "Reset DTM", cmd_dtm_reset),
-	SHELL_CMD(rx_test, NULL, "Start RX test", cmd_dtm_rx_test),
-	SHELL_CMD(tx_carrier, NULL, "Start TX carrier (continuous)", cmd_dtm_tx_carrier),
-	SHELL_CMD(tx_test, NULL, "Start TX test (modulated)", cmd_dtm_tx_test),
-	SHELL_CMD(tx_power, NULL, "Set TX power", cmd_dtm_tx_power),
-	SHELL_CMD(end, NULL, "End test", cmd_dtm_end_test),
+	SHELL_CMD_ARG(phy, NULL, "Set the PHY <1m|2m|s8|s2>", cmd_dtm_phy_exec, 2, 0),
+	SHELL_CMD_ARG(modulation, NULL, "Set the modulation index <standard|stable>",
+		      cmd_dtm_modulation_exec, 2, 0),
+	SHELL_CMD_ARG(cte, NULL,
+		      "Set the Constant Tone Extension <none|aoa|aod1|aod2> <time_8us> "
+		      "[slot_us 1|2]",
+		      cmd_dtm_cte_exec, 2, 2),
+	SHELL_CMD_ARG(antenna, NULL, "Set the antenna switching <count> <pattern...>",
+		      cmd_dtm_antenna_exec, 3, ANTENNA_PATTERN_MAX - 1),
+	SHELL_CMD_ARG(rx_test, NULL, "Start RX test <channel>", cmd_dtm_rx_test_exec, 2, 0),
+	SHELL_CMD_ARG(tx_carrier, NULL, "Start TX carrier (continuous) <channel>",
+		      cmd_dtm_tx_carrier_exec, 2, 0),
+	SHELL_CMD_ARG(tx_test, NULL,
+		      "Start TX test <channel> [length 0-255] [prbs9|0f|55|prbs15|ff|00|f0|aa]",
+		      cmd_dtm_tx_test_exec, 2, 2),
+#if CONFIG_DTM_TX_BURST
+	SHELL_CMD_ARG(burst, NULL,
+		      "Send a TX burst <channel> <count> [length 0-255] "
+		      "[prbs9|0f|55|prbs15|ff|00|f0|aa]",
+		      cmd_dtm_burst_exec, 3, 2),
+#endif /* CONFIG_DTM_TX_BURST */
+#if CONFIG_DTM_RX_SCAN
+	SHELL_CMD_ARG(scan, NULL, "Scan all channels in RX <dwell_ms> [packet]",
+		      cmd_dtm_scan_exec, 2, 1),
+#endif /* CONFIG_DTM_RX_SCAN */
+	SHELL_CMD_ARG(tx_power, NULL, "Set TX power <min|max|power_dbm> [channel]",
+		      cmd_dtm_tx_power_exec, 2, 1),
+	SHELL_CMD_ARG(txcal, NULL,
+		      "TX power level calibration [offset_qdb...], from the lowest level",
+		      cmd_dtm_txcal_exec, 1, DTM_TX_POWER_CAL_MAX),
+	SHELL_CMD_ARG(txcomp, NULL,
+		      "TX power flatness compensation [<channel> <offset_qdb>]",
+		      cmd_dtm_txcomp_exec, 1, 2),
+	SHELL_CMD(end, NULL, "End test", cmd_dtm_end_test_exec),
 	SHELL_CMD(raw, NULL, "Send raw DTM command", cmd_dtm_raw),
+	SHELL_CMD_ARG(quiet, NULL, "Quiet mode [on|off]", cmd_dtm_quiet, 1, 1),
+	SHELL_CMD_ARG(autostart, NULL,
+		      "Test started at boot <none|rx|tx|carrier> <channel> [1m|2m|s8|s2]",
+		      cmd_dtm_autostart, 1, 3),
+	SHELL_CMD_ARG(vendor, NULL, "Vendor command <opcode_hex> [payload_hex]",
+		      cmd_dtm_vendor, 2, 1),
+#if CONFIG_DTM_TEST_PLAN
+	SHELL_CMD(plan, &dtm_plan_cmds, "Autonomous test plan", NULL),
+#endif /* CONFIG_DTM_TEST_PLAN */
+#if CONFIG_DTM_PER
+	SHELL_CMD(per, &dtm_per_cmds, "Packet error rate against a peer DUT", NULL),
+#endif /* CONFIG_DTM_PER */
+#if CONFIG_DTM_RSSI_SWEEP
+	SHELL_CMD(sweep, &dtm_sweep_cmds, "RSSI spectrum sweep", NULL),
+#endif /* CONFIG_DTM_RSSI_SWEEP */
+	SHELL_CMD(stats, &dtm_stats_cmds, "Statistics", NULL),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm_telemetry.h"
+
+#if CONFIG_DTM_RADIO_ZLI
+#include <nrfx.h>
+#endif /* CONFIG_DTM_RADIO_ZLI */
+
+#if CONFIG_DTM_ISR_STATS
+#include "dtm_isr_stats.h"
+
+BUILD_ASSERT(DTM_ISR_COUNT <= DTM_TELEMETRY_ISR_MAX,
+	     "Not enough interrupt handler entries in the telemetry block");
+#endif /* CONFIG_DTM_ISR_STATS */
+
+/* The block is read over SWD, its layout does not depend on the build. */
+BUILD_ASSERT(sizeof(struct dtm_telemetry) == 32 + 8 * DTM_TELEMETRY_ISR_MAX,
+	     "The telemetry block layout changed");
+
+/* Not initialized at boot, the block is filled in dtm_telemetry_init(). */
+struct dtm_telemetry dtm_telemetry __used Z_GENERIC_SECTION(.dtm_telemetry);
+
+/* The writers run at different interrupt priorities. The zero-latency radio
+ * interrupt is not masked by irq_lock().
+ */
+static inline unsigned int write_begin(void)
+{
+#if CONFIG_DTM_RADIO_ZLI
+	unsigned int key = __get_PRIMASK();
+
+	__disable_irq();
+#else
+	unsigned int key = irq_lock();
+#endif /* CONFIG_DTM_RADIO_ZLI */
+
+	dtm_telemetry.seq++;
+	compiler_barrier();
+
+	return key;
+}
+
+static inline void write_end(unsigned int key)
+{
+	compiler_barrier();
+	dtm_telemetry.seq++;
+
+#if CONFIG_DTM_RADIO_ZLI
+	__set_PRIMASK(key);
+#else
+	irq_unlock(key);
+#endif /* CONFIG_DTM_RADIO_ZLI */
+}
+
+void dtm_telemetry_init(void)
+{
+	unsigned int key = write_begin();
+	uint32_t seq = dtm_telemetry.seq;
+
+	memset(&dtm_telemetry, 0, sizeof(dtm_telemetry));
+	dtm_telemetry.magic = DTM_TELEMETRY_MAGIC;
+	dtm_telemetry.version = DTM_TELEMETRY_VERSION;
+	dtm_telemetry.size = sizeof(dtm_telemetry);
+	dtm_telemetry.seq = seq;
+
+	write_end(key);
+}
+
+void dtm_telemetry_state_set(enum dtm_telemetry_state state, uint8_t channel)
+{
+	unsigned int key = write_begin();
+
+	dtm_telemetry.state = state;
+
+	if (state > DTM_TELEMETRY_STATE_IDLE) {
+		dtm_telemetry.channel = channel;
+		dtm_telemetry.tests++;
+		dtm_telemetry.rx_packets = 0;
+		dtm_telemetry.rx_crc_errors = 0;
+		dtm_telemetry.tx_packets = 0;
+	}
+
+	write_end(key);
+}
+
+void dtm_telemetry_phy_set(uint8_t phy)
+{
+	unsigned int key = write_begin();
+
+	dtm_telemetry.phy = phy;
+
+	write_end(key);
+}
+
+void dtm_telemetry_rx(bool ok, bool crc_ok, int8_t rssi)
+{
+	unsigned int key = write_begin();
+
+	dtm_telemetry.rssi_last = rssi;
+	dtm_telemetry.rx_packets += ok ? 1 : 0;
+	dtm_telemetry.rx_crc_errors += crc_ok ? 0 : 1;
+
+	write_end(key);
+}
+
+void dtm_telemetry_tx(void)
+{
+	unsigned int key = write_begin();
+
+	dtm_telemetry.tx_packets++;
+
+	write_end(key);
+}
+
+void dtm_telemetry_isr(uint8_t id, uint32_t count, uint32_t max)
+{
+	unsigned int key;
+
+	if (id >= DTM_TELEMETRY_ISR_MAX) {
+		return;
+	}
+
+	key = write_begin();
+
+	dtm_telemetry.isr[id].count = count;
+	dtm_telemetry.isr[id].max = max;
+
+	write_end(key);
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_TELEMETRY_H_
+#define DTM_TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Telemetry block identifier, "DTMT" in memory. */
+#define DTM_TELEMETRY_MAGIC 0x544D5444
+
+/** Layout version of the telemetry block. Fields are only appended, the
+ *  version changes when an existing field moves or changes its meaning.
+ */
+#define DTM_TELEMETRY_VERSION 1
+
+/** Number of the interrupt handler entries, see enum dtm_isr_id. */
+#define DTM_TELEMETRY_ISR_MAX 8
+
+/** @brief DTM state reported in the telemetry block. */
+enum dtm_telemetry_state {
+	/** DTM is not initialized. */
+	DTM_TELEMETRY_STATE_UNINITIALIZED,
+
+	/** No test is running. */
+	DTM_TELEMETRY_STATE_IDLE,
+
+	/** Transmitter test. */
+	DTM_TELEMETRY_STATE_TX,
+
+	/** Unmodulated carrier test. */
+	DTM_TELEMETRY_STATE_CARRIER,
+
+	/** Receiver test. */
+	DTM_TELEMETRY_STATE_RX,
+
+	/** RSSI sweep. */
+	DTM_TELEMETRY_STATE_RSSI_SWEEP,
+};
+
+/** @brief Interrupt handler entry of the telemetry block. */
+struct dtm_telemetry_isr {
+	/** Number of executions. */
+	uint32_t count;
+
+	/** Longest execution, in CPU cycles. */
+	uint32_t max;
+};
+
+/** @brief Telemetry block.
+ *
+ * The block is placed in the .dtm_telemetry RAM section, at the address of
+ * the dtm_telemetry symbol, and is read by a debugger over SWD while the
+ * test runs. It is updated in the existing radio interrupt and test setup
+ * paths, nothing is sent by the device. All fields are little-endian.
+ *
+ * The writers increment seq before and after each update, a reader retries
+ * until seq is even and unchanged across its read.
+ */
+struct dtm_telemetry {
+	/** DTM_TELEMETRY_MAGIC once the block is initialized. */
+	uint32_t magic;
+
+	/** Layout version, DTM_TELEMETRY_VERSION. */
+	uint16_t version;
+
+	/** Size of the block, in octets. */
+	uint16_t size;
+
+	/** Sequence counter, odd while an update is in progress. */
+	uint32_t seq;
+
+	/** DTM state, see enum dtm_telemetry_state. */
+	uint8_t state;
+
+	/** DTM channel of the current or last test. */
+	uint8_t channel;
+
+	/** PHY, see enum dtm_phy. */
+	uint8_t phy;
+
+	/** RSSI of the last received packet, in dBm. */
+	int8_t rssi_last;
+
+	/** Number of tests started since boot. */
+	uint32_t tests;
+
+	/** Packets received with a valid CRC and payload in the current or last test. */
+	uint32_t rx_packets;
+
+	/** Packets received with a CRC error in the current or last test. */
+	uint32_t rx_crc_errors;
+
+	/** Packets sent in the current or last transmitter test. */
+	uint32_t tx_packets;
+
+	/** Interrupt handler statistics, with CONFIG_DTM_ISR_STATS. */
+	struct dtm_telemetry_isr isr[DTM_TELEMETRY_ISR_MAX];
+};
+
+#if CONFIG_DTM_TELEMETRY
+/** @brief Initialize the telemetry block. */
+void dtm_telemetry_init(void);
+
+/** @brief Report a DTM state change.
+ *
+ * The packet counters are cleared when a test starts.
+ *
+ * @param[in] state   DTM state.
+ * @param[in] channel DTM channel of the test.
+ */
+void dtm_telemetry_state_set(enum dtm_telemetry_state state, uint8_t channel);
+
+/** @brief Report the PHY.
+ *
+ * @param[in] phy PHY, see enum dtm_phy.
+ */
+void dtm_telemetry_phy_set(uint8_t phy);
+
+/** @brief Report a received packet.
+ *
+ * @param[in] ok     The packet was received with a valid CRC and payload.
+ * @param[in] crc_ok The CRC of the packet is valid.
+ * @param[in] rssi   RSSI of the packet, in dBm.
+ */
+void dtm_telemetry_rx(bool ok, bool crc_ok, int8_t rssi);
+
+/** @brief Report a sent packet. */
+void dtm_telemetry_tx(void);
+
+/** @brief Report the statistics of an interrupt handler.
+ *
+ * @param[in] id    Handler, see enum dtm_isr_id.
+ * @param[in] count Number of executions.
+ * @param[in] max   Longest execution, in CPU cycles.
+ */
+void dtm_telemetry_isr(uint8_t id, uint32_t count, uint32_t max);
+#else
+static inline void dtm_telemetry_init(void)
+{
+}
+
+static inline void dtm_telemetry_state_set(enum dtm_telemetry_state state, uint8_t channel)
+{
+	ARG_UNUSED(state);
+	ARG_UNUSED(channel);
+}
+
+static inline void dtm_telemetry_phy_set(uint8_t phy)
+{
+	ARG_UNUSED(phy);
+}
+
+static inline void dtm_telemetry_rx(bool ok, bool crc_ok, int8_t rssi)
+{
+	ARG_UNUSED(ok);
+	ARG_UNUSED(crc_ok);
+	ARG_UNUSED(rssi);
+}
+
+static inline void dtm_telemetry_tx(void)
+{
+}
+
+static inline void dtm_telemetry_isr(uint8_t id, uint32_t count, uint32_t max)
+{
+	ARG_UNUSED(id);
+	ARG_UNUSED(count);
+	ARG_UNUSED(max);
+}
+#endif /* CONFIG_DTM_TELEMETRY */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_TELEMETRY_H_ */
@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm.h"
+#include "dtm_config.h"
+#include "dtm_exec.h"
+#include "dtm_test_plan.h"
+
+LOG_MODULE_REGISTER(dtm_test_plan, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
+
+/* Settings keys of the test plan and of the result log. */
+#define PLAN_SETTINGS_ROOT "dtm/plan"
+#define PLAN_SETTINGS_STEPS PLAN_SETTINGS_ROOT "/steps"
+#define LOG_SETTINGS_ROOT "dtm/log"
+#define LOG_SETTINGS_SEQ LOG_SETTINGS_ROOT "/seq"
+
+/* Maximum length of the settings key of a log slot. */
+#define LOG_SLOT_KEY_LEN (sizeof(LOG_SETTINGS_ROOT) + 4)
+
+#define LOG_BATCH CONFIG_DTM_TEST_PLAN_LOG_BATCH
+#define LOG_SLOTS CONFIG_DTM_TEST_PLAN_LOG_SLOTS
+
+/* Highest DTM channel. */
+#define PLAN_CHANNEL_MAX 39
+
+/* Zero length vendor specific packet is the carrier test. */
+#define PLAN_CARRIER_LENGTH 0
+
+/* Test plan record, also the flash format. */
+struct dtm_plan {
+	uint8_t count;
+	uint8_t repeat;
+	struct dtm_plan_step steps[CONFIG_DTM_TEST_PLAN_MAX_STEPS];
+} __packed;
+
+/* Header size of the test plan record. */
+#define PLAN_HDR_SIZE offsetof(struct dtm_plan, steps)
+
+/* Flags of the test plan thread. */
+enum {
+	PLAN_RUNNING,
+	PLAN_STOP,
+};
+
+static struct dtm_plan plan = {
+	.repeat = 1,
+};
+
+/* Step submitted to the executor. */
+struct step_ctx {
+	const struct dtm_plan_step *step;
+	struct dtm_plan_result *res;
+};
+
+static K_MUTEX_DEFINE(plan_lock);
+static K_SEM_DEFINE(plan_run_sem, 0, 1);
+static K_SEM_DEFINE(plan_stop_sem, 0, 1);
+static atomic_t plan_flags;
+
+/* Results of the batch which is currently filled. The batch is written
+ * to flash as one settings entry when it is full or when the plan ends,
+ * so a step does not cost a flash write.
+ */
+static struct dtm_plan_result log_batch[LOG_BATCH];
+static uint32_t log_seq;
+static uint32_t log_flushed_seq;
+static K_MUTEX_DEFINE(log_lock);
+
+static bool step_valid(const struct dtm_plan_step *step)
+{
+	return (step->mode <= DTM_PLAN_MODE_CARRIER) &&
+	       (step->channel <= PLAN_CHANNEL_MAX) &&
+	       (step->phy <= DTM_PHY_CODED_S2) &&
+	       (step->packet < DTM_PACKET_VENDOR) &&
+	       (step->duration > 0);
+}
+
+static void log_slot_key(char *key, uint32_t batch)
+{
+	snprintf(key, LOG_SLOT_KEY_LEN, LOG_SETTINGS_ROOT "/%u",
+		 (unsigned int)(batch % LOG_SLOTS));
+}
+
+static int plan_settings_set(const char *name, size_t len,
+			     settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	struct dtm_plan tmp;
+	ssize_t rc;
+
+	if (!settings_name_steq(name, "steps", &next) || next) {
+		return -ENOENT;
+	}
+
+	if ((len < PLAN_HDR_SIZE) || (len > sizeof(tmp))) {
+		return -EINVAL;
+	}
+
+	rc = read_cb(cb_arg, &tmp, len);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if ((tmp.count > CONFIG_DTM_TEST_PLAN_MAX_STEPS) ||
+	    (len != PLAN_HDR_SIZE + tmp.count * sizeof(tmp.steps[0]))) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < tmp.count; i++) {
+		if (!step_valid(&tmp.steps[i])) {
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	plan = tmp;
+	k_mutex_unlock(&plan_lock);
+
+	return 0;
+}
+
+static int log_settings_set(const char *name, size_t len,
+			    settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	uint32_t seq;
+	ssize_t rc;
+
+	/* The result batches are read on demand. */
+	if (!settings_name_steq(name, "seq", &next) || next) {
+		return 0;
+	}
+
+	if (len != sizeof(seq)) {
+		return -EINVAL;
+	}
+
+	rc = read_cb(cb_arg, &seq, sizeof(seq));
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* A partially filled batch is not reloaded, continue with a new one. */
+	log_seq = ROUND_UP(seq, LOG_BATCH);
+	log_flushed_seq = log_seq;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(dtm_plan, PLAN_SETTINGS_ROOT, NULL,
+			       plan_settings_set, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(dtm_plan_log, LOG_SETTINGS_ROOT, NULL,
+			       log_settings_set, NULL, NULL);
+
+static int log_flush(void)
+{
+	char key[LOG_SLOT_KEY_LEN];
+	uint32_t batch;
+	size_t count;
+	int err;
+
+	if (log_seq == log_flushed_seq) {
+		return 0;
+	}
+
+	batch = (log_seq - 1) / LOG_BATCH;
+	count = log_seq - batch * LOG_BATCH;
+
+	log_slot_key(key, batch);
+	err = settings_save_one(key, log_batch, count * sizeof(log_batch[0]));
+	if (err) {
+		LOG_ERR("Result batch %u not stored: %d", batch, err);
+		return err;
+	}
+
+	err = settings_save_one(LOG_SETTINGS_SEQ, &log_seq, sizeof(log_seq));
+	if (err) {
+		LOG_ERR("Result sequence not stored: %d", err);
+		return err;
+	}
+
+	log_flushed_seq = log_seq;
+
+	return 0;
+}
+
+static void result_log(struct dtm_plan_result *res)
+{
+	k_mutex_lock(&log_lock, K_FOREVER);
+
+	res->seq = log_seq;
+	log_batch[log_seq % LOG_BATCH] = *res;
+	log_seq++;
+
+	if ((log_seq % LOG_BATCH) == 0) {
+		(void)log_flush();
+	}
+
+	k_mutex_unlock(&log_lock);
+}
+
+static int step_start(void *ctx)
+{
+	const struct step_ctx *sc = ctx;
+	const struct dtm_plan_step *step = sc->step;
+	struct dtm_tx_power power;
+	uint16_t cnt;
+	int err;
+
+	/* End a test started by the transport or at boot. */
+	(void)dtm_test_end(&cnt);
+
+	err = dtm_setup_reset();
+	if (err) {
+		return err;
+	}
+
+	/* The vendor specific carrier is only available on the uncoded PHYs. */
+	err = dtm_setup_set_phy((step->mode == DTM_PLAN_MODE_CARRIER) ?
+				DTM_PHY_1M : step->phy);
+	if (err) {
+		return err;
+	}
+
+	power = dtm_setup_set_transmit_power(DTM_TX_POWER_REQUEST_VAL, step->power,
+					     step->channel);
+	sc->res->power = power.power;
+
+	switch (step->mode) {
+	case DTM_PLAN_MODE_RX:
+		return dtm_test_receive(step->channel);
+
+	case DTM_PLAN_MODE_TX:
+		return dtm_test_transmit(step->channel, step->length, step->packet);
+
+	case DTM_PLAN_MODE_CARRIER:
+		return dtm_test_transmit(step->channel, PLAN_CARRIER_LENGTH,
+					 DTM_PACKET_FF_OR_VENDOR);
+
+	default:
+		return -EINVAL;
+	}
+}
+
+static int step_end(void *ctx)
+{
+	const struct step_ctx *sc = ctx;
+	struct dtm_rx_stats stats;
+	uint16_t cnt;
+
+	if ((sc->step->mode == DTM_PLAN_MODE_RX) && !dtm_rx_stats_get(&stats)) {
+		sc->res->packets = stats.packets;
+		sc->res->crc_errors = MIN(stats.crc_errors, UINT16_MAX);
+	}
+
+	return dtm_test_end(&cnt);
+}
+
+static int step_run(const struct dtm_plan_step *step, uint16_t run, uint8_t idx)
+{
+	struct dtm_plan_result res = {
+		.run = run,
+		.step = idx,
+		.mode = step->mode,
+		.channel = step->channel,
+	};
+	struct step_ctx sc = {
+		.step = step,
+		.res = &res,
+	};
+	int err;
+
+	err = dtm_exec_call(DTM_EXEC_CLIENT_RUNNER, step_start, &sc);
+	if (!err) {
+		/* The step ends early if the plan is stopped. */
+		(void)k_sem_take(&plan_stop_sem, K_SECONDS(step->duration));
+
+		err = dtm_exec_call(DTM_EXEC_CLIENT_RUNNER, step_end, &sc);
+	}
+
+	res.status = err;
+	res.uptime = k_uptime_get() / MSEC_PER_SEC;
+
+	DTM_DIAG("[PLAN] Run %u step %u: mode %u ch %u, status %d, packets %u\n",
+		 run, idx, step->mode, step->channel, err, res.packets);
+
+	result_log(&res);
+
+	return err;
+}
+
+static void plan_execute(void)
+{
+	struct dtm_plan snapshot;
+
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	snapshot = plan;
+	k_mutex_unlock(&plan_lock);
+
+	k_sem_reset(&plan_stop_sem);
+
+	for (uint16_t run = 0; (snapshot.repeat == 0) || (run < snapshot.repeat); run++) {
+		for (uint8_t i = 0; i < snapshot.count; i++) {
+			if (atomic_test_bit(&plan_flags, PLAN_STOP)) {
+				goto done;
+			}
+
+			/* The plan ends when the tester took the engine over. */
+			if (step_run(&snapshot.steps[i], run, i) == -ECANCELED) {
+				goto done;
+			}
+		}
+	}
+
+done:
+	k_mutex_lock(&log_lock, K_FOREVER);
+	(void)log_flush();
+	k_mutex_unlock(&log_lock);
+
+	dtm_exec_release(DTM_EXEC_CLIENT_RUNNER);
+
+	atomic_clear_bit(&plan_flags, PLAN_STOP);
+	atomic_clear_bit(&plan_flags, PLAN_RUNNING);
+}
+
+static void plan_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		k_sem_take(&plan_run_sem, K_FOREVER);
+		plan_execute();
+	}
+}
+
+K_THREAD_DEFINE(dtm_plan_thread, CONFIG_DTM_TEST_PLAN_THREAD_STACK_SIZE, plan_thread,
+		NULL, NULL, NULL, CONFIG_DTM_TEST_PLAN_THREAD_PRIORITY, 0, 0);
+
+int dtm_test_plan_init(void)
+{
+	int err;
+
+	err = settings_load_subtree(PLAN_SETTINGS_ROOT);
+	if (err) {
+		LOG_ERR("Loading the test plan failed: %d", err);
+		return err;
+	}
+
+	err = settings_load_subtree(LOG_SETTINGS_SEQ);
+	if (err) {
+		LOG_ERR("Loading the result log failed: %d", err);
+		return err;
+	}
+
+	return 0;
+}
+
+void dtm_test_plan_clear(void)
+{
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	plan.count = 0;
+	plan.repeat = 1;
+	k_mutex_unlock(&plan_lock);
+}
+
+int dtm_test_plan_step_add(const struct dtm_plan_step *step)
+{
+	int err = 0;
+
+	if (!step || !step_valid(step)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	if (plan.count < CONFIG_DTM_TEST_PLAN_MAX_STEPS) {
+		plan.steps[plan.count++] = *step;
+	} else {
+		err = -ENOMEM;
+	}
+	k_mutex_unlock(&plan_lock);
+
+	return err;
+}
+
+void dtm_test_plan_repeat_set(uint8_t repeat)
+{
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	plan.repeat = repeat;
+	k_mutex_unlock(&plan_lock);
+}
+
+int dtm_test_plan_step_get(uint8_t idx, struct dtm_plan_step *step)
+{
+	int err = 0;
+
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	if (idx < plan.count) {
+		*step = plan.steps[idx];
+	} else {
+		err = -ENOENT;
+	}
+	k_mutex_unlock(&plan_lock);
+
+	return err;
+}
+
+uint8_t dtm_test_plan_count_get(uint8_t *repeat)
+{
+	uint8_t count;
+
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	count = plan.count;
+	if (repeat) {
+		*repeat = plan.repeat;
+	}
+	k_mutex_unlock(&plan_lock);
+
+	return count;
+}
+
+int dtm_test_plan_save(void)
+{
+	int err;
+
+	k_mutex_lock(&plan_lock, K_FOREVER);
+	err = settings_save_one(PLAN_SETTINGS_STEPS, &plan,
+				PLAN_HDR_SIZE + plan.count * sizeof(plan.steps[0]));
+	k_mutex_unlock(&plan_lock);
+
+	return err;
+}
+
+int dtm_test_plan_run(void)
+{
+	int err;
+
+	if (dtm_test_plan_count_get(NULL) == 0) {
+		return -ENOENT;
+	}
+
+	if (atomic_test_and_set_bit(&plan_flags, PLAN_RUNNING)) {
+		return -EBUSY;
+	}
+
+	/* The plan owns the DTM engine until it ends. */
+	err = dtm_exec_claim(DTM_EXEC_CLIENT_RUNNER);
+	if (err) {
+		atomic_clear_bit(&plan_flags, PLAN_RUNNING);
+		return err;
+	}
+
+	k_sem_give(&plan_run_sem);
+
+	return 0;
+}
+
+void dtm_test_plan_stop(void)
+{
+	if (!atomic_test_bit(&plan_flags, PLAN_RUNNING)) {
+		return;
+	}
+
+	atomic_set_bit(&plan_flags, PLAN_STOP);
+	k_sem_give(&plan_stop_sem);
+}
+
+bool dtm_test_plan_running(void)
+{
+	return atomic_test_bit(&plan_flags, PLAN_RUNNING);
+}
+
+struct log_read_ctx {
+	struct dtm_plan_result *res;
+	size_t max;
+	int count;
+};
+
+static int log_read_cb(const char *key, size_t len, settings_read_cb read_cb,
+		       void *cb_arg, void *param)
+{
+	struct log_read_ctx *ctx = param;
+	size_t count = MIN(len / sizeof(ctx->res[0]), ctx->max);
+	ssize_t rc;
+
+	/* Only the exact slot key. */
+	if (key && *key) {
+		return 0;
+	}
+
+	rc = read_cb(cb_arg, ctx->res, count * sizeof(ctx->res[0]));
+	if (rc < 0) {
+		return rc;
+	}
+
+	ctx->count = count;
+
+	return 0;
+}
+
+int dtm_test_plan_log_read(uint16_t batch, struct dtm_plan_result *res, size_t max)
+{
+	struct log_read_ctx ctx = {
+		.res = res,
+		.max = max,
+		.count = -ENOENT,
+	};
+	char key[LOG_SLOT_KEY_LEN];
+	uint32_t written;
+	uint32_t oldest;
+	uint32_t abs_batch;
+	int err;
+
+	if (!res || (max == 0)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&log_lock, K_FOREVER);
+	written = DIV_ROUND_UP(log_flushed_seq, LOG_BATCH);
+	k_mutex_unlock(&log_lock);
+
+	oldest = (written > LOG_SLOTS) ? (written - LOG_SLOTS) : 0;
+	abs_batch = oldest + batch;
+	if (abs_batch >= written) {
+		return -ENOENT;
+	}
+
+	log_slot_key(key, abs_batch);
+	err = settings_load_subtree_direct(key, log_read_cb, &ctx);
+	if (err) {
+		return err;
+	}
+
+	/* Skip a batch from a previous log which was not overwritten yet. */
+	if ((ctx.count > 0) && ((res[0].seq / LOG_BATCH) != abs_batch)) {
+		return -ENOENT;
+	}
+
+	return ctx.count;
+}
+
+int dtm_test_plan_log_clear(void)
+{
+	char key[LOG_SLOT_KEY_LEN];
+	int err = 0;
+
+	k_mutex_lock(&log_lock, K_FOREVER);
+
+	for (uint32_t i = 0; i < LOG_SLOTS; i++) {
+		log_slot_key(key, i);
+		(void)settings_delete(key);
+	}
+
+	log_seq = 0;
+	log_flushed_seq = 0;
+	err = settings_delete(LOG_SETTINGS_SEQ);
+
+	k_mutex_unlock(&log_lock);
+
+	return err;
+}
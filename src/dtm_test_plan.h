@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_TEST_PLAN_H_
+#define DTM_TEST_PLAN_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Test executed by a test plan step. */
+enum dtm_plan_mode {
+	/** Receiver test. */
+	DTM_PLAN_MODE_RX,
+
+	/** Transmitter test. */
+	DTM_PLAN_MODE_TX,
+
+	/** Unmodulated carrier. */
+	DTM_PLAN_MODE_CARRIER,
+};
+
+/** @brief Test plan step.
+ *
+ * The structure is also the wire format of the step, little-endian.
+ */
+struct dtm_plan_step {
+	/** Test mode, see enum dtm_plan_mode. */
+	uint8_t mode;
+
+	/** DTM channel, 0 - 39. */
+	uint8_t channel;
+
+	/** PHY, see enum dtm_phy. Ignored for the carrier. */
+	uint8_t phy;
+
+	/** Transmit power in dBm. */
+	int8_t power;
+
+	/** Packet length of the transmitter test. */
+	uint8_t length;
+
+	/** Packet type of the transmitter test, see enum dtm_packet. */
+	uint8_t packet;
+
+	/** Step duration in seconds. */
+	uint16_t duration;
+} __packed;
+
+/** @brief Result of a test plan step.
+ *
+ * The structure is also the flash and wire format of the result, little-endian.
+ */
+struct dtm_plan_result {
+	/** Sequence number of the result. */
+	uint32_t seq;
+
+	/** Uptime at the end of the step, in seconds. */
+	uint32_t uptime;
+
+	/** Plan repetition. */
+	uint16_t run;
+
+	/** Step index. */
+	uint8_t step;
+
+	/** Test mode, see enum dtm_plan_mode. */
+	uint8_t mode;
+
+	/** DTM channel. */
+	uint8_t channel;
+
+	/** Actual transmit power in dBm. */
+	int8_t power;
+
+	/** Step status, 0 or a negative error code. */
+	int8_t status;
+
+	/** Padding, always 0. */
+	uint8_t reserved;
+
+	/** Number of packets received. */
+	uint16_t packets;
+
+	/** Number of packets received with an invalid CRC. */
+	uint16_t crc_errors;
+} __packed;
+
+/** @brief Initialize the test plan module and load the stored plan.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_test_plan_init(void);
+
+/** @brief Clear the test plan in RAM. */
+void dtm_test_plan_clear(void);
+
+/** @brief Append a step to the test plan in RAM.
+ *
+ * @param[in] step Test plan step.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_test_plan_step_add(const struct dtm_plan_step *step);
+
+/** @brief Set the number of plan repetitions.
+ *
+ * @param[in] repeat Number of repetitions, 0 to repeat forever.
+ */
+void dtm_test_plan_repeat_set(uint8_t repeat);
+
+/** @brief Get a step of the test plan in RAM.
+ *
+ * @param[in]  idx  Step index.
+ * @param[out] step Test plan step.
+ *
+ * @return 0 in case of success or -ENOENT if there is no such step.
+ */
+int dtm_test_plan_step_get(uint8_t idx, struct dtm_plan_step *step);
+
+/** @brief Get the number of steps and repetitions of the test plan in RAM.
+ *
+ * @param[out] repeat Number of repetitions, can be NULL.
+ *
+ * @return Number of steps.
+ */
+uint8_t dtm_test_plan_count_get(uint8_t *repeat);
+
+/** @brief Store the test plan in flash.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_test_plan_save(void);
+
+/** @brief Start the test plan in the test plan thread.
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOENT if the plan is empty.
+ * @retval -EBUSY if the plan is already running.
+ */
+int dtm_test_plan_run(void);
+
+/** @brief Stop the running test plan.
+ *
+ * The current step ends immediately and its result is logged.
+ */
+void dtm_test_plan_stop(void);
+
+/** @brief Check if the test plan is running.
+ *
+ * @return True if the test plan is running.
+ */
+bool dtm_test_plan_running(void);
+
+/** @brief Read a batch of results from the flash log.
+ *
+ * @param[in]  batch Batch index, 0 is the oldest stored batch.
+ * @param[out] res   Result buffer.
+ * @param[in]  max   Number of results that fit the buffer.
+ *
+ * @return Number of results read or negative value in case of error.
+ *         -ENOENT if there is no such batch.
+ */
+int dtm_test_plan_log_read(uint16_t batch, struct dtm_plan_result *res, size_t max);
+
+/** @brief Erase the results from the flash log.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_test_plan_log_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_TEST_PLAN_H_ */
@@ -0,0 +1,659 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "dtm.h"
+#include "dtm_config.h"
+#include "dtm_vendor.h"
+
+#if CONFIG_DTM_TEST_PLAN
+#include "dtm_test_plan.h"
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+#if CONFIG_DTM_ISR_STATS
+#include "dtm_isr_stats.h"
+#endif /* CONFIG_DTM_ISR_STATS */
+
+#if CONFIG_DTM_PER
+#include "dtm_per.h"
+#endif /* CONFIG_DTM_PER */
+
+#if CONFIG_DTM_RSSI_STATS
+#include "dtm_rssi_stats.h"
+#endif /* CONFIG_DTM_RSSI_STATS */
+
+#if CONFIG_DTM_CTE_CFO
+#include "dtm_cte_cfo.h"
+#endif /* CONFIG_DTM_CTE_CFO */
+
+#if CONFIG_DTM_AOA
+#include "dtm_aoa.h"
+#endif /* CONFIG_DTM_AOA */
+
+#if CONFIG_DTM_IQ_STREAM
+#include "dtm_iq_stream.h"
+#endif /* CONFIG_DTM_IQ_STREAM */
+
+#if CONFIG_DTM_RSSI_SWEEP_RTT
+#include "dtm_rssi_rtt.h"
+#endif /* CONFIG_DTM_RSSI_SWEEP_RTT */
+
+static dtm_vendor_evt_cb_t vendor_evt_cb;
+
+#if CONFIG_DTM_TEST_PLAN
+static int plan_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+		    uint8_t *out, size_t *out_len)
+{
+	struct dtm_plan_step step;
+	int ret;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_PLAN_CLEAR:
+		dtm_test_plan_clear();
+		return 0;
+
+	case DTM_VENDOR_OP_PLAN_STEP_ADD:
+		if (in_len != sizeof(step)) {
+			return -EINVAL;
+		}
+
+		memcpy(&step, in, sizeof(step));
+		step.duration = sys_le16_to_cpu(step.duration);
+
+		return dtm_test_plan_step_add(&step);
+
+	case DTM_VENDOR_OP_PLAN_REPEAT_SET:
+		if (in_len != 1) {
+			return -EINVAL;
+		}
+
+		dtm_test_plan_repeat_set(in[0]);
+		return 0;
+
+	case DTM_VENDOR_OP_PLAN_SAVE:
+		return dtm_test_plan_save();
+
+	case DTM_VENDOR_OP_PLAN_RUN:
+		return dtm_test_plan_run();
+
+	case DTM_VENDOR_OP_PLAN_STOP:
+		dtm_test_plan_stop();
+		return 0;
+
+	case DTM_VENDOR_OP_PLAN_LOG_READ:
+		if (in_len != sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+
+		/* Results are stored in the little-endian wire format. */
+		ret = dtm_test_plan_log_read(sys_get_le16(in), (struct dtm_plan_result *)out,
+					     DTM_VENDOR_RSP_MAX_SIZE /
+					     sizeof(struct dtm_plan_result));
+		if (ret < 0) {
+			return ret;
+		}
+
+		*out_len = ret * sizeof(struct dtm_plan_result);
+		return 0;
+
+	case DTM_VENDOR_OP_PLAN_LOG_CLEAR:
+		return dtm_test_plan_log_clear();
+
+	default:
+		return -ENOTSUP;
+	}
+}
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+#if CONFIG_DTM_ISR_STATS
+static int isr_stats_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+			 uint8_t *out, size_t *out_len)
+{
+	struct dtm_isr_stat stat;
+	int err;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_ISR_STATS_READ:
+		if (in_len != 1) {
+			return -EINVAL;
+		}
+
+		err = dtm_isr_stats_get(in[0], &stat);
+		if (err) {
+			return err;
+		}
+
+		memcpy(out, &stat, sizeof(stat));
+		*out_len = sizeof(stat);
+		return 0;
+
+	case DTM_VENDOR_OP_ISR_STATS_RESET:
+		dtm_isr_stats_reset();
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+#endif /* CONFIG_DTM_ISR_STATS */
+
+#if CONFIG_DTM_EXEC
+static int exec_stats_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+			  uint8_t *out, size_t *out_len)
+{
+	struct dtm_exec_stat stat;
+	int err;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_EXEC_STATS_READ:
+		if (in_len != 1) {
+			return -EINVAL;
+		}
+
+		err = dtm_exec_stats_get(in[0], &stat);
+		if (err) {
+			return err;
+		}
+
+		memcpy(out, &stat, sizeof(stat));
+		*out_len = sizeof(stat);
+		return 0;
+
+	case DTM_VENDOR_OP_EXEC_STATS_RESET:
+		dtm_exec_stats_reset();
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+#endif /* CONFIG_DTM_EXEC */
+
+static int rx_timing_cmd(const uint8_t *in, size_t in_len, uint8_t *out, size_t *out_len)
+{
+	struct dtm_rx_timing timing;
+	int err;
+
+	ARG_UNUSED(in);
+
+	if (in_len != 0) {
+		return -EINVAL;
+	}
+
+	err = dtm_rx_timing_get(&timing);
+	if (err) {
+		return err;
+	}
+
+	memcpy(out, &timing, sizeof(timing));
+	*out_len = sizeof(timing);
+	return 0;
+}
+
+static int tx_stats_cmd(const uint8_t *in, size_t in_len, uint8_t *out, size_t *out_len)
+{
+	struct dtm_tx_stats stats;
+	int err;
+
+	ARG_UNUSED(in);
+
+	if (in_len != 0) {
+		return -EINVAL;
+	}
+
+	err = dtm_tx_stats_get(&stats);
+	if (err) {
+		return err;
+	}
+
+	memcpy(out, &stats, sizeof(stats));
+	*out_len = sizeof(stats);
+	return 0;
+}
+
+#if CONFIG_DTM_TX_BURST
+static void tx_burst_done(uint32_t packets)
+{
+	uint8_t data[sizeof(uint32_t)];
+
+	sys_put_le32(packets, data);
+
+	if (vendor_evt_cb) {
+		vendor_evt_cb(DTM_VENDOR_EVT_TX_BURST_DONE, data, sizeof(data));
+	}
+}
+
+static int tx_burst_cmd(const uint8_t *in, size_t in_len)
+{
+	if (in_len != (3 + sizeof(uint32_t))) {
+		return -EINVAL;
+	}
+
+	return dtm_test_transmit_burst(in[0], in[1], in[2], sys_get_le32(&in[3]),
+				       tx_burst_done);
+}
+#endif /* CONFIG_DTM_TX_BURST */
+
+static int rx_scan_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+		       uint8_t *out, size_t *out_len)
+{
+	struct dtm_rx_scan_config cfg;
+	int err;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_RX_SCAN:
+		if (in_len != sizeof(cfg)) {
+			return -EINVAL;
+		}
+
+		memcpy(&cfg, in, sizeof(cfg));
+		cfg.dwell_ms = sys_le16_to_cpu(cfg.dwell_ms);
+
+		return dtm_test_receive_scan(&cfg);
+
+	case DTM_VENDOR_OP_RX_SCAN_READ:
+		if (in_len != 0) {
+			return -EINVAL;
+		}
+
+		BUILD_ASSERT(sizeof(struct dtm_rx_scan_stat) * DTM_CHANNEL_COUNT <=
+			     DTM_VENDOR_RSP_MAX_SIZE);
+
+		/* Statistics are kept in the little-endian wire format. */
+		err = dtm_rx_scan_stats_get((struct dtm_rx_scan_stat *)out, DTM_CHANNEL_COUNT);
+		if (err) {
+			return err;
+		}
+
+		*out_len = sizeof(struct dtm_rx_scan_stat) * DTM_CHANNEL_COUNT;
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+
+#if CONFIG_DTM_RSSI_STATS
+static int rssi_stats_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+			  uint8_t *out, size_t *out_len)
+{
+	struct dtm_rssi_stat stat;
+	uint32_t hist[DTM_VENDOR_RSP_MAX_SIZE / sizeof(uint32_t)];
+	int count;
+	int err;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_RSSI_STATS_READ:
+		if (in_len != 1) {
+			return -EINVAL;
+		}
+
+		err = dtm_rssi_stats_get(in[0], &stat);
+		if (err) {
+			return err;
+		}
+
+		memcpy(out, &stat, sizeof(stat));
+		*out_len = sizeof(stat);
+		return 0;
+
+	case DTM_VENDOR_OP_RSSI_HIST_READ:
+		if (in_len != 2) {
+			return -EINVAL;
+		}
+
+		count = dtm_rssi_stats_hist_get(in[0], in[1], hist, ARRAY_SIZE(hist));
+		if (count < 0) {
+			return count;
+		}
+
+		*out_len = count * sizeof(hist[0]);
+		memcpy(out, hist, *out_len);
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+#endif /* CONFIG_DTM_RSSI_STATS */
+
+#if CONFIG_DTM_CTE_CFO
+static int cte_cfo_cmd(const uint8_t *in, size_t in_len, uint8_t *out, size_t *out_len)
+{
+	struct dtm_cte_cfo_stats stats;
+	int err;
+
+	ARG_UNUSED(in);
+
+	if (in_len != 0) {
+		return -EINVAL;
+	}
+
+	err = dtm_cte_cfo_stats_get(&stats);
+	if (err) {
+		return err;
+	}
+
+	memcpy(out, &stats, sizeof(stats));
+	*out_len = sizeof(stats);
+	return 0;
+}
+#endif /* CONFIG_DTM_CTE_CFO */
+
+#if CONFIG_DTM_AOA
+static int aoa_cmd(const uint8_t *in, size_t in_len, uint8_t *out, size_t *out_len)
+{
+	struct dtm_aoa_stats stats;
+	int err;
+
+	ARG_UNUSED(in);
+
+	if (in_len != 0) {
+		return -EINVAL;
+	}
+
+	err = dtm_aoa_stats_get(&stats);
+	if (err) {
+		return err;
+	}
+
+	memcpy(out, &stats, sizeof(stats));
+	*out_len = sizeof(stats);
+	return 0;
+}
+#endif /* CONFIG_DTM_AOA */
+
+#if CONFIG_DTM_AOA_REPORT
+static void aoa_report(const struct dtm_aoa_report *report)
+{
+	/* The report is kept in the little-endian wire format. */
+	if (vendor_evt_cb) {
+		vendor_evt_cb(DTM_VENDOR_EVT_AOA, (const uint8_t *)report, sizeof(*report));
+	}
+}
+#endif /* CONFIG_DTM_AOA_REPORT */
+
+#if CONFIG_DTM_IQ_STREAM
+static void iq_stream_piece(const uint8_t *data, size_t len)
+{
+	if (vendor_evt_cb) {
+		vendor_evt_cb(DTM_VENDOR_EVT_IQ_STREAM, data, len);
+	}
+}
+
+static int iq_stream_cmd(const uint8_t *in, size_t in_len)
+{
+	if ((in_len != 1) || (in[0] > 1)) {
+		return -EINVAL;
+	}
+
+	/* The stream needs a transport reporting the vendor events. */
+	if (in[0] && !vendor_evt_cb) {
+		return -ENOTSUP;
+	}
+
+	dtm_iq_stream_cb_set(in[0] ? iq_stream_piece : NULL);
+	return 0;
+}
+#endif /* CONFIG_DTM_IQ_STREAM */
+
+#if CONFIG_DTM_RSSI_SWEEP_RTT
+static int rssi_sweep_cmd(uint16_t opcode, const uint8_t *in, size_t in_len)
+{
+	struct dtm_rssi_sweep_config cfg;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_RSSI_SWEEP:
+		if (in_len != sizeof(cfg)) {
+			return -EINVAL;
+		}
+
+		memcpy(&cfg, in, sizeof(cfg));
+
+		return dtm_rssi_sweep_start(&cfg, dtm_rssi_rtt_send);
+
+	case DTM_VENDOR_OP_RSSI_SWEEP_STOP:
+		dtm_rssi_sweep_stop();
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+#endif /* CONFIG_DTM_RSSI_SWEEP_RTT */
+
+static int tx_power_cal_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+			    uint8_t *out, size_t *out_len)
+{
+	int ret;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_TX_POWER_CAL_SET:
+		return dtm_config_tx_power_cal_set((const int8_t *)in, in_len);
+
+	case DTM_VENDOR_OP_TX_POWER_CAL_READ:
+		if (in_len != 0) {
+			return -EINVAL;
+		}
+
+		ret = dtm_tx_power_cal_get((int8_t *)out, DTM_TX_POWER_CAL_MAX);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*out_len = ret;
+		return 0;
+
+	case DTM_VENDOR_OP_TX_POWER_COMP_SET:
+		return dtm_config_tx_power_comp_set((const int8_t *)in, in_len);
+
+	case DTM_VENDOR_OP_TX_POWER_COMP_READ:
+		if (in_len != 0) {
+			return -EINVAL;
+		}
+
+		ret = dtm_tx_power_comp_get((int8_t *)out, DTM_CHANNEL_COUNT);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*out_len = ret;
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+
+#if CONFIG_DTM_PER
+static void per_done(uint16_t count)
+{
+	uint8_t data[sizeof(uint16_t)];
+
+	sys_put_le16(count, data);
+
+	if (vendor_evt_cb) {
+		vendor_evt_cb(DTM_VENDOR_EVT_PER_DONE, data, sizeof(data));
+	}
+}
+
+static int per_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+		   uint8_t *out, size_t *out_len)
+{
+	struct dtm_per_config cfg;
+
+	switch (opcode) {
+	case DTM_VENDOR_OP_PER_RUN:
+		if (in_len != sizeof(cfg)) {
+			return -EINVAL;
+		}
+
+		memcpy(&cfg, in, sizeof(cfg));
+		cfg.packets = sys_le16_to_cpu(cfg.packets);
+
+		return dtm_per_run(&cfg, per_done);
+
+	case DTM_VENDOR_OP_PER_STOP:
+		dtm_per_stop();
+		return 0;
+
+	case DTM_VENDOR_OP_PER_READ:
+		if (in_len != sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+
+		if (dtm_per_running()) {
+			return -EBUSY;
+		}
+
+		/* Results are kept in the little-endian wire format. */
+		*out_len = dtm_per_results_get(sys_get_le16(in), (struct dtm_per_result *)out,
+					       DTM_VENDOR_RSP_MAX_SIZE /
+					       sizeof(struct dtm_per_result)) *
+			   sizeof(struct dtm_per_result);
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+#endif /* CONFIG_DTM_PER */
+
+int dtm_vendor_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+		   uint8_t *out, size_t *out_len)
+{
+	if ((!in && in_len) || !out || !out_len) {
+		return -EINVAL;
+	}
+
+	*out_len = 0;
+
+	switch (opcode) {
+#if CONFIG_DTM_TEST_PLAN
+	case DTM_VENDOR_OP_PLAN_CLEAR ... DTM_VENDOR_OP_PLAN_LOG_CLEAR:
+		return plan_cmd(opcode, in, in_len, out, out_len);
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+#if CONFIG_DTM_ISR_STATS
+	case DTM_VENDOR_OP_ISR_STATS_READ:
+	case DTM_VENDOR_OP_ISR_STATS_RESET:
+		return isr_stats_cmd(opcode, in, in_len, out, out_len);
+#endif /* CONFIG_DTM_ISR_STATS */
+
+	case DTM_VENDOR_OP_RX_TIMING_READ:
+		return rx_timing_cmd(in, in_len, out, out_len);
+
+	case DTM_VENDOR_OP_TX_STATS_READ:
+		return tx_stats_cmd(in, in_len, out, out_len);
+
+#if CONFIG_DTM_TX_BURST
+	case DTM_VENDOR_OP_TX_BURST:
+		return tx_burst_cmd(in, in_len);
+#endif /* CONFIG_DTM_TX_BURST */
+
+	case DTM_VENDOR_OP_RX_SCAN:
+	case DTM_VENDOR_OP_RX_SCAN_READ:
+		return rx_scan_cmd(opcode, in, in_len, out, out_len);
+
+#if CONFIG_DTM_RSSI_STATS
+	case DTM_VENDOR_OP_RSSI_STATS_READ:
+	case DTM_VENDOR_OP_RSSI_HIST_READ:
+		return rssi_stats_cmd(opcode, in, in_len, out, out_len);
+#endif /* CONFIG_DTM_RSSI_STATS */
+
+#if CONFIG_DTM_CTE_CFO
+	case DTM_VENDOR_OP_CTE_CFO_READ:
+		return cte_cfo_cmd(in, in_len, out, out_len);
+#endif /* CONFIG_DTM_CTE_CFO */
+
+#if CONFIG_DTM_AOA
+	case DTM_VENDOR_OP_AOA_READ:
+		return aoa_cmd(in, in_len, out, out_len);
+#endif /* CONFIG_DTM_AOA */
+
+#if CONFIG_DTM_IQ_STREAM
+	case DTM_VENDOR_OP_IQ_STREAM:
+		return iq_stream_cmd(in, in_len);
+#endif /* CONFIG_DTM_IQ_STREAM */
+
+#if CONFIG_DTM_RSSI_SWEEP_RTT
+	case DTM_VENDOR_OP_RSSI_SWEEP:
+	case DTM_VENDOR_OP_RSSI_SWEEP_STOP:
+		return rssi_sweep_cmd(opcode, in, in_len);
+#endif /* CONFIG_DTM_RSSI_SWEEP_RTT */
+
+	case DTM_VENDOR_OP_TX_POWER_CAL_SET:
+	case DTM_VENDOR_OP_TX_POWER_CAL_READ:
+	case DTM_VENDOR_OP_TX_POWER_COMP_SET:
+	case DTM_VENDOR_OP_TX_POWER_COMP_READ:
+		return tx_power_cal_cmd(opcode, in, in_len, out, out_len);
+
+#if CONFIG_DTM_EXEC
+	case DTM_VENDOR_OP_EXEC_STATS_READ:
+	case DTM_VENDOR_OP_EXEC_STATS_RESET:
+		return exec_stats_cmd(opcode, in, in_len, out, out_len);
+#endif /* CONFIG_DTM_EXEC */
+
+#if CONFIG_DTM_PER
+	case DTM_VENDOR_OP_PER_RUN ... DTM_VENDOR_OP_PER_READ:
+		return per_cmd(opcode, in, in_len, out, out_len);
+#endif /* CONFIG_DTM_PER */
+
+	default:
+		return -ENOTSUP;
+	}
+}
+
+/* Arguments of a vendor command executed by the DTM executor. */
+struct vendor_cmd_args {
+	uint16_t opcode;
+	const uint8_t *in;
+	size_t in_len;
+	uint8_t *out;
+	size_t *out_len;
+};
+
+static int vendor_cmd_handler(void *ctx)
+{
+	struct vendor_cmd_args *args = ctx;
+
+	return dtm_vendor_cmd(args->opcode, args->in, args->in_len, args->out, args->out_len);
+}
+
+int dtm_vendor_cmd_exec(enum dtm_exec_client client, uint16_t opcode, const uint8_t *in,
+			size_t in_len, uint8_t *out, size_t *out_len)
+{
+	struct vendor_cmd_args args = {
+		.opcode = opcode,
+		.in = in,
+		.in_len = in_len,
+		.out = out,
+		.out_len = out_len,
+	};
+
+	return dtm_exec_call(client, vendor_cmd_handler, &args);
+}
+
+void dtm_vendor_evt_cb_set(dtm_vendor_evt_cb_t cb)
+{
+	vendor_evt_cb = cb;
+
+#if CONFIG_DTM_AOA_REPORT
+	dtm_aoa_report_cb_set(cb ? aoa_report : NULL);
+#endif /* CONFIG_DTM_AOA_REPORT */
+
+#if CONFIG_DTM_IQ_STREAM
+	if (!cb) {
+		dtm_iq_stream_cb_set(NULL);
+	}
+#endif /* CONFIG_DTM_IQ_STREAM */
+}
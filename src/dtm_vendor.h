@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_VENDOR_H_
+#define DTM_VENDOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dtm_exec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum size of the vendor command response, in octets.
+ *  It fits the return parameters of an HCI Command Complete event.
+ */
+#define DTM_VENDOR_RSP_MAX_SIZE 240
+
+/** @brief DTM vendor command opcodes.
+ *
+ * The opcodes are used as the OCF of the HCI vendor-specific commands
+ * (OGF 0x3F). All multi-octet parameters are little-endian.
+ */
+enum dtm_vendor_opcode {
+	/** Clear the test plan in RAM. No parameters. */
+	DTM_VENDOR_OP_PLAN_CLEAR = 0x0001,
+
+	/** Append a step to the test plan in RAM.
+	 *  Parameters: struct dtm_plan_step.
+	 */
+	DTM_VENDOR_OP_PLAN_STEP_ADD = 0x0002,
+
+	/** Set the number of plan repetitions.
+	 *  Parameters: repeat count (1 octet, 0 means forever).
+	 */
+	DTM_VENDOR_OP_PLAN_REPEAT_SET = 0x0003,
+
+	/** Store the test plan in flash. No parameters. */
+	DTM_VENDOR_OP_PLAN_SAVE = 0x0004,
+
+	/** Start the stored test plan. No parameters. */
+	DTM_VENDOR_OP_PLAN_RUN = 0x0005,
+
+	/** Stop the running test plan. No parameters. */
+	DTM_VENDOR_OP_PLAN_STOP = 0x0006,
+
+	/** Read a batch of test plan results from flash.
+	 *  Parameters: batch index from the oldest batch (2 octets).
+	 *  Response: array of struct dtm_plan_result.
+	 */
+	DTM_VENDOR_OP_PLAN_LOG_READ = 0x0007,
+
+	/** Erase the test plan results from flash. No parameters. */
+	DTM_VENDOR_OP_PLAN_LOG_CLEAR = 0x0008,
+
+	/** Read the execution time statistics of an interrupt handler.
+	 *  Parameters: handler, see enum dtm_isr_id (1 octet).
+	 *  Response: struct dtm_isr_stat.
+	 */
+	DTM_VENDOR_OP_ISR_STATS_READ = 0x0010,
+
+	/** Clear the interrupt handler statistics. No parameters. */
+	DTM_VENDOR_OP_ISR_STATS_RESET = 0x0011,
+
+	/** Read the receiver packet timing statistics. No parameters.
+	 *  Response: struct dtm_rx_timing.
+	 */
+	DTM_VENDOR_OP_RX_TIMING_READ = 0x0012,
+
+	/** Read the statistics of the last transmitter test. No parameters.
+	 *  Response: struct dtm_tx_stats.
+	 */
+	DTM_VENDOR_OP_TX_STATS_READ = 0x0013,
+
+	/** Start a transmitter test with a finite number of packets.
+	 *  Parameters: channel (1 octet), packet length (1 octet),
+	 *  packet type, see enum dtm_packet (1 octet), packet count (4 octets).
+	 *  The end of the burst is reported with DTM_VENDOR_EVT_TX_BURST_DONE.
+	 */
+	DTM_VENDOR_OP_TX_BURST = 0x0014,
+
+	/** Start a receiver test hopping through a channel list.
+	 *  Parameters: struct dtm_rx_scan_config.
+	 */
+	DTM_VENDOR_OP_RX_SCAN = 0x0015,
+
+	/** Read the receiver scan statistics. No parameters.
+	 *  Response: struct dtm_rx_scan_stat of each DTM channel.
+	 */
+	DTM_VENDOR_OP_RX_SCAN_READ = 0x0016,
+
+	/** Start an RSSI sweep. The sweeps are streamed over RTT.
+	 *  Parameters: struct dtm_rssi_sweep_config.
+	 */
+	DTM_VENDOR_OP_RSSI_SWEEP = 0x0017,
+
+	/** Stop the repeated RSSI sweep. No parameters. */
+	DTM_VENDOR_OP_RSSI_SWEEP_STOP = 0x0018,
+
+	/** Set and store the calibration offsets of the radio output power levels.
+	 *  Parameters: offset of each level from the lowest, in 0.25 dB units
+	 *  (1 signed octet each).
+	 */
+	DTM_VENDOR_OP_TX_POWER_CAL_SET = 0x0019,
+
+	/** Read the calibration offsets of the radio output power levels.
+	 *  No parameters.
+	 *  Response: offset of each level from the lowest (1 signed octet each).
+	 */
+	DTM_VENDOR_OP_TX_POWER_CAL_READ = 0x001A,
+
+	/** Set and store the output power flatness compensation of the channels.
+	 *  Parameters: compensation of each DTM channel from channel 0,
+	 *  in 0.25 dB units (1 signed octet each).
+	 */
+	DTM_VENDOR_OP_TX_POWER_COMP_SET = 0x001B,
+
+	/** Read the output power flatness compensation of the channels.
+	 *  No parameters.
+	 *  Response: compensation of each DTM channel (1 signed octet each).
+	 */
+	DTM_VENDOR_OP_TX_POWER_COMP_READ = 0x001C,
+
+	/** Read the command latency statistics of a DTM executor client.
+	 *  Parameters: client, see enum dtm_exec_client (1 octet).
+	 *  Response: struct dtm_exec_stat.
+	 */
+	DTM_VENDOR_OP_EXEC_STATS_READ = 0x001D,
+
+	/** Clear the DTM executor statistics. No parameters. */
+	DTM_VENDOR_OP_EXEC_STATS_RESET = 0x001E,
+
+	/** Start a packet error rate run against the peer DUT.
+	 *  Parameters: struct dtm_per_config.
+	 *  The end of the run is reported with DTM_VENDOR_EVT_PER_DONE.
+	 */
+	DTM_VENDOR_OP_PER_RUN = 0x0020,
+
+	/** Stop the packet error rate run. No parameters. */
+	DTM_VENDOR_OP_PER_STOP = 0x0021,
+
+	/** Read the results of the last packet error rate run.
+	 *  Parameters: index of the first result (2 octets).
+	 *  Response: array of struct dtm_per_result.
+	 */
+	DTM_VENDOR_OP_PER_READ = 0x0022,
+
+	/** Read the receiver RSSI statistics of a packet class.
+	 *  Parameters: class, see enum dtm_rssi_class (1 octet).
+	 *  Response: struct dtm_rssi_stat.
+	 */
+	DTM_VENDOR_OP_RSSI_STATS_READ = 0x0023,
+
+	/** Read the receiver RSSI histogram of a packet class.
+	 *  Parameters: class, see enum dtm_rssi_class (1 octet),
+	 *  index of the first bin (1 octet).
+	 *  Response: packet count of each bin (4 octets each), from the first bin.
+	 */
+	DTM_VENDOR_OP_RSSI_HIST_READ = 0x0024,
+
+	/** Read the carrier frequency offset statistics of the receiver test.
+	 *  No parameters.
+	 *  Response: struct dtm_cte_cfo_stats.
+	 */
+	DTM_VENDOR_OP_CTE_CFO_READ = 0x0025,
+
+	/** Read the angle of arrival statistics of the receiver test.
+	 *  No parameters.
+	 *  Response: struct dtm_aoa_stats.
+	 */
+	DTM_VENDOR_OP_AOA_READ = 0x0026,
+
+	/** Start or stop the packed IQ sample stream.
+	 *  Parameters: 1 to send the IQ samples with DTM_VENDOR_EVT_IQ_STREAM
+	 *  instead of the IQ reports of the transport, 0 to stop (1 octet).
+	 */
+	DTM_VENDOR_OP_IQ_STREAM = 0x0027,
+};
+
+/** @brief DTM vendor events.
+ *
+ * The events are reported asynchronously to the transport, see
+ * dtm_vendor_evt_cb_set(). All multi-octet parameters are little-endian.
+ */
+enum dtm_vendor_event {
+	/** Transmitter burst ended.
+	 *  Parameters: number of packets sent (4 octets).
+	 */
+	DTM_VENDOR_EVT_TX_BURST_DONE = 0x0001,
+
+	/** Packet error rate run ended.
+	 *  Parameters: number of results (2 octets).
+	 */
+	DTM_VENDOR_EVT_PER_DONE = 0x0002,
+
+	/** Angle of arrival of a packet received in the AoA receiver test,
+	 *  reported instead of its IQ samples with CONFIG_DTM_AOA_REPORT.
+	 *  Parameters: struct dtm_aoa_report.
+	 */
+	DTM_VENDOR_EVT_AOA = 0x0003,
+
+	/** Piece of the packed IQ samples of a received packet.
+	 *  Parameters: struct dtm_iq_stream_hdr followed by the packed samples.
+	 */
+	DTM_VENDOR_EVT_IQ_STREAM = 0x0004,
+};
+
+/** @brief Callback to report a DTM vendor event.
+ *
+ * @note The callback can be called from the interrupt context.
+ *
+ * @param[in] event Vendor event, see enum dtm_vendor_event.
+ * @param[in] data  Event parameters.
+ * @param[in] len   Length of the event parameters.
+ */
+typedef void (*dtm_vendor_evt_cb_t)(uint16_t event, const uint8_t *data, size_t len);
+
+/** @brief Execute a DTM vendor command.
+ *
+ * This is the binary command interface shared by all transports.
+ *
+ * @param[in]     opcode  Vendor command opcode.
+ * @param[in]     in      Command parameters.
+ * @param[in]     in_len  Length of the command parameters.
+ * @param[out]    out     Response buffer of DTM_VENDOR_RSP_MAX_SIZE octets.
+ * @param[in,out] out_len Length of the response.
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOTSUP if the opcode is unknown.
+ * @retval -EINVAL if the parameters are invalid.
+ * @return Other negative value in case of error.
+ */
+int dtm_vendor_cmd(uint16_t opcode, const uint8_t *in, size_t in_len,
+		   uint8_t *out, size_t *out_len);
+
+/** @brief Execute a DTM vendor command in the DTM executor.
+ *
+ * See dtm_vendor_cmd() and dtm_exec_call().
+ *
+ * @param[in]     client  Client submitting the command.
+ * @param[in]     opcode  Vendor command opcode.
+ * @param[in]     in      Command parameters.
+ * @param[in]     in_len  Length of the command parameters.
+ * @param[out]    out     Response buffer of DTM_VENDOR_RSP_MAX_SIZE octets.
+ * @param[in,out] out_len Length of the response.
+ *
+ * @return 0 in case of success or negative value in case of error.
+ */
+int dtm_vendor_cmd_exec(enum dtm_exec_client client, uint16_t opcode, const uint8_t *in,
+			size_t in_len, uint8_t *out, size_t *out_len);
+
+/** @brief Set the callback reporting the DTM vendor events.
+ *
+ * @param[in] cb Vendor event callback, NULL to discard the events.
+ */
+void dtm_vendor_evt_cb_set(dtm_vendor_evt_cb_t cb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_VENDOR_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include "dtm_welford.h"
+
+static uint64_t isqrt64(uint64_t val)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > val) {
+		bit >>= 2;
+	}
+
+	while (bit) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return res;
+}
+
+void dtm_welford_reset(struct dtm_welford *acc)
+{
+	memset(acc, 0, sizeof(*acc));
+}
+
+void dtm_welford_add(struct dtm_welford *acc, int32_t val)
+{
+	int64_t x = (int64_t)val * (1LL << DTM_WELFORD_FRAC_BITS);
+	int64_t delta;
+	int64_t half;
+
+	acc->count++;
+	delta = x - acc->mean;
+	half = acc->count / 2;
+
+	/* Round the correction, a truncated one drifts the average towards zero. */
+	acc->mean += ((delta < 0) ? (delta - half) : (delta + half)) / (int64_t)acc->count;
+
+	/* The differences from the old and the new average have the same sign. */
+	acc->m2 += (uint64_t)(delta * (x - acc->mean)) >> DTM_WELFORD_FRAC_BITS;
+}
+
+int32_t dtm_welford_mean_get(const struct dtm_welford *acc, int32_t scale)
+{
+	int64_t val;
+	int64_t half = 1LL << (DTM_WELFORD_FRAC_BITS - 1);
+
+	if (acc->count == 0) {
+		return 0;
+	}
+
+	val = acc->mean * scale;
+
+	/* Round half away from zero. */
+	return (int32_t)((val < 0) ? -((-val + half) >> DTM_WELFORD_FRAC_BITS) :
+				     ((val + half) >> DTM_WELFORD_FRAC_BITS));
+}
+
+uint32_t dtm_welford_std_get(const struct dtm_welford *acc, uint32_t scale)
+{
+	uint64_t var;
+	uint64_t std;
+
+	if (acc->count == 0) {
+		return 0;
+	}
+
+	var = acc->m2 / acc->count;
+	std = isqrt64(var * scale * scale);
+
+	/* The square root has half of the fractional bits of the variance. */
+	return (uint32_t)((std + (1ULL << (DTM_WELFORD_FRAC_BITS / 2 - 1))) >>
+			  (DTM_WELFORD_FRAC_BITS / 2));
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DTM_WELFORD_H_
+#define DTM_WELFORD_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Running average and standard deviation of the values measured in a
+ * test, updated in fixed point with the Welford algorithm in constant time
+ * per value. Unlike the sum of the squares, the accumulated differences
+ * from the running average keep their precision however far the average
+ * is from zero. The accumulator is not synchronized, the callers lock it.
+ */
+
+/** Fractional bits of the running average and of the sum of the squared
+ *  differences. The values of an accumulator must differ by less than
+ *  2^22, so that the product of two differences fits 64 bits.
+ */
+#define DTM_WELFORD_FRAC_BITS 8
+
+/** @brief Running statistics of a series of values. */
+struct dtm_welford {
+	/** Number of values. */
+	uint32_t count;
+
+	/** Average, DTM_WELFORD_FRAC_BITS fractional bits. */
+	int64_t mean;
+
+	/** Sum of the squared differences from the average,
+	 *  DTM_WELFORD_FRAC_BITS fractional bits.
+	 */
+	uint64_t m2;
+};
+
+/** @brief Clear the running statistics.
+ *
+ * @param[out] acc Running statistics.
+ */
+void dtm_welford_reset(struct dtm_welford *acc);
+
+/** @brief Add a value to the running statistics.
+ *
+ * @param[in,out] acc Running statistics.
+ * @param[in] val Value.
+ */
+void dtm_welford_add(struct dtm_welford *acc, int32_t val);
+
+/** @brief Get the average of the values.
+ *
+ * @param[in] acc Running statistics.
+ * @param[in] scale Multiplier of the result, for example 100 for the
+ *		    average in hundredths of the value unit.
+ *
+ * @return Average times the multiplier, rounded, 0 without a value.
+ */
+int32_t dtm_welford_mean_get(const struct dtm_welford *acc, int32_t scale);
+
+/** @brief Get the population standard deviation of the values.
+ *
+ * @param[in] acc Running statistics.
+ * @param[in] scale Multiplier of the result, for example 100 for the
+ *		    standard deviation in hundredths of the value unit.
+ *
+ * @return Standard deviation times the multiplier, rounded, 0 without
+ *	   a value.
+ */
+uint32_t dtm_welford_std_get(const struct dtm_welford *acc, uint32_t scale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DTM_WELFORD_H_ */
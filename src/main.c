@@ -7,77 +7,143 @@
 #include <zephyr/device.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/kernel.h>
-#include <SEGGER_RTT.h>
 
 #include "transport/dtm_transport.h"
-#include "emc_config.h"
+#include "dtm_config.h"
+#include "dtm_exec.h"
 
-/* External function from dtm_cmd_core */
-extern uint16_t dtm_cmd_put(uint16_t cmd);
+#if CONFIG_DTM_TEST_PLAN
+#include "dtm_test_plan.h"
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+/* Period of the status report in diagnostics mode, in seconds. */
+#define STATUS_PERIOD_S 5
+
+static const char *const autostart_names[] = {
+	[DTM_AUTOSTART_NONE] = "None",
+	[DTM_AUTOSTART_RX] = "RX",
+	[DTM_AUTOSTART_TX] = "TX",
+	[DTM_AUTOSTART_CARRIER] = "Carrier",
+};
+
+/* Start the stored test plan, if any. */
+static bool test_plan_start(void)
+{
+#if CONFIG_DTM_TEST_PLAN
+	if (dtm_test_plan_init()) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_DTM_TEST_PLAN_AUTORUN) && !dtm_test_plan_run()) {
+		DTM_DIAG("Running the stored test plan, %d steps\n",
+			 dtm_test_plan_count_get(NULL));
+		return true;
+	}
+#endif /* CONFIG_DTM_TEST_PLAN */
+
+	return false;
+}
+
+static int autostart_handler(void *ctx)
+{
+	return dtm_config_autostart_run(ctx);
+}
+
+static int transport_handler(void *ctx)
+{
+	return dtm_tr_process(*(union dtm_tr_packet *)ctx);
+}
+
+#if !CONFIG_DTM_TRANSPORT_RTT
+/* Serve the DTM commands of the UART and HCI transports. The commands are
+ * received here and executed by the DTM executor.
+ */
+static void transport_thread(void *p1, void *p2, void *p3)
+{
+	union dtm_tr_packet cmd;
+	int err;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		cmd = dtm_tr_get();
+		err = dtm_exec_call(DTM_EXEC_CLIENT_TESTER, transport_handler, &cmd);
+		if (err) {
+			DTM_DIAG("Error processing command: %d\n", err);
+		}
+	}
+}
+
+/* Started once the transport is initialized. */
+K_THREAD_DEFINE(dtm_transport_thread, CONFIG_DTM_TRANSPORT_THREAD_STACK_SIZE,
+		transport_thread, NULL, NULL, NULL, CONFIG_DTM_TRANSPORT_THREAD_PRIORITY,
+		0, SYS_FOREVER_MS);
+#endif /* !CONFIG_DTM_TRANSPORT_RTT */
 
 int main(void)
 {
+	struct dtm_autostart autostart;
+	uint32_t elapsed = 0;
 	int err;
-	uint16_t response;
+
+	/* Missing persistent configuration is not fatal, the Kconfig
+	 * defaults are used instead.
+	 */
+	(void)dtm_config_init();
 
 	err = dtm_tr_init();
 	if (err) {
-#if !EMC_TEST_MODE
-		printk("Error initializing DTM transport: %d\n", err);
-#endif
+		DTM_DIAG("Error initializing DTM transport: %d\n", err);
 		return err;
 	}
 
-#if !EMC_TEST_MODE
-	printk("Starting Direct Test Mode with Shell Interface\n");
-	printk("DTM Ready - Shell commands available\n");
-	printk("Type 'dtm' to see available commands\n");
-#endif
-
-#if AUTO_START_RX_MODE
-	/* Wait for system to stabilize */
-	k_sleep(K_MSEC(100));
-	
-	/* Reset DTM first */
-	response = dtm_cmd_put(0x0000);
-#if !EMC_TEST_MODE
-	printk("DTM Reset - Response: 0x%04X\n", response);
-#endif
-	
-	k_sleep(K_MSEC(50));
-	
-	/* Start RX on configured channel
-	 * RX command: bits 15-14 = 0x1 (RECEIVER_TEST)
-	 * Channel is specified in bits 7-2
-	 */
-	uint16_t rx_cmd = 0x4000 | (AUTO_START_CHANNEL << 2);
-	response = dtm_cmd_put(rx_cmd);
-	
-#if !EMC_TEST_MODE
-	printk("Auto-starting RX on channel %d (%d MHz)\n", 
-	       AUTO_START_CHANNEL, 2404 + AUTO_START_CHANNEL * 2);
-	printk("RX started - Response: 0x%04X\n", response);
-	if ((response & 0x8000) != 0x8000) {
-		printk("Warning: Unexpected response from RX command\n");
+	DTM_DIAG("Starting Direct Test Mode with Shell Interface\n");
+	DTM_DIAG("DTM Ready - Shell commands available\n");
+	DTM_DIAG("Type 'dtm' to see available commands\n");
+
+	dtm_config_autostart_get(&autostart);
+	if (test_plan_start()) {
+		autostart.mode = DTM_AUTOSTART_NONE;
+	} else if (autostart.mode != DTM_AUTOSTART_NONE) {
+		/* Wait for system to stabilize */
+		k_sleep(K_MSEC(100));
+
+		err = dtm_exec_call(DTM_EXEC_CLIENT_MAIN, autostart_handler, &autostart);
+		DTM_DIAG("Auto-starting %s test on channel %d (%d MHz): %d\n",
+			 autostart_names[autostart.mode], autostart.channel,
+			 2402 + autostart.channel * 2, err);
 	}
-#endif
-#endif
 
-	/* Main loop - minimal activity during EMC testing */
+#if !CONFIG_DTM_TRANSPORT_RTT
+	/* The RTT transport is driven by the shell, the other transports
+	 * are served by their own thread, so the status report below keeps
+	 * running.
+	 */
+	k_thread_start(dtm_transport_thread);
+#endif /* !CONFIG_DTM_TRANSPORT_RTT */
+
 	for (;;) {
-#if EMC_TEST_MODE
-		/* EMC Test Mode: Minimal CPU activity for clean measurements */
-		k_sleep(K_SECONDS(60));  /* Sleep for 1 minute intervals */
-#else
-		/* Debug Mode: Periodic status updates */
-		k_sleep(K_SECONDS(5));
-#if AUTO_START_RX_MODE
-		static uint32_t counter = 0;
-		counter += 5;
-		printk("\n[STATUS] RX Test Running - %u seconds elapsed\n", counter);
-		printk("         Channel %d (%d MHz) - Waiting for packets...\n", 
-		       AUTO_START_CHANNEL, 2404 + AUTO_START_CHANNEL * 2);
-#endif
-#endif
+		/* Quiet mode: no console activity, the thread sleeps until
+		 * the diagnostics mode is requested.
+		 */
+		if (dtm_config_quiet_get()) {
+			(void)dtm_config_quiet_wait(K_FOREVER);
+			continue;
+		}
+
+		/* Diagnostics mode: periodic status updates */
+		if (!dtm_config_quiet_wait(K_SECONDS(STATUS_PERIOD_S))) {
+			continue;
+		}
+
+		elapsed += STATUS_PERIOD_S;
+		if (autostart.mode != DTM_AUTOSTART_NONE) {
+			printk("\n[STATUS] %s Test Running - %u seconds elapsed\n",
+			       autostart_names[autostart.mode], elapsed);
+			printk("         Channel %d (%d MHz)\n",
+			       autostart.channel, 2402 + autostart.channel * 2);
+		}
 	}
 }
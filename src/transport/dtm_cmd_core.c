@@ -29,8 +29,8 @@ LOG_MODULE_REGISTER(dtm_cmd_core, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
 #define LE_TEST_STATUS_EVENT_SUCCESS 0x0001
 #define LE_PACKET_REPORTING_EVENT    0x8000
 
-/* Upper bits of packet length (shared) */
-uint8_t upper_len;
+/* Upper bits of packet length, owned by the executor */
+static uint8_t upper_len;
 
 /* DTM command codes */
 enum dtm_cmd_code {
@@ -151,8 +151,8 @@ static int read_max(uint8_t parameter, uint16_t *ret)
     return err;
 }
 
-/* ---------------- Public API ---------------- */
-uint16_t dtm_cmd_put(uint16_t cmd)
+/* ---------------- Command execution ---------------- */
+static uint16_t cmd_execute(uint16_t cmd)
 {
     enum dtm_cmd_code cmd_code = (cmd >> 14) & 0x03;
     uint8_t chan = (cmd >> 8) & 0x3F;
@@ -176,11 +176,33 @@ uint16_t dtm_cmd_put(uint16_t cmd)
     }
 }
 
+static int cmd_exec_handler(void *ctx)
+{
+    uint16_t *cmd = ctx;
+
+    /* The command is replaced with the response. */
+    *cmd = cmd_execute(*cmd);
+    return 0;
+}
+
+/* ---------------- Public API ---------------- */
+uint16_t dtm_cmd_put(enum dtm_exec_client client, uint16_t cmd)
+{
+    uint16_t data = cmd;
+
+    if (dtm_exec_call(client, cmd_exec_handler, &data)) {
+        return LE_TEST_STATUS_EVENT_ERROR;
+    }
+
+    return data;
+}
+
 /* ---------------- Internal helpers ---------------- */
 static int reset_dtm(uint8_t parameter)
 {
     ARG_UNUSED(parameter);
     upper_len = 0;
+    dtm_exec_tester_reset();
     return dtm_setup_reset();
 }
 
@@ -195,6 +217,8 @@ static uint16_t on_test_setup_cmd(enum dtm_ctrl_code control, uint8_t parameter)
     uint16_t ret = 0;
     int err = 0;
 
+    dtm_setup_prepare();
+
     switch (control) {
     case LE_TEST_SETUP_RESET:
         err = reset_dtm(parameter);
@@ -232,7 +256,7 @@ static uint16_t on_test_end_cmd(enum dtm_ctrl_code control, uint8_t parameter)
 
 static uint16_t on_test_rx_cmd(uint8_t chan)
 {
-    printk("[DEBUG] DTM RX command: channel %d\n", chan);
+    LOG_INF("DTM RX command: channel %d", chan);
     return dtm_test_receive(chan) ? LE_TEST_STATUS_EVENT_ERROR : LE_TEST_STATUS_EVENT_SUCCESS;
 }
 
@@ -3,19 +3,19 @@
 
 #include <stdint.h>
 
+#include "dtm_exec.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define DTM_CMD_CORE_PRESENT
 
-/* Upper bits of packet length – shared state between transports */
-extern uint8_t upper_len;
-
-/* Decode a 16-bit DTM command and execute it via nrfx_dtm library.
+/* Decode a 16-bit DTM command and execute it via nrfx_dtm library, in the
+ * DTM executor on behalf of the given client.
  * Returns the 16-bit response that shall be sent back to the tester.
  */
-uint16_t dtm_cmd_put(uint16_t cmd);
+uint16_t dtm_cmd_put(enum dtm_exec_client client, uint16_t cmd);
 
 #ifdef __cplusplus
 }
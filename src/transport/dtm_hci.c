@@ -16,6 +16,8 @@
 
 #include "hci_uart.h"
 #include "dtm_transport.h"
+#include "dtm_exec.h"
+#include "dtm_vendor.h"
 
 LOG_MODULE_REGISTER(dtm_hci_tr, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
 
@@ -290,6 +292,48 @@ static int read_local_feat_cc_evt(uint8_t status, uint8_t *features)
 	return hci_uart_write(H4_TYPE_EVT, (uint8_t *)&hdr, sizeof(hdr), (uint8_t *)&tmp, hdr.len);
 }
 
+static int vendor_cc_evt(uint16_t opcode, uint8_t status, const uint8_t *data, size_t len)
+{
+	uint8_t buf[sizeof(struct hci_base_cc_evt) + DTM_VENDOR_RSP_MAX_SIZE];
+	struct hci_base_cc_evt *tmp = (struct hci_base_cc_evt *)buf;
+	struct bt_hci_evt_hdr hdr;
+
+	hdr.evt = BT_HCI_EVT_CMD_COMPLETE;
+	hdr.len = sizeof(*tmp) + len;
+
+	tmp->evt.ncmd = 1;
+	sys_put_le16(opcode, (uint8_t *)&tmp->evt.opcode);
+
+	tmp->ret.status = status;
+	memcpy(buf + sizeof(*tmp), data, len);
+
+	LOG_INF("Responding to vendor opcode %x, with status %d", opcode, status);
+	return hci_uart_write(H4_TYPE_EVT, (uint8_t *)&hdr, sizeof(hdr), buf, hdr.len);
+}
+
+static void vendor_evt(uint16_t event, const uint8_t *data, size_t len)
+{
+	uint8_t buf[sizeof(uint16_t) + DTM_VENDOR_RSP_MAX_SIZE];
+	struct bt_hci_evt_hdr hdr;
+	int err;
+
+	if (len > DTM_VENDOR_RSP_MAX_SIZE) {
+		LOG_ERR("Invalid vendor event length.");
+		return;
+	}
+
+	hdr.evt = BT_HCI_EVT_VENDOR;
+	hdr.len = sizeof(uint16_t) + len;
+
+	sys_put_le16(event, buf);
+	memcpy(buf + sizeof(uint16_t), data, len);
+
+	err = hci_uart_write(H4_TYPE_EVT, (uint8_t *)&hdr, sizeof(hdr), buf, hdr.len);
+	if (err) {
+		LOG_ERR("Error writing vendor event %x.", event);
+	}
+}
+
 static void iq_report_evt(struct dtm_iq_data *iq_data)
 {
 	uint8_t buf[CONNECTIONLESS_IQ_REPORT_MAX_SIZE];
@@ -396,6 +440,8 @@ static int hci_reset(void)
 {
 	int err;
 
+	dtm_exec_tester_reset();
+
 	err = dtm_setup_reset();
 	if (err) {
 		base_cc_evt(BT_HCI_OP_RESET, BT_HCI_ERR_HW_FAILURE);
@@ -665,6 +711,44 @@ static int hci_test_end(void)
 	return test_end_cc_evt(BT_HCI_ERR_SUCCESS, cnt);
 }
 
+static int hci_vendor_cmd(uint16_t opcode, const uint8_t *data, uint8_t len)
+{
+	uint8_t rsp[DTM_VENDOR_RSP_MAX_SIZE];
+	size_t rsp_len;
+	uint8_t status;
+	int err;
+
+	err = dtm_vendor_cmd(BT_OCF(opcode), data, len, rsp, &rsp_len);
+	switch (err) {
+	case 0:
+		status = BT_HCI_ERR_SUCCESS;
+		break;
+
+	case -ENOTSUP:
+		status = BT_HCI_ERR_UNKNOWN_CMD;
+		break;
+
+	case -EINVAL:
+	case -ENOENT:
+		status = BT_HCI_ERR_INVALID_PARAM;
+		break;
+
+	case -EBUSY:
+		status = BT_HCI_ERR_CMD_DISALLOWED;
+		break;
+
+	default:
+		status = BT_HCI_ERR_HW_FAILURE;
+		break;
+	}
+
+	if (err) {
+		rsp_len = 0;
+	}
+
+	return vendor_cc_evt(opcode, status, rsp, rsp_len);
+}
+
 static int hci_cmd(const struct bt_hci_cmd_hdr *hdr, const uint8_t *data)
 {
 	uint16_t cmd;
@@ -704,6 +788,11 @@ static int hci_cmd(const struct bt_hci_cmd_hdr *hdr, const uint8_t *data)
 		return hci_test_end();
 
 	default:
+		if (BT_OGF(cmd) == BT_OGF_VS) {
+			LOG_INF("Executing vendor command 0x%03x.", BT_OCF(cmd));
+			return hci_vendor_cmd(cmd, data, hdr->param_len);
+		}
+
 		LOG_ERR("Unknown HCI command opcode: 0x%04x", cmd);
 		base_cc_evt(cmd, BT_HCI_ERR_UNKNOWN_CMD);
 		return -ENOTSUP;
@@ -731,6 +820,8 @@ int dtm_tr_init(void)
 		return err;
 	}
 
+	dtm_vendor_evt_cb_set(vendor_evt);
+
 	return 0;
 }
 
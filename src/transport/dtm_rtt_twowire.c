@@ -15,6 +15,10 @@
 #include "dtm_transport.h"
 #include "dtm_cmd_core.h"
 
+#if CONFIG_DTM_RTT_FRAME
+#include "dtm_rtt_frame.h"
+#endif /* CONFIG_DTM_RTT_FRAME */
+
 LOG_MODULE_REGISTER(dtm_rtt_tr, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
 
 /* Mask/enum definitions copied from original UART implementation ------------------ */
@@ -53,34 +57,37 @@ LOG_MODULE_REGISTER(dtm_rtt_tr, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
 /* The DTM maximum wait time in milliseconds for the RTT command second byte. */
 #define DTM_RTT_SECOND_BYTE_MAX_DELAY 5
 
-/* ---- Declarations reused from original implementation ------------------------- */
-/* Many enums / helpers are needed from the original file.  Instead of duplicating
- * everything, include the header of the original implementation.  Because those
- * definitions are all in dtm_uart_twowire.c (not a header) we have to replicate
- * only the small subset used in the code below (upper_len & dtm_cmd_put).  To
- * avoid excessive duplication, just declare dtm_cmd_put here as an extern coming
- * from the original module, then call it.  This keeps the command decoding logic
- * in one place.
+/* RTT has no receive interrupt. Poll period in milliseconds while waiting
+ * for a command; the CPU sleeps in between.
  */
-extern uint16_t dtm_cmd_put(uint16_t cmd);
-
-/* Store upper bits (replicated symbol from original) */
-extern uint8_t upper_len;
-/* ------------------------------------------------------------------------------ */
+#define DTM_RTT_POLL_PERIOD 10
 
 int dtm_tr_init(void)
 {
 	int err;
 	
 	/* Note: Shell is using RTT channel 0, so we coexist with it */
-	/* The shell commands in dtm_shell_commands.c will call dtm_cmd_put directly */
+	/* The shell commands in dtm_shell_commands.c share the DTM executor */
 	
+#if CONFIG_DTM_RTT_FRAME
+	/* The IQ samples are only reported over the framed protocol. */
+	err = dtm_init(dtm_rtt_frame_iq_report);
+#else
 	err = dtm_init(NULL);
+#endif /* CONFIG_DTM_RTT_FRAME */
 	if (err) {
 		LOG_ERR("Error during DTM initialization: %d", err);
 		return err;
 	}
 
+#if CONFIG_DTM_RTT_FRAME
+	err = dtm_rtt_frame_init();
+	if (err) {
+		LOG_ERR("Error starting the framed protocol: %d", err);
+		return err;
+	}
+#endif /* CONFIG_DTM_RTT_FRAME */
+
 	LOG_INF("DTM RTT transport initialised");
 	LOG_INF("Use shell commands: dtm reset, dtm rx_test <ch>, dtm tx_carrier <ch>, dtm end");
 	return 0;
@@ -112,8 +119,8 @@ union dtm_tr_packet dtm_tr_get(void)
 				dtm_cmd = buffer[0] << 8;
 				msb_time = k_uptime_get();
 			} else {
-				/* No data, yield CPU but don't sleep */
-				k_yield();
+				/* No data, sleep until the next poll */
+				k_sleep(K_MSEC(DTM_RTT_POLL_PERIOD));
 				continue;
 			}
 		} else {
@@ -124,8 +131,8 @@ union dtm_tr_packet dtm_tr_get(void)
 					/* Timeout - reset and wait for new command */
 					is_msb_read = false;
 				} else {
-					/* Still waiting, just yield */
-					k_yield();
+					/* Still waiting for the second byte */
+					k_sleep(K_MSEC(1));
 				}
 				continue;
 			}
@@ -146,7 +153,7 @@ int dtm_tr_process(union dtm_tr_packet cmd)
 
 	LOG_INF("Processing 0x%04x command", request);
 
-	response = dtm_cmd_put(request);
+	response = dtm_cmd_put(DTM_EXEC_CLIENT_TESTER, request);
 	LOG_INF("Sending 0x%04x response", response);
 
 	uint8_t buf[2] = { (uint8_t)((response >> 8) & 0xFF), (uint8_t)(response & 0xFF) };
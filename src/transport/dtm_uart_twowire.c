@@ -802,11 +802,7 @@ int dtm_tr_process(union dtm_tr_packet cmd)
 
 	LOG_INF("Processing 0x%04x command", tmp);
 
-#ifdef CONFIG_DTM_TRANSPORT_TWOWIRE
-	ret = dtm_cmd_put(tmp);
-#else
-	ret = dtm_cmd_put(tmp);
-#endif
+	ret = dtm_cmd_put(DTM_EXEC_CLIENT_TESTER, tmp);
 	LOG_INF("Sending 0x%04x response", ret);
 
 	uart_poll_out(dtm_uart, (ret >> 8) & 0xFF);